@@ -0,0 +1,84 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Benchmark of pure-Python gym envs, envpool ``python:`` against gym.
+
+Both run the same ``gym.make(--env-id)`` envs in ``--num-threads`` worker
+processes; gym's ``AsyncVectorEnv`` uses one process per env. The envpool
+side also runs in async mode with ``--batch-size``:
+::
+
+  python3 test_subproc.py --env-id CartPole-v1 --num-envs 64
+  python3 test_subproc.py --env-id CartPole-v1 --num-envs 256 --batch-size 64
+"""
+
+import argparse
+import time
+from typing import Any
+
+import gym
+import numpy as np
+
+import envpool
+
+
+def run_gym(args: argparse.Namespace) -> float:
+  env = gym.vector.AsyncVectorEnv(
+    [lambda: gym.make(args.env_id) for _ in range(args.num_envs)]
+  )
+  env.reset()
+  action = env.action_space.sample()
+  t = time.time()
+  for _ in range(args.total_step):
+    env.step(action)
+  duration = time.time() - t
+  env.close()
+  return args.total_step * args.num_envs / duration
+
+
+def run_envpool(args: argparse.Namespace, batch_size: int) -> float:
+  env: Any = envpool.make_gym(
+    "python:" + args.env_id,
+    num_envs=args.num_envs,
+    batch_size=batch_size,
+    num_threads=args.num_threads,
+    seed=args.seed,
+  )
+  env.async_reset()
+  env.action_space.seed(args.seed)
+  action = np.array([env.action_space.sample() for _ in range(batch_size)])
+  t = time.time()
+  for _ in range(args.total_step):
+    info = env.recv()[-1]
+    env.send(action, info["env_id"])
+  duration = time.time() - t
+  env.close()
+  return args.total_step * batch_size / duration
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser()
+  parser.add_argument("--env-id", type=str, default="CartPole-v1")
+  parser.add_argument("--num-envs", type=int, default=64)
+  parser.add_argument("--batch-size", type=int, default=16)
+  parser.add_argument("--num-threads", type=int, default=0)
+  parser.add_argument("--total-step", type=int, default=1000)
+  parser.add_argument("--seed", type=int, default=0)
+  args = parser.parse_args()
+  print(args)
+  fps = run_gym(args)
+  print(f"gym AsyncVectorEnv FPS = {fps:.2f}")
+  fps = run_envpool(args, args.num_envs)
+  print(f"EnvPool python: sync FPS = {fps:.2f}")
+  fps = run_envpool(args, args.batch_size)
+  print(f"EnvPool python: async FPS = {fps:.2f}")
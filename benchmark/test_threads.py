@@ -0,0 +1,96 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Benchmark of several Python threads, each driving its own envpool.
+
+This is the layout of a learner sharded across threads. The worker threads
+never take the GIL, so the threads only serialize in the Python layer of
+``send`` and ``recv``; the total FPS grows with ``--num-pools`` as long as
+the envs are the bottleneck:
+::
+
+  python3 test_threads.py --env atari --num-pools 1
+  python3 test_threads.py --env atari --num-pools 4
+"""
+
+import argparse
+import threading
+import time
+from typing import Any, List
+
+import numpy as np
+
+import envpool
+
+
+def drive(env: Any, action: np.ndarray, steps: int) -> None:
+  for _ in range(steps):
+    info = env.recv()[-1]
+    env.send(action, info["env_id"])
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser()
+  parser.add_argument(
+    "--env",
+    type=str,
+    default="atari",
+    choices=["atari", "mujoco", "vizdoom", "box2d"],
+  )
+  parser.add_argument("--num-pools", type=int, default=4)
+  # per pool
+  parser.add_argument("--num-envs", type=int, default=16)
+  parser.add_argument("--batch-size", type=int, default=8)
+  parser.add_argument("--num-threads", type=int, default=4)
+  parser.add_argument("--total-step", type=int, default=10000)
+  parser.add_argument("--seed", type=int, default=0)
+  args = parser.parse_args()
+  print(args)
+  task_id = {
+    "atari": "Pong-v5",
+    "mujoco": "Ant-v3",
+    "vizdoom": "HealthGathering-v1",
+    "box2d": "LunarLander-v2",
+  }[args.env]
+  envs = [
+    envpool.make_gym(
+      task_id,
+      num_envs=args.num_envs,
+      batch_size=args.batch_size,
+      num_threads=args.num_threads,
+      thread_affinity_offset=-1,
+      seed=args.seed + i * args.num_envs,
+    ) for i in range(args.num_pools)
+  ]
+  actions: List[np.ndarray] = []
+  for env in envs:
+    env.async_reset()
+    env.action_space.seed(args.seed)
+    actions.append(
+      np.array([env.action_space.sample() for _ in range(args.batch_size)])
+    )
+  threads = [
+    threading.Thread(target=drive, args=(env, action, args.total_step))
+    for env, action in zip(envs, actions)
+  ]
+  t = time.time()
+  for thread in threads:
+    thread.start()
+  for thread in threads:
+    thread.join()
+  duration = time.time() - t
+  frame_skip = getattr(envs[0].spec.config, "frame_skip", 1)
+  fps = args.num_pools * args.total_step * args.batch_size / duration
+  fps *= frame_skip
+  print(f"Duration = {duration:.2f}s")
+  print(f"EnvPool FPS = {fps:.2f} ({fps / args.num_pools:.2f} per pool)")
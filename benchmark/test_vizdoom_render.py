@@ -0,0 +1,77 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""ViZDoom rendering benchmark over the bundled scenarios.
+
+Compare the FPS of the .cfg resolution with ``auto_resolution`` and
+``gray_scale``:
+::
+
+  python3 test_vizdoom_render.py --num-envs 16 --total-step 2000
+"""
+
+import argparse
+import time
+from typing import Any
+
+import numpy as np
+
+import envpool
+import envpool.vizdoom.registration  # noqa: F401
+from envpool.vizdoom.registration import _vizdoom_game_list
+
+
+def run(task_id: str, args: argparse.Namespace, **kwargs: Any) -> float:
+  env = envpool.make_gym(
+    task_id,
+    num_envs=args.num_envs,
+    img_width=args.img_width,
+    img_height=args.img_height,
+    use_combined_action=True,
+    **kwargs,
+  )
+  env.async_reset()
+  env.action_space.seed(args.seed)
+  action = np.array([env.action_space.sample() for _ in range(args.num_envs)])
+  t = time.time()
+  for _ in range(args.total_step):
+    info = env.recv()[-1]
+    env.send(action, info["env_id"])
+  duration = time.time() - t
+  return args.total_step * args.num_envs / duration * 4
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser()
+  parser.add_argument("--num-envs", type=int, default=16)
+  parser.add_argument("--total-step", type=int, default=2000)
+  parser.add_argument("--img-width", type=int, default=84)
+  parser.add_argument("--img-height", type=int, default=84)
+  parser.add_argument("--seed", type=int, default=0)
+  args = parser.parse_args()
+  print(args)
+  modes = {
+    "cfg": {},
+    "auto": {
+      "auto_resolution": True
+    },
+    "auto+gray": {
+      "auto_resolution": True,
+      "gray_scale": True
+    },
+  }
+  print(f"{'task':<32}" + "".join(f"{m:>12}" for m in modes))
+  for game in _vizdoom_game_list():
+    task_id = "".join([g.capitalize() for g in game.split("_")]) + "-v1"
+    fps = [run(task_id, args, **kwargs) for kwargs in modes.values()]
+    print(f"{task_id:<32}" + "".join(f"{f:>12.0f}" for f in fps))
@@ -75,6 +75,13 @@ class _SpecTest(absltest.TestCase):
     )
     self.assertRaises(ValueError, AtariEnvSpec, config)
 
+  def test_frame_stack_with_stack_num(self) -> None:
+    config = AtariEnvSpec.gen_config(task="pong", frame_stack=4)
+    self.assertRaises(ValueError, AtariEnvSpec, config)
+    config = AtariEnvSpec.gen_config(task="pong", frame_stack=4, stack_num=1)
+    spec = AtariEnvSpec(config)
+    self.assertEqual(spec.observation_space.shape, (4, 1, 84, 84))
+
   def test_metadata(self) -> None:
     num_envs = 4
     env = make_gym("Pong-v5", num_envs=num_envs)
@@ -144,6 +144,31 @@ class AtariEnv : public Env<AtariEnvSpec> {
     }
   }
 
+  /**
+   * ALE only applies random_seed when loading the rom, and the reloaded game
+   * needs a full reset.
+   */
+  void Seed(int seed) override {
+    env_->setInt("random_seed", seed);
+    env_->loadROM(rom_path_);
+    elapsed_step_ = max_episode_steps_ + 1;
+  }
+
+  /**
+   * Continue the episode of another env of the same game, see
+   * `AsyncEnvPool::Branch`. The system state also carries the RNG of sticky
+   * actions.
+   */
+  void CopyStateFrom(const AtariEnv& other) {
+    env_->restoreSystemState(other.env_->cloneSystemState());
+    elapsed_step_ = other.elapsed_step_;
+    done_ = other.done_;
+    lives_ = other.lives_;
+    for (int i = 0; i < stack_num_; ++i) {
+      stack_buf_[i].Assign(other.stack_buf_[i]);
+    }
+  }
+
   void Reset() override {
     int noop = dist_noop_(gen_) + 1 - static_cast<int>(fire_reset_);
     bool push_all = false;
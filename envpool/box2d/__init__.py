@@ -20,6 +20,8 @@ from .box2d_envpool import (
   _BipedalWalkerEnvSpec,
   _CarRacingEnvPool,
   _CarRacingEnvSpec,
+  _CarRacingStateEnvPool,
+  _CarRacingStateEnvSpec,
   _LunarLanderContinuousEnvPool,
   _LunarLanderContinuousEnvSpec,
   _LunarLanderDiscreteEnvPool,
@@ -30,6 +32,12 @@ CarRacingEnvSpec, CarRacingDMEnvPool, CarRacingGymEnvPool = py_env(
   _CarRacingEnvSpec, _CarRacingEnvPool
 )
 
+(
+  CarRacingStateEnvSpec,
+  CarRacingStateDMEnvPool,
+  CarRacingStateGymEnvPool,
+) = py_env(_CarRacingStateEnvSpec, _CarRacingStateEnvPool)
+
 BipedalWalkerEnvSpec, BipedalWalkerDMEnvPool, BipedalWalkerGymEnvPool = py_env(
   _BipedalWalkerEnvSpec, _BipedalWalkerEnvPool
 )
@@ -50,6 +58,9 @@ __all__ = [
   "CarRacingEnvSpec",
   "CarRacingDMEnvPool",
   "CarRacingGymEnvPool",
+  "CarRacingStateEnvSpec",
+  "CarRacingStateDMEnvPool",
+  "CarRacingStateGymEnvPool",
   "BipedalWalkerEnvSpec",
   "BipedalWalkerDMEnvPool",
   "BipedalWalkerGymEnvPool",
@@ -45,6 +45,30 @@ class _Box2dEnvPoolDeterministicTest(absltest.TestCase):
   def test_car_racing(self) -> None:
     self.run_deterministic_check("CarRacing-v2")
     self.run_deterministic_check("CarRacing-v2", max_episode_steps=3)
+    self.run_deterministic_check("CarRacing-v2", obs_type="state")
+
+  def test_car_racing_state(self) -> None:
+    num_envs = 4
+    env0 = make_gym("CarRacing-v2", num_envs=num_envs, seed=0)
+    env1 = make_gym(
+      "CarRacing-v2",
+      num_envs=num_envs,
+      seed=0,
+      obs_type="state",
+      num_waypoints=5,
+    )
+    self.assertEqual(env1.observation_space.shape, (25,))
+    obs, _ = env1.reset()
+    self.assertEqual(obs.shape, (num_envs, 25))
+    self.assertEqual(obs.dtype, np.float32)
+    env0.reset()
+    # the physics does not depend on the observation type
+    for _ in range(300):
+      action = np.array([env0.action_space.sample() for _ in range(num_envs)])
+      rew0 = env0.step(action)[1]
+      obs, rew1 = env1.step(action)[:2]
+      np.testing.assert_allclose(rew0, rew1)
+      self.assertTrue(np.all(np.isfinite(obs)))
 
   def test_bipedal_walker(self) -> None:
     self.run_deterministic_check("BipedalWalker-v3")
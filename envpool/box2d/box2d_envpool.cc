@@ -20,6 +20,8 @@
 
 using CarRacingEnvSpec = PyEnvSpec<box2d::CarRacingEnvSpec>;
 using CarRacingEnvPool = PyEnvPool<box2d::CarRacingEnvPool>;
+using CarRacingStateEnvSpec = PyEnvSpec<box2d::CarRacingStateEnvSpec>;
+using CarRacingStateEnvPool = PyEnvPool<box2d::CarRacingStateEnvPool>;
 
 using BipedalWalkerEnvSpec = PyEnvSpec<box2d::BipedalWalkerEnvSpec>;
 using BipedalWalkerEnvPool = PyEnvPool<box2d::BipedalWalkerEnvPool>;
@@ -34,6 +36,7 @@ using LunarLanderDiscreteEnvPool = PyEnvPool<box2d::LunarLanderDiscreteEnvPool>;
 
 PYBIND11_MODULE(box2d_envpool, m) {
   REGISTER(m, CarRacingEnvSpec, CarRacingEnvPool)
+  REGISTER(m, CarRacingStateEnvSpec, CarRacingStateEnvPool)
   REGISTER(m, BipedalWalkerEnvSpec, BipedalWalkerEnvPool)
   REGISTER(m, LunarLanderContinuousEnvSpec, LunarLanderContinuousEnvPool)
   REGISTER(m, LunarLanderDiscreteEnvSpec, LunarLanderDiscreteEnvPool)
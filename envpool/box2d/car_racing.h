@@ -18,6 +18,8 @@
 #ifndef ENVPOOL_BOX2D_CAR_RACING_H_
 #define ENVPOOL_BOX2D_CAR_RACING_H_
 
+#include <type_traits>
+
 #include "car_racing_env.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
@@ -49,34 +51,80 @@ class CarRacingEnvFns {
   }
 };
 
+/**
+ * obs_type="state" variant of CarRacing: "obs" is a float vector of the car
+ * pose and velocity, the wheel angles and speeds, and the next num_waypoints
+ * track points relative to the car, see CarRacingBox2dEnv::CreateStateArray.
+ * Nothing is rendered.
+ */
+class CarRacingStateEnvFns {
+ public:
+  static decltype(auto) DefaultConfig() {
+    return MakeDict("reward_threshold"_.Bind(900.0),
+                    "lap_complete_percent"_.Bind(0.95f),
+                    "num_waypoints"_.Bind(10));
+  }
+  template <typename Config>
+  static decltype(auto) StateSpec(const Config& conf) {
+    int obs_size = kCarRacingStateSize + 2 * conf["num_waypoints"_];
+#ifdef ENVPOOL_TEST
+    return MakeDict("obs"_.Bind(Spec<float>({obs_size})),
+                    "info:tile_visited_count"_.Bind(Spec<int>({-1})),
+                    "info:car_fuel_spent"_.Bind(Spec<float>({-1})),
+                    "info:car_gas"_.Bind(Spec<float>({-1, 2})),
+                    "info:car_steer"_.Bind(Spec<float>({-1, 2})),
+                    "info:car_brake"_.Bind(Spec<float>({-1, 4})));
+#else
+    return MakeDict("obs"_.Bind(Spec<float>({obs_size})));
+#endif
+  }
+  template <typename Config>
+  static decltype(auto) ActionSpec(const Config& conf) {
+    return CarRacingEnvFns::ActionSpec(conf);
+  }
+};
+
 using CarRacingEnvSpec = EnvSpec<CarRacingEnvFns>;
+using CarRacingStateEnvSpec = EnvSpec<CarRacingStateEnvFns>;
+
+template <typename EnvSpec>
+class CarRacingEnvBase : public Env<EnvSpec>, public CarRacingBox2dEnv {
+  static constexpr bool kStateObs =
+      std::is_same_v<EnvSpec, CarRacingStateEnvSpec>;
 
-class CarRacingEnv : public Env<CarRacingEnvSpec>, public CarRacingBox2dEnv {
  public:
-  CarRacingEnv(const Spec& spec, int env_id)
-      : Env<CarRacingEnvSpec>(spec, env_id),
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
+
+  CarRacingEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         CarRacingBox2dEnv(spec.config["max_episode_steps"_],
-                          spec.config["lap_complete_percent"_]) {}
+                          spec.config["lap_complete_percent"_], !kStateObs) {}
 
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    CarRacingReset(&gen_);
+    CarRacingReset(&this->gen_);
     WriteState();
   }
 
   void Step(const Action& action) override {
-    CarRacingStep(&gen_, action["action"_][0], action["action"_][1],
+    CarRacingStep(&this->gen_, action["action"_][0], action["action"_][1],
                   action["action"_][2]);
     WriteState();
   }
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = step_reward_;
-    CreateImageArray();
-    state["obs"_].Assign(img_array_.data, 96 * 96 * 3);
+    if constexpr (kStateObs) {
+      CreateStateArray(this->spec_.config["num_waypoints"_]);
+      state["obs"_].Assign(state_array_.data(), state_array_.size());
+    } else {
+      CreateImageArray();
+      state["obs"_].Assign(img_array_.data, 96 * 96 * 3);
+    }
 #ifdef ENVPOOL_TEST
     state["info:tile_visited_count"_] = tile_visited_count_;
     state["info:car_fuel_spent"_] = car_->GetFuelSpent();
@@ -90,7 +138,10 @@ class CarRacingEnv : public Env<CarRacingEnvSpec>, public CarRacingBox2dEnv {
   }
 };
 
+using CarRacingEnv = CarRacingEnvBase<CarRacingEnvSpec>;
+using CarRacingStateEnv = CarRacingEnvBase<CarRacingStateEnvSpec>;
 using CarRacingEnvPool = AsyncEnvPool<CarRacingEnv>;
+using CarRacingStateEnvPool = AsyncEnvPool<CarRacingStateEnv>;
 
 }  // namespace box2d
 
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <random>
 #include <utility>
@@ -80,11 +81,12 @@ void CarRacingFrictionDetector::Contact(b2Contact* contact, bool begin) {
 }
 
 CarRacingBox2dEnv::CarRacingBox2dEnv(int max_episode_steps,
-                                     float lap_complete_percent)
+                                     float lap_complete_percent, bool render)
     : lap_complete_percent_(lap_complete_percent),
       max_episode_steps_(max_episode_steps),
       elapsed_step_(max_episode_steps + 1),
       done_(true),
+      render_(render),
       world_(new b2World(b2Vec2(0.0, 0.0))) {
   b2PolygonShape shape;
   std::array<b2Vec2, 4> vertices = {b2Vec2(0, 0), b2Vec2(1, 0), b2Vec2(1, -1),
@@ -410,7 +412,9 @@ void CarRacingBox2dEnv::StepBox2d(std::mt19937* gen, float action0,
       done_ = true;
     }
   }
-  Render();
+  if (render_) {
+    Render();
+  }
 }
 
 void CarRacingBox2dEnv::CreateImageArray() {
@@ -420,6 +424,45 @@ void CarRacingBox2dEnv::CreateImageArray() {
   cv::cvtColor(img_array_, img_array_, cv::COLOR_BGR2RGB);
 }
 
+void CarRacingBox2dEnv::CreateStateArray(int num_waypoints) {
+  b2Body* hull = car_->hull_;
+  b2Vec2 pos = hull->GetPosition();
+  b2Vec2 vel = hull->GetLinearVelocity();
+  // the car frame: x to the right of the car, y forward
+  b2Vec2 side = hull->GetWorldVector(b2Vec2(1, 0));
+  b2Vec2 forw = hull->GetWorldVector(b2Vec2(0, 1));
+  state_array_.clear();
+  state_array_.push_back(pos.x);
+  state_array_.push_back(pos.y);
+  state_array_.push_back(std::cos(hull->GetAngle()));
+  state_array_.push_back(std::sin(hull->GetAngle()));
+  state_array_.push_back(b2Dot(vel, side));
+  state_array_.push_back(b2Dot(vel, forw));
+  state_array_.push_back(hull->GetAngularVelocity());
+  for (auto* w : car_->wheels_) {
+    state_array_.push_back(w->joint->GetJointAngle());
+    state_array_.push_back(w->omega);
+  }
+  // the waypoints after the one nearest to the car, in the car frame
+  int track_size = static_cast<int>(track_.size());
+  int nearest = 0;
+  float nearest_dist = std::numeric_limits<float>::infinity();
+  for (int i = 0; i < track_size; ++i) {
+    float dx = track_[i][2] - pos.x;
+    float dy = track_[i][3] - pos.y;
+    if (dx * dx + dy * dy < nearest_dist) {
+      nearest_dist = dx * dx + dy * dy;
+      nearest = i;
+    }
+  }
+  for (int i = 1; i <= num_waypoints; ++i) {
+    const auto& waypoint = track_[(nearest + i) % track_size];
+    b2Vec2 d(waypoint[2] - pos.x, waypoint[3] - pos.y);
+    state_array_.push_back(b2Dot(d, side));
+    state_array_.push_back(b2Dot(d, forw));
+  }
+}
+
 void CarRacingBox2dEnv::DrawColoredPolygon(
     const std::array<std::array<float, 2>, 4>& field, const cv::Scalar& color,
     float zoom, const std::array<float, 2>& translation, float angle,
@@ -33,6 +33,9 @@
 
 namespace box2d {
 
+// size of the car part of the obs_type="state" observation
+static const int kCarRacingStateSize = 15;
+
 class CarRacingBox2dEnv;
 
 class CarRacingFrictionDetector : public b2ContactListener {
@@ -81,9 +84,11 @@ class CarRacingBox2dEnv {
   float prev_reward_{0};
   float step_reward_{0};
   bool done_;
+  bool render_;
 
   cv::Mat surf_;
   cv::Mat img_array_;
+  std::vector<float> state_array_;
 
   std::unique_ptr<CarRacingFrictionDetector> listener_;
   std::shared_ptr<b2World> world_;
@@ -99,7 +104,8 @@ class CarRacingBox2dEnv {
   std::vector<std::pair<std::array<b2Vec2, 4>, cv::Scalar>> roads_poly_;
 
  public:
-  CarRacingBox2dEnv(int max_episode_steps, float lap_complete_percent);
+  CarRacingBox2dEnv(int max_episode_steps, float lap_complete_percent,
+                    bool render = true);
   void Render();
 
   void RenderRoad(float zoom, const std::array<float, 2>& translation,
@@ -113,6 +119,7 @@ class CarRacingBox2dEnv {
   void CarRacingStep(std::mt19937* gen, float action0, float action1,
                      float action2);
   void CreateImageArray();
+  void CreateStateArray(int num_waypoints);
 
  private:
   [[nodiscard]] std::vector<cv::Point> VerticalInd(int place, int s, int h,
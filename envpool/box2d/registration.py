@@ -21,6 +21,14 @@ register(
   spec_cls="CarRacingEnvSpec",
   dm_cls="CarRacingDMEnvPool",
   gym_cls="CarRacingGymEnvPool",
+  default_obs_type="pixels",
+  obs_types={
+    "state": (
+      "CarRacingStateEnvSpec",
+      "CarRacingStateDMEnvPool",
+      "CarRacingStateGymEnvPool",
+    )
+  },
   max_episode_steps=1000,
 )
 
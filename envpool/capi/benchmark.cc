@@ -0,0 +1,67 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Throughput of the C API, the counterpart of benchmark/test_envpool.py
+// without the Python interpreter in the loop.
+//
+// Usage: benchmark [task_id] [num_envs] [batch_size] [num_threads]
+//                  [total_step]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "envpool/capi/envpool_cpp.h"
+
+int main(int argc, char** argv) {
+  std::string task_id = argc > 1 ? argv[1] : "CartPole-v1";
+  int num_envs = argc > 2 ? std::atoi(argv[2]) : 8;
+  int batch_size = argc > 3 ? std::atoi(argv[3]) : num_envs;
+  int num_threads = argc > 4 ? std::atoi(argv[4]) : 0;
+  int total_step = argc > 5 ? std::atoi(argv[5]) : 1000000;
+  try {
+    envpool_c::EnvPool pool(task_id,
+                            {{"num_envs", std::to_string(num_envs)},
+                             {"batch_size", std::to_string(batch_size)},
+                             {"num_threads", std::to_string(num_threads)}});
+    auto state = pool.StateBuffers();
+    // zero actions are valid for all the registered tasks
+    auto action = pool.ActionBuffers();
+    int env_id_index = pool.StateIndex("info:env_id");
+    std::vector<int32_t> env_ids(num_envs);
+    std::iota(env_ids.begin(), env_ids.end(), 0);
+    pool.Reset(env_ids);
+    auto start = std::chrono::steady_clock::now();
+    int64_t steps = 0;
+    while (steps < total_step) {
+      int n = pool.Recv(&state);
+      pool.Send(state[env_id_index].As<int32_t>(), n, &action);
+      steps += n;
+    }
+    std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%s num_envs=%d batch_size=%d: %lld steps in %.3fs, "
+                "FPS = %.0f\n",
+                task_id.c_str(), num_envs, batch_size,
+                static_cast<long long>(steps),  // NOLINT
+                duration.count(), steps / duration.count());
+  } catch (const envpool_c::Error& e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,38 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/box2d/bipedal_walker.h"
+#include "envpool/box2d/car_racing.h"
+#include "envpool/box2d/lunar_lander_continuous.h"
+#include "envpool/box2d/lunar_lander_discrete.h"
+#include "envpool/capi/c_envpool.h"
+
+// keep in sync with envpool/box2d/registration.py, the default obs_type of
+// each task is registered
+static const bool kRegistered = [] {  // NOLINT
+  using capi::Register;
+  Register<box2d::CarRacingEnvPool>("CarRacing-v2",
+                                    {{"max_episode_steps", "1000"}});
+  Register<box2d::BipedalWalkerEnvPool>(
+      "BipedalWalker-v3",
+      {{"hardcore", "false"}, {"max_episode_steps", "1600"}});
+  Register<box2d::BipedalWalkerEnvPool>(
+      "BipedalWalkerHardcore-v3",
+      {{"hardcore", "true"}, {"max_episode_steps", "2000"}});
+  Register<box2d::LunarLanderDiscreteEnvPool>("LunarLander-v2",
+                                              {{"max_episode_steps", "1000"}});
+  Register<box2d::LunarLanderContinuousEnvPool>(
+      "LunarLanderContinuous-v2", {{"max_episode_steps", "1000"}});
+  return true;
+}();
@@ -0,0 +1,357 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CAPI_C_ENVPOOL_H_
+#define ENVPOOL_CAPI_C_ENVPOOL_H_
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "envpool/capi/envpool_c.h"
+#include "envpool/core/envpool.h"
+
+namespace capi {
+
+using KeyValues = std::vector<std::pair<std::string, std::string>>;
+
+template <typename D>
+constexpr envpool_dtype_t ToDType() {
+  if constexpr (std::is_same_v<D, bool>) {
+    return ENVPOOL_DTYPE_BOOL;
+  } else if constexpr (std::is_floating_point_v<D>) {
+    return sizeof(D) == 4 ? ENVPOOL_DTYPE_FLOAT32 : ENVPOOL_DTYPE_FLOAT64;
+  } else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+    return sizeof(D) == 1   ? ENVPOOL_DTYPE_INT8
+           : sizeof(D) == 2 ? ENVPOOL_DTYPE_INT16
+           : sizeof(D) == 4 ? ENVPOOL_DTYPE_INT32
+                            : ENVPOOL_DTYPE_INT64;
+  } else if constexpr (std::is_integral_v<D>) {
+    return sizeof(D) == 1   ? ENVPOOL_DTYPE_UINT8
+           : sizeof(D) == 2 ? ENVPOOL_DTYPE_UINT16
+           : sizeof(D) == 4 ? ENVPOOL_DTYPE_UINT32
+                            : ENVPOOL_DTYPE_UINT64;
+  } else {
+    // Container states have no fixed memory layout
+    return ENVPOOL_DTYPE_INVALID;
+  }
+}
+
+/**
+ * Parse the string form of a config value, list values are comma separated
+ * and may be wrapped in brackets.
+ */
+template <typename T>
+void ParseValue(const std::string& str, T* value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    *value = str;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    if (str == "1" || str == "true" || str == "True") {
+      *value = true;
+    } else if (str == "0" || str == "false" || str == "False") {
+      *value = false;
+    } else {
+      throw std::invalid_argument("invalid bool value \"" + str + "\"");
+    }
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    std::size_t pos = 0;
+    if constexpr (std::is_floating_point_v<T>) {
+      *value = static_cast<T>(std::stod(str, &pos));
+    } else {
+      *value = static_cast<T>(std::stoll(str, &pos));
+    }
+    if (pos != str.size()) {
+      throw std::invalid_argument("invalid number \"" + str + "\"");
+    }
+  } else if constexpr (is_vector_v<T>) {
+    std::string s = str;
+    if (!s.empty() && s.front() == '[' && s.back() == ']') {
+      s = s.substr(1, s.size() - 2);
+    }
+    value->clear();
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      item.erase(0, item.find_first_not_of(' '));
+      item.erase(item.find_last_not_of(' ') + 1);
+      if (!item.empty()) {
+        ParseValue(item, &value->emplace_back());
+      }
+    }
+  } else {
+    throw std::invalid_argument("unsupported config type");
+  }
+}
+
+template <typename T>
+std::string FormatValue(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return value;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return value ? "true" : "false";
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    std::ostringstream ss;
+    ss << value;
+    return ss.str();
+  } else if constexpr (is_vector_v<T>) {
+    std::string ret;
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      ret += (i == 0 ? "" : ",") + FormatValue(value[i]);
+    }
+    return ret;
+  } else {
+    return "";
+  }
+}
+
+/**
+ * Type-erased pool behind the C ABI.
+ */
+class CEnvPoolBase {
+ public:
+  std::vector<std::string> state_keys, action_keys, config_keys;
+  std::vector<envpool_array_spec_t> state_spec, action_spec;
+  std::vector<std::string> config_values;
+
+  virtual ~CEnvPoolBase() = default;
+  virtual void Reset(const int* env_ids, int n, const int* seeds) = 0;
+  virtual void Send(const int* env_ids, int n, const void* const* action) = 0;
+  virtual int Recv(void* const* state) = 0;
+};
+
+/**
+ * Adapt an EnvPool to CEnvPoolBase. States are copied out of the state
+ * buffer on recv, and actions are copied into pool-owned arrays on send,
+ * since envs read them after send returns.
+ */
+template <typename EnvPool>
+class CEnvPool : public CEnvPoolBase {
+ protected:
+  using Spec = typename EnvPool::Spec;
+  // env_id and players.env_id, see common_action_spec
+  static constexpr std::size_t kNumCommonActions = 2;
+
+  EnvPool pool_;
+  int num_envs_;
+  int batch_;
+  std::vector<ShapeSpec> action_row_spec_;
+
+ public:
+  explicit CEnvPool(const Spec& spec)
+      : pool_(spec),
+        num_envs_(spec.config["num_envs"_]),
+        batch_(spec.config["batch_size"_]) {
+    if (spec.config["max_num_players"_] != 1) {
+      throw std::invalid_argument(
+          "Multi-player envs are not supported by the C API");
+    }
+    state_keys = Spec::StateSpec::AllKeys();
+    std::size_t i = 0;
+    std::apply(
+        [&](auto&&... s) {
+          (state_spec.push_back(MakeSpec(state_keys[i++], s)), ...);
+        },
+        spec.state_spec.AllValues());
+    std::vector<std::string> keys = Spec::ActionSpec::AllKeys();
+    i = 0;
+    std::apply(
+        [&](auto&&... s) {
+          (action_spec.push_back(MakeSpec(keys[i++], s)), ...);
+        },
+        spec.action_spec.AllValues());
+    action_spec.erase(action_spec.begin(),
+                      action_spec.begin() + kNumCommonActions);
+    action_keys.assign(keys.begin() + kNumCommonActions, keys.end());
+    // names point into the key vectors, which are not modified afterwards
+    for (std::size_t j = 0; j < state_spec.size(); ++j) {
+      state_spec[j].name = state_keys[j].c_str();
+    }
+    for (std::size_t j = 0; j < action_spec.size(); ++j) {
+      action_spec[j].name = action_keys[j].c_str();
+      std::vector<int> shape(action_spec[j].shape + 1,
+                             action_spec[j].shape + action_spec[j].ndim);
+      action_row_spec_.emplace_back(
+          static_cast<int>(action_spec[j].element_size), shape);
+    }
+    config_keys = Spec::Config::AllKeys();
+    std::apply(
+        [&](auto&&... v) { (config_values.push_back(FormatValue(v)), ...); },
+        spec.config.AllValues());
+  }
+
+  void Reset(const int* env_ids, int n, const int* seeds) override {
+    CheckEnvIds(env_ids, n);
+    // env ids and seeds are consumed before Reset returns
+    Array arr = Wrap(env_ids, n);
+    if (seeds == nullptr) {
+      pool_.Reset(arr);
+    } else {
+      pool_.Reset(arr, Wrap(seeds, n));
+    }
+  }
+
+  void Send(const int* env_ids, int n, const void* const* action) override {
+    CheckEnvIds(env_ids, n);
+    std::vector<Array> arr;
+    arr.reserve(kNumCommonActions + action_row_spec_.size());
+    for (std::size_t i = 0; i < kNumCommonActions; ++i) {
+      arr.emplace_back(CopyIn(ShapeSpec(sizeof(int), {}), n, env_ids));
+    }
+    for (std::size_t i = 0; i < action_row_spec_.size(); ++i) {
+      arr.emplace_back(CopyIn(action_row_spec_[i], n, action[i]));
+    }
+    pool_.Send(arr);
+  }
+
+  int Recv(void* const* state) override {
+    std::vector<Array> arr = pool_.Recv();
+    for (std::size_t i = 0; i < arr.size(); ++i) {
+      if (state[i] != nullptr) {
+        std::memcpy(state[i], arr[i].Data(), arr[i].size * arr[i].element_size);
+      }
+    }
+    return static_cast<int>(arr[0].Shape(0));
+  }
+
+ protected:
+  template <typename S>
+  envpool_array_spec_t MakeSpec(const std::string& key, const S& s) const {
+    envpool_array_spec_t ret{};
+    ret.dtype = ToDType<typename S::dtype>();
+    if (ret.dtype == ENVPOOL_DTYPE_INVALID) {
+      throw std::invalid_argument("State or action \"" + key +
+                                  "\" is a container, which is not "
+                                  "supported by the C API");
+    }
+    ret.element_size = s.element_size;
+    // a leading -1 is the player dimension, which equals the batch here
+    std::size_t start = !s.shape.empty() && s.shape[0] == -1 ? 1 : 0;
+    if (s.shape.size() - start + 1 > ENVPOOL_MAX_NDIM) {
+      throw std::invalid_argument("\"" + key + "\" has too many dimensions");
+    }
+    ret.ndim = 1;
+    ret.shape[0] = batch_;
+    ret.nbytes = batch_ * s.element_size;
+    for (std::size_t i = start; i < s.shape.size(); ++i) {
+      if (s.shape[i] < 0) {
+        throw std::invalid_argument("\"" + key +
+                                    "\" has a dynamic shape, which is not "
+                                    "supported by the C API");
+      }
+      ret.shape[ret.ndim++] = s.shape[i];
+      ret.nbytes *= s.shape[i];
+    }
+    return ret;
+  }
+
+  /**
+   * The pool indexes its envs by id without checking, so out-of-range ids
+   * are rejected here, before anything is sent.
+   */
+  void CheckEnvIds(const int* env_ids, int n) const {
+    if (n < 0 || (n > 0 && env_ids == nullptr)) {
+      throw std::invalid_argument("env_ids is null or n < 0");
+    }
+    for (int i = 0; i < n; ++i) {
+      if (env_ids[i] < 0 || env_ids[i] >= num_envs_) {
+        throw std::out_of_range("env_id " + std::to_string(env_ids[i]) +
+                                " is out of range [0, " +
+                                std::to_string(num_envs_) + ")");
+      }
+    }
+  }
+
+  static Array Wrap(const int* data, int n) {
+    return {ShapeSpec(sizeof(int), {n}),
+            const_cast<char*>(reinterpret_cast<const char*>(data))};
+  }
+
+  static Array CopyIn(const ShapeSpec& row, int n, const void* src) {
+    Array arr(row.Batch(n));
+    std::memcpy(arr.Data(), src, arr.size * arr.element_size);
+    return arr;
+  }
+};
+
+using Factory =
+    std::function<std::unique_ptr<CEnvPoolBase>(const KeyValues& config)>;
+
+inline std::map<std::string, Factory>& Registry() {
+  static std::map<std::string, Factory> registry;
+  return registry;
+}
+
+/**
+ * Build the config of EnvPool from its defaults, the task defaults and the
+ * user config, in that order.
+ */
+template <typename EnvPool>
+typename EnvPool::Spec::ConfigValues MakeConfig(const KeyValues& task_config,
+                                                const KeyValues& config) {
+  using Spec = typename EnvPool::Spec;
+  typename Spec::ConfigValues values = Spec::kDefaultConfig.AllValues();
+  std::vector<std::string> keys = Spec::Config::AllKeys();
+  for (const auto* kv : {&task_config, &config}) {
+    for (const auto& [key, value] : *kv) {
+      auto it = std::find(keys.begin(), keys.end(), key);
+      if (it == keys.end()) {
+        throw std::invalid_argument("Unknown config key \"" + key + "\"");
+      }
+      std::size_t index = it - keys.begin();
+      std::size_t i = 0;
+      try {
+        std::apply(
+            [&](auto&... v) {
+              ((i++ == index ? ParseValue(value, &v) : void()), ...);
+            },
+            values);
+      } catch (const std::exception& e) {
+        throw std::invalid_argument("Invalid value of config \"" + key +
+                                    "\": " + e.what());
+      }
+    }
+  }
+  return values;
+}
+
+/**
+ * Register `task_id`, made of EnvPool with `task_config` on top of its
+ * default config, e.g. the max_episode_steps of each task version. Call it
+ * from a static initializer in the translation unit of each env family.
+ */
+template <typename EnvPool>
+bool Register(const std::string& task_id, const KeyValues& task_config = {}) {
+  Registry()[task_id] = [task_config](const KeyValues& config) {
+    typename EnvPool::Spec spec(MakeConfig<EnvPool>(task_config, config));
+    if (spec.config["num_envs"_] < 1) {
+      throw std::invalid_argument("num_envs should be >= 1");
+    }
+    return std::unique_ptr<CEnvPoolBase>(new CEnvPool<EnvPool>(spec));
+  };
+  return true;
+}
+
+}  // namespace capi
+
+#endif  // ENVPOOL_CAPI_C_ENVPOOL_H_
@@ -0,0 +1,42 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/capi/c_envpool.h"
+#include "envpool/classic_control/acrobot.h"
+#include "envpool/classic_control/cartpole.h"
+#include "envpool/classic_control/mountain_car.h"
+#include "envpool/classic_control/mountain_car_continuous.h"
+#include "envpool/classic_control/pendulum.h"
+
+// keep in sync with envpool/classic_control/registration.py
+static const bool kRegistered = [] {  // NOLINT
+  using capi::Register;
+  Register<classic_control::CartPoleEnvPool>(
+      "CartPole-v0",
+      {{"max_episode_steps", "200"}, {"reward_threshold", "195.0"}});
+  Register<classic_control::CartPoleEnvPool>(
+      "CartPole-v1",
+      {{"max_episode_steps", "500"}, {"reward_threshold", "475.0"}});
+  Register<classic_control::PendulumEnvPool>(
+      "Pendulum-v0", {{"version", "0"}, {"max_episode_steps", "200"}});
+  Register<classic_control::PendulumEnvPool>(
+      "Pendulum-v1", {{"version", "1"}, {"max_episode_steps", "200"}});
+  Register<classic_control::MountainCarEnvPool>("MountainCar-v0",
+                                                {{"max_episode_steps", "200"}});
+  Register<classic_control::MountainCarContinuousEnvPool>(
+      "MountainCarContinuous-v0", {{"max_episode_steps", "999"}});
+  Register<classic_control::AcrobotEnvPool>("Acrobot-v1",
+                                            {{"max_episode_steps", "500"}});
+  return true;
+}();
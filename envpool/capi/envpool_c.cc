@@ -0,0 +1,214 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/capi/envpool_c.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "envpool/capi/c_envpool.h"
+
+struct envpool_t {
+  std::unique_ptr<capi::CEnvPoolBase> pool;
+};
+
+namespace {
+
+thread_local std::string last_error;  // NOLINT
+
+/**
+ * Run fn and turn any exception into a negative return value, since
+ * exceptions must not cross the C ABI.
+ */
+template <typename Fn>
+int Guard(Fn&& fn) {
+  try {
+    return fn();
+  } catch (const std::exception& e) {
+    last_error = e.what();
+  } catch (...) {
+    last_error = "unknown error";
+  }
+  return -1;
+}
+
+int CheckPool(const envpool_t* pool) {
+  if (pool == nullptr || pool->pool == nullptr) {
+    throw std::invalid_argument("pool is null");
+  }
+  return 0;
+}
+
+void CheckNotNull(const void* ptr, const std::string& name) {
+  if (ptr == nullptr) {
+    throw std::invalid_argument(name + " is null");
+  }
+}
+
+int CopySpec(const std::vector<envpool_array_spec_t>& specs, int index,
+             envpool_array_spec_t* spec) {
+  if (index < 0 || index >= static_cast<int>(specs.size())) {
+    throw std::out_of_range("spec index " + std::to_string(index) +
+                            " out of range");
+  }
+  *spec = specs[index];
+  return 0;
+}
+
+}  // namespace
+
+extern "C" {
+
+const char* envpool_last_error(void) { return last_error.c_str(); }
+
+int envpool_list_tasks(const char** task_ids, int capacity) {
+  const auto& registry = capi::Registry();
+  int i = 0;
+  if (task_ids == nullptr) {
+    capacity = 0;
+  }
+  for (auto it = registry.begin(); it != registry.end() && i < capacity;
+       ++it) {
+    task_ids[i++] = it->first.c_str();
+  }
+  return static_cast<int>(registry.size());
+}
+
+int envpool_create(const char* task_id, int num_config,
+                   const char* const* keys, const char* const* values,
+                   envpool_t** pool) {
+  return Guard([&] {
+    CheckNotNull(task_id, "task_id");
+    CheckNotNull(pool, "pool");
+    if (num_config < 0) {
+      throw std::invalid_argument("num_config should be >= 0, got " +
+                                  std::to_string(num_config));
+    }
+    if (num_config > 0) {
+      CheckNotNull(keys, "keys");
+      CheckNotNull(values, "values");
+    }
+    const auto& registry = capi::Registry();
+    auto it = registry.find(task_id);
+    if (it == registry.end()) {
+      throw std::invalid_argument(std::string(task_id) +
+                                  " is not a registered task");
+    }
+    capi::KeyValues config;
+    for (int i = 0; i < num_config; ++i) {
+      CheckNotNull(keys[i], "keys[" + std::to_string(i) + "]");
+      CheckNotNull(values[i], "values[" + std::to_string(i) + "]");
+      config.emplace_back(keys[i], values[i]);
+    }
+    auto ret = std::make_unique<envpool_t>();
+    ret->pool = it->second(config);
+    *pool = ret.release();
+    return 0;
+  });
+}
+
+void envpool_destroy(envpool_t* pool) { delete pool; }
+
+int envpool_config(const envpool_t* pool, const char* key, char* buf,
+                   size_t len) {
+  return Guard([&] {
+    CheckPool(pool);
+    CheckNotNull(key, "key");
+    if (len > 0) {
+      CheckNotNull(buf, "buf");
+    }
+    const auto& keys = pool->pool->config_keys;
+    auto it = std::find(keys.begin(), keys.end(), key);
+    if (it == keys.end()) {
+      throw std::invalid_argument("Unknown config key \"" +
+                                  std::string(key) + "\"");
+    }
+    const std::string& value = pool->pool->config_values[it - keys.begin()];
+    if (len > 0) {
+      std::size_t n = std::min(len - 1, value.size());
+      std::memcpy(buf, value.data(), n);
+      buf[n] = '\0';
+    }
+    return static_cast<int>(value.size());
+  });
+}
+
+int envpool_num_states(const envpool_t* pool) {
+  return Guard([&] {
+    CheckPool(pool);
+    return static_cast<int>(pool->pool->state_spec.size());
+  });
+}
+
+int envpool_state_spec(const envpool_t* pool, int index,
+                       envpool_array_spec_t* spec) {
+  return Guard([&] {
+    CheckPool(pool);
+    return CopySpec(pool->pool->state_spec, index, spec);
+  });
+}
+
+int envpool_num_actions(const envpool_t* pool) {
+  return Guard([&] {
+    CheckPool(pool);
+    return static_cast<int>(pool->pool->action_spec.size());
+  });
+}
+
+int envpool_action_spec(const envpool_t* pool, int index,
+                        envpool_array_spec_t* spec) {
+  return Guard([&] {
+    CheckPool(pool);
+    return CopySpec(pool->pool->action_spec, index, spec);
+  });
+}
+
+int envpool_reset(envpool_t* pool, const int32_t* env_ids, int n) {
+  return Guard([&] {
+    CheckPool(pool);
+    pool->pool->Reset(env_ids, n, nullptr);
+    return 0;
+  });
+}
+
+int envpool_reset_with_seed(envpool_t* pool, const int32_t* env_ids,
+                            const int32_t* seeds, int n) {
+  return Guard([&] {
+    CheckPool(pool);
+    pool->pool->Reset(env_ids, n, seeds);
+    return 0;
+  });
+}
+
+int envpool_send(envpool_t* pool, const int32_t* env_ids, int n,
+                 const void* const* actions) {
+  return Guard([&] {
+    CheckPool(pool);
+    pool->pool->Send(env_ids, n, actions);
+    return 0;
+  });
+}
+
+int envpool_recv(envpool_t* pool, void* const* states) {
+  return Guard([&] {
+    CheckPool(pool);
+    return pool->pool->Recv(states);
+  });
+}
+
+}  // extern "C"
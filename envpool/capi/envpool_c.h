@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CAPI_ENVPOOL_C_H_
+#define ENVPOOL_CAPI_ENVPOOL_C_H_
+
+/**
+ * Stable C ABI of envpool, exported by libenvpool_c.so.
+ *
+ * A pool is created from a registered task id and string key-value config,
+ * e.g. {"num_envs": "8", "batch_size": "4"}. Each state and action key is
+ * described by an envpool_array_spec_t, whose leading dimension is the number
+ * of rows of a full batch. All data is exchanged through caller-owned, C
+ * contiguous buffers; action buffers can be reused as soon as envpool_send
+ * returns.
+ *
+ * Functions returning int return a negative value on failure, and
+ * envpool_last_error gives the message of the last failure on this thread.
+ *
+ * The classic control, toy text and box2d tasks are registered. Atari,
+ * MuJoCo and ViZDoom are not: they load ROMs, model assets and the game
+ * binary from base_path, which defaults to the location of the installed
+ * Python package, and would link ALE, MuJoCo and ViZDoom into this library.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENVPOOL_C_API __attribute__((visibility("default")))
+#define ENVPOOL_MAX_NDIM 8
+
+typedef struct envpool_t envpool_t;
+
+typedef enum {
+  ENVPOOL_DTYPE_BOOL = 0,
+  ENVPOOL_DTYPE_INT8,
+  ENVPOOL_DTYPE_INT16,
+  ENVPOOL_DTYPE_INT32,
+  ENVPOOL_DTYPE_INT64,
+  ENVPOOL_DTYPE_UINT8,
+  ENVPOOL_DTYPE_UINT16,
+  ENVPOOL_DTYPE_UINT32,
+  ENVPOOL_DTYPE_UINT64,
+  ENVPOOL_DTYPE_FLOAT32,
+  ENVPOOL_DTYPE_FLOAT64,
+  ENVPOOL_DTYPE_INVALID,
+} envpool_dtype_t;
+
+typedef struct {
+  /* key of the state or action, e.g. "obs", "reward", "action" */
+  const char* name;
+  envpool_dtype_t dtype;
+  size_t element_size;
+  /* shape of a full batch, shape[0] is the batch size */
+  int ndim;
+  int64_t shape[ENVPOOL_MAX_NDIM];
+  /* size in bytes of a full batch */
+  size_t nbytes;
+} envpool_array_spec_t;
+
+/* Message of the last failed call on the calling thread. */
+ENVPOOL_C_API const char* envpool_last_error(void);
+
+/**
+ * Write up to `capacity` registered task ids into `task_ids` (nothing if it
+ * is NULL), and return the total number of registered tasks.
+ */
+ENVPOOL_C_API int envpool_list_tasks(const char** task_ids, int capacity);
+
+/**
+ * Create a pool of `task_id`, overriding `num_config` config entries. Values
+ * are parsed according to the type of each key; list values are comma
+ * separated. Only single player envs with static shapes are supported.
+ * task_id, pool and, for the first num_config entries, keys and values must
+ * not be NULL, otherwise the call fails.
+ */
+ENVPOOL_C_API int envpool_create(const char* task_id, int num_config,
+                                 const char* const* keys,
+                                 const char* const* values, envpool_t** pool);
+
+ENVPOOL_C_API void envpool_destroy(envpool_t* pool);
+
+/**
+ * Write the value of config `key` as a string into `buf` (truncated to
+ * `len`), and return the full length of the value.
+ */
+ENVPOOL_C_API int envpool_config(const envpool_t* pool, const char* key,
+                                 char* buf, size_t len);
+
+ENVPOOL_C_API int envpool_num_states(const envpool_t* pool);
+
+ENVPOOL_C_API int envpool_state_spec(const envpool_t* pool, int index,
+                                     envpool_array_spec_t* spec);
+
+/**
+ * Number of action keys, excluding env_id and players.env_id which are
+ * passed to envpool_send as `env_ids`.
+ */
+ENVPOOL_C_API int envpool_num_actions(const envpool_t* pool);
+
+ENVPOOL_C_API int envpool_action_spec(const envpool_t* pool, int index,
+                                      envpool_array_spec_t* spec);
+
+/**
+ * Reset envs `env_ids[0 .. n)`, their states arrive in envpool_recv. Fail if
+ * an env id is not in [0, num_envs).
+ */
+ENVPOOL_C_API int envpool_reset(envpool_t* pool, const int32_t* env_ids,
+                                int n);
+
+/* Reset envs `env_ids[0 .. n)`, reseeding env_ids[i] with seeds[i]. */
+ENVPOOL_C_API int envpool_reset_with_seed(envpool_t* pool,
+                                          const int32_t* env_ids,
+                                          const int32_t* seeds, int n);
+
+/**
+ * Step envs `env_ids[0 .. n)`. `actions[i]` points to `n` rows of the i-th
+ * action in envpool_action_spec order. Fail if an env id is not in
+ * [0, num_envs).
+ */
+ENVPOOL_C_API int envpool_send(envpool_t* pool, const int32_t* env_ids, int n,
+                               const void* const* actions);
+
+/**
+ * Block until a batch is ready and copy the i-th state into `states[i]`, in
+ * envpool_state_spec order; a NULL buffer skips the state. Return the number
+ * of rows received.
+ */
+ENVPOOL_C_API int envpool_recv(envpool_t* pool, void* const* states);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // ENVPOOL_CAPI_ENVPOOL_C_H_
@@ -0,0 +1,178 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "envpool/capi/envpool_c.h"
+#include "envpool/capi/envpool_cpp.h"
+
+TEST(EnvPoolCTest, Spec) {
+  auto tasks = envpool_c::ListTasks();
+  EXPECT_NE(std::find(tasks.begin(), tasks.end(), "CartPole-v1"), tasks.end());
+  envpool_c::EnvPool pool("CartPole-v1",
+                          {{"num_envs", "8"}, {"batch_size", "4"}});
+  EXPECT_EQ(pool.Config("num_envs"), "8");
+  EXPECT_EQ(pool.Config("max_episode_steps"), "500");
+  const auto& obs = pool.StateSpec()[pool.StateIndex("obs")];
+  EXPECT_EQ(obs.dtype, ENVPOOL_DTYPE_FLOAT32);
+  EXPECT_EQ(obs.ndim, 2);
+  EXPECT_EQ(obs.shape[0], 4);
+  EXPECT_EQ(obs.shape[1], 4);
+  EXPECT_EQ(obs.nbytes, 4 * 4 * sizeof(float));
+  // player dimension of reward is folded into the batch
+  const auto& reward = pool.StateSpec()[pool.StateIndex("reward")];
+  EXPECT_EQ(reward.ndim, 1);
+  ASSERT_EQ(pool.ActionSpec().size(), 1);
+  EXPECT_EQ(std::string(pool.ActionSpec()[0].name), "action");
+  EXPECT_EQ(pool.ActionSpec()[0].dtype, ENVPOOL_DTYPE_INT32);
+  EXPECT_EQ(pool.ActionSpec()[0].ndim, 1);
+}
+
+TEST(EnvPoolCTest, Error) {
+  envpool_t* pool = nullptr;
+  EXPECT_LT(envpool_create("NoSuchTask-v0", 0, nullptr, nullptr, &pool), 0);
+  EXPECT_NE(std::string(envpool_last_error()).find("NoSuchTask-v0"),
+            std::string::npos);
+  EXPECT_THROW(envpool_c::EnvPool("CartPole-v1", {{"no_such_key", "1"}}),
+               envpool_c::Error);
+  EXPECT_THROW(envpool_c::EnvPool("CartPole-v1", {{"num_envs", "x"}}),
+               envpool_c::Error);
+  EXPECT_THROW(envpool_c::EnvPool("CartPole-v1",
+                                  {{"num_envs", "2"}, {"batch_size", "3"}}),
+               envpool_c::Error);
+  // null pointers are rejected instead of dereferenced
+  EXPECT_LT(envpool_create(nullptr, 0, nullptr, nullptr, &pool), 0);
+  EXPECT_EQ(std::string(envpool_last_error()), "task_id is null");
+  const char* keys[] = {"num_envs", nullptr};
+  const char* values[] = {"2", "1"};
+  EXPECT_LT(envpool_create("CartPole-v1", 1, nullptr, values, &pool), 0);
+  EXPECT_EQ(std::string(envpool_last_error()), "keys is null");
+  EXPECT_LT(envpool_create("CartPole-v1", 2, keys, values, &pool), 0);
+  EXPECT_EQ(std::string(envpool_last_error()), "keys[1] is null");
+  EXPECT_LT(envpool_create("CartPole-v1", 1, keys, values, nullptr), 0);
+  EXPECT_EQ(std::string(envpool_last_error()), "pool is null");
+  EXPECT_EQ(pool, nullptr);
+}
+
+TEST(EnvPoolCTest, EnvIdOutOfRange) {
+  const char* keys[] = {"num_envs"};
+  const char* values[] = {"2"};
+  envpool_t* pool = nullptr;
+  ASSERT_EQ(envpool_create("CartPole-v1", 1, keys, values, &pool), 0);
+  int32_t action[2] = {0, 1};
+  const void* actions[] = {action};
+  for (int32_t bad : {2, -1}) {
+    int32_t env_ids[2] = {0, bad};
+    EXPECT_LT(envpool_reset(pool, env_ids, 2), 0);
+    EXPECT_NE(std::string(envpool_last_error()).find("out of range"),
+              std::string::npos);
+    EXPECT_LT(envpool_send(pool, env_ids, 2, actions), 0);
+    EXPECT_NE(std::string(envpool_last_error()).find(std::to_string(bad)),
+              std::string::npos);
+  }
+  // nothing was sent, the pool is still usable
+  int32_t env_ids[2] = {0, 1};
+  EXPECT_EQ(envpool_reset(pool, env_ids, 2), 0);
+  std::vector<void*> states(envpool_num_states(pool), nullptr);
+  EXPECT_EQ(envpool_recv(pool, states.data()), 2);
+  envpool_destroy(pool);
+}
+
+TEST(EnvPoolCTest, Step) {
+  int num_envs = 4;
+  envpool_c::EnvPool pool("CartPole-v0", {{"num_envs", "4"}, {"seed", "0"}});
+  auto state = pool.StateBuffers();
+  auto action = pool.ActionBuffers();
+  int env_id_index = pool.StateIndex("info:env_id");
+  int elapsed_index = pool.StateIndex("elapsed_step");
+  int done_index = pool.StateIndex("done");
+  std::vector<int32_t> env_ids(num_envs);
+  std::iota(env_ids.begin(), env_ids.end(), 0);
+  pool.Reset(env_ids);
+  std::vector<int> length(num_envs, 0);
+  std::vector<int> done_count(num_envs, 0);
+  for (int step = 0; step < 1000; ++step) {
+    ASSERT_EQ(pool.Recv(&state), num_envs);
+    auto* env_id = state[env_id_index].As<int32_t>();
+    auto* elapsed = state[elapsed_index].As<int32_t>();
+    auto* done = state[done_index].As<bool>();
+    for (int i = 0; i < num_envs; ++i) {
+      EXPECT_EQ(env_id[i], i);
+      EXPECT_EQ(elapsed[i], length[i]);
+      ++length[i];
+      if (done[i]) {
+        EXPECT_LE(elapsed[i], 200);
+        length[i] = 0;
+        ++done_count[i];
+      }
+      // always push right, every episode ends quickly
+      action[0].As<int32_t>()[i] = 1;
+    }
+    pool.Send(env_id, num_envs, &action);
+  }
+  for (int i = 0; i < num_envs; ++i) {
+    EXPECT_GT(done_count[i], 10);
+  }
+}
+
+TEST(EnvPoolCTest, ResetWithSeed) {
+  envpool_c::EnvPool pool("CartPole-v1", {{"num_envs", "3"}});
+  auto state = pool.StateBuffers();
+  int obs_index = pool.StateIndex("obs");
+  auto reset = [&](const std::vector<int32_t>& seeds) {
+    pool.Reset({0, 1, 2}, seeds);
+    pool.Recv(&state);
+    const auto* obs = state[obs_index].As<float>();
+    return std::vector<float>(obs, obs + 3 * 4);
+  };
+  auto obs = reset({7, 7, 8});
+  EXPECT_TRUE(std::equal(obs.begin(), obs.begin() + 4, obs.begin() + 4));
+  EXPECT_FALSE(std::equal(obs.begin(), obs.begin() + 4, obs.begin() + 8));
+  // reseeding reproduces the episode without rebuilding the pool
+  std::vector<float> expected(obs.begin() + 8, obs.end());
+  expected.insert(expected.end(), obs.begin(), obs.begin() + 4);
+  expected.insert(expected.end(), obs.begin(), obs.begin() + 4);
+  EXPECT_EQ(reset({8, 7, 7}), expected);
+}
+
+TEST(EnvPoolCTest, ToyText) {
+  for (const auto* task_id :
+       {"Catch-v0", "FrozenLake-v1", "FrozenLake8x8-v1", "Taxi-v3", "NChain-v0",
+        "CliffWalking-v0", "Blackjack-v1"}) {
+    EXPECT_NO_THROW(envpool_c::EnvPool(task_id, {{"num_envs", "1"}}))
+        << task_id;
+  }
+  envpool_c::EnvPool pool("Taxi-v3", {{"num_envs", "2"}});
+  EXPECT_EQ(pool.Config("max_episode_steps"), "200");
+  auto state = pool.StateBuffers();
+  auto action = pool.ActionBuffers();
+  int obs_index = pool.StateIndex("obs");
+  std::vector<int32_t> env_ids({0, 1});
+  pool.Reset(env_ids);
+  for (int step = 0; step < 10; ++step) {
+    ASSERT_EQ(pool.Recv(&state), 2);
+    for (int i = 0; i < 2; ++i) {
+      int32_t obs = state[obs_index].As<int32_t>()[i];
+      EXPECT_GE(obs, 0);
+      EXPECT_LT(obs, 500);
+      action[0].As<int32_t>()[i] = step % 4;
+    }
+    pool.Send(env_ids.data(), 2, &action);
+  }
+}
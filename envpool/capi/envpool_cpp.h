@@ -0,0 +1,187 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CAPI_ENVPOOL_CPP_H_
+#define ENVPOOL_CAPI_ENVPOOL_CPP_H_
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envpool/capi/envpool_c.h"
+
+/**
+ * Header-only C++ wrapper of the C ABI in envpool_c.h, it only depends on
+ * libenvpool_c.so and the standard library.
+ */
+namespace envpool_c {
+
+class Error : public std::runtime_error {
+ public:
+  Error() : std::runtime_error(envpool_last_error()) {}
+};
+
+inline int Check(int ret) {
+  if (ret < 0) {
+    throw Error();
+  }
+  return ret;
+}
+
+inline std::vector<std::string> ListTasks() {
+  std::vector<const char*> ids(Check(envpool_list_tasks(nullptr, 0)));
+  envpool_list_tasks(ids.data(), static_cast<int>(ids.size()));
+  return {ids.begin(), ids.end()};
+}
+
+/**
+ * One batch of a state or action, laid out as described by its spec.
+ */
+struct Buffer {
+  envpool_array_spec_t spec;
+  std::vector<char> data;
+
+  explicit Buffer(const envpool_array_spec_t& spec)
+      : spec(spec), data(spec.nbytes) {}
+
+  template <typename T>
+  T* As() {
+    return reinterpret_cast<T*>(data.data());
+  }
+};
+
+class EnvPool {
+ protected:
+  envpool_t* pool_{nullptr};
+  std::vector<envpool_array_spec_t> state_spec_, action_spec_;
+
+ public:
+  explicit EnvPool(const std::string& task_id,
+                   const std::map<std::string, std::string>& config = {}) {
+    std::vector<const char*> keys;
+    std::vector<const char*> values;
+    for (const auto& [k, v] : config) {
+      keys.push_back(k.c_str());
+      values.push_back(v.c_str());
+    }
+    Check(envpool_create(task_id.c_str(), static_cast<int>(keys.size()),
+                         keys.data(), values.data(), &pool_));
+    state_spec_.resize(Check(envpool_num_states(pool_)));
+    for (std::size_t i = 0; i < state_spec_.size(); ++i) {
+      Check(envpool_state_spec(pool_, i, &state_spec_[i]));
+    }
+    action_spec_.resize(Check(envpool_num_actions(pool_)));
+    for (std::size_t i = 0; i < action_spec_.size(); ++i) {
+      Check(envpool_action_spec(pool_, i, &action_spec_[i]));
+    }
+  }
+  ~EnvPool() { envpool_destroy(pool_); }
+  EnvPool(const EnvPool&) = delete;
+  EnvPool& operator=(const EnvPool&) = delete;
+  EnvPool(EnvPool&& other) noexcept
+      : pool_(std::exchange(other.pool_, nullptr)),
+        state_spec_(std::move(other.state_spec_)),
+        action_spec_(std::move(other.action_spec_)) {}
+
+  [[nodiscard]] std::string Config(const std::string& key) const {
+    std::string ret(Check(envpool_config(pool_, key.c_str(), nullptr, 0)),
+                    '\0');
+    envpool_config(pool_, key.c_str(), ret.data(), ret.size() + 1);
+    return ret;
+  }
+
+  [[nodiscard]] const std::vector<envpool_array_spec_t>& StateSpec() const {
+    return state_spec_;
+  }
+
+  [[nodiscard]] const std::vector<envpool_array_spec_t>& ActionSpec() const {
+    return action_spec_;
+  }
+
+  [[nodiscard]] int StateIndex(const std::string& key) const {
+    return Index(state_spec_, key);
+  }
+
+  [[nodiscard]] int ActionIndex(const std::string& key) const {
+    return Index(action_spec_, key);
+  }
+
+  /**
+   * Allocate one full batch for each state or action.
+   */
+  [[nodiscard]] std::vector<Buffer> StateBuffers() const {
+    return {state_spec_.begin(), state_spec_.end()};
+  }
+
+  [[nodiscard]] std::vector<Buffer> ActionBuffers() const {
+    return {action_spec_.begin(), action_spec_.end()};
+  }
+
+  void Reset(const std::vector<int32_t>& env_ids) {
+    Check(envpool_reset(pool_, env_ids.data(),
+                        static_cast<int>(env_ids.size())));
+  }
+
+  /**
+   * Reset env_ids[i] with seeds[i] as its new seed.
+   */
+  void Reset(const std::vector<int32_t>& env_ids,
+             const std::vector<int32_t>& seeds) {
+    if (seeds.size() != env_ids.size()) {
+      throw std::invalid_argument("seeds and env_ids differ in length");
+    }
+    Check(envpool_reset_with_seed(pool_, env_ids.data(), seeds.data(),
+                                  static_cast<int>(env_ids.size())));
+  }
+
+  void Send(const int32_t* env_ids, int n, std::vector<Buffer>* action) {
+    std::vector<const void*> ptr;
+    ptr.reserve(action->size());
+    for (auto& b : *action) {
+      ptr.push_back(b.data.data());
+    }
+    Check(envpool_send(pool_, env_ids, n, ptr.data()));
+  }
+
+  /**
+   * Receive a batch into state and return its number of rows.
+   */
+  int Recv(std::vector<Buffer>* state) {
+    std::vector<void*> ptr;
+    ptr.reserve(state->size());
+    for (auto& b : *state) {
+      ptr.push_back(b.data.data());
+    }
+    return Check(envpool_recv(pool_, ptr.data()));
+  }
+
+ protected:
+  static int Index(const std::vector<envpool_array_spec_t>& specs,
+                   const std::string& key) {
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+      if (key == specs[i].name) {
+        return static_cast<int>(i);
+      }
+    }
+    throw std::out_of_range("No such key: " + key);
+  }
+};
+
+}  // namespace envpool_c
+
+#endif  // ENVPOOL_CAPI_ENVPOOL_CPP_H_
@@ -0,0 +1,44 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/capi/c_envpool.h"
+#include "envpool/toy_text/blackjack.h"
+#include "envpool/toy_text/catch.h"
+#include "envpool/toy_text/cliffwalking.h"
+#include "envpool/toy_text/frozen_lake.h"
+#include "envpool/toy_text/nchain.h"
+#include "envpool/toy_text/taxi.h"
+
+// keep in sync with envpool/toy_text/registration.py
+static const bool kRegistered = [] {  // NOLINT
+  using capi::Register;
+  Register<toy_text::CatchEnvPool>("Catch-v0",
+                                   {{"height", "10"}, {"width", "5"}});
+  Register<toy_text::FrozenLakeEnvPool>("FrozenLake-v1",
+                                        {{"size", "4"},
+                                         {"max_episode_steps", "100"},
+                                         {"reward_threshold", "0.7"}});
+  Register<toy_text::FrozenLakeEnvPool>("FrozenLake8x8-v1",
+                                        {{"size", "8"},
+                                         {"max_episode_steps", "200"},
+                                         {"reward_threshold", "0.85"}});
+  Register<toy_text::TaxiEnvPool>(
+      "Taxi-v3", {{"max_episode_steps", "200"}, {"reward_threshold", "8.0"}});
+  Register<toy_text::NChainEnvPool>("NChain-v0",
+                                    {{"max_episode_steps", "1000"}});
+  Register<toy_text::CliffWalkingEnvPool>("CliffWalking-v0");
+  Register<toy_text::BlackjackEnvPool>("Blackjack-v1",
+                                       {{"sab", "true"}, {"natural", "false"}});
+  return true;
+}();
@@ -18,14 +18,24 @@ from envpool.python.api import py_env
 from .classic_control_envpool import (
   _AcrobotEnvPool,
   _AcrobotEnvSpec,
+  _AcrobotPixelEnvPool,
+  _AcrobotPixelEnvSpec,
   _CartPoleEnvPool,
   _CartPoleEnvSpec,
+  _CartPolePixelEnvPool,
+  _CartPolePixelEnvSpec,
   _MountainCarContinuousEnvPool,
   _MountainCarContinuousEnvSpec,
+  _MountainCarContinuousPixelEnvPool,
+  _MountainCarContinuousPixelEnvSpec,
   _MountainCarEnvPool,
   _MountainCarEnvSpec,
+  _MountainCarPixelEnvPool,
+  _MountainCarPixelEnvSpec,
   _PendulumEnvPool,
   _PendulumEnvSpec,
+  _PendulumPixelEnvPool,
+  _PendulumPixelEnvSpec,
 )
 
 CartPoleEnvSpec, CartPoleDMEnvPool, CartPoleGymEnvPool = py_env(
@@ -48,6 +58,30 @@ AcrobotEnvSpec, AcrobotDMEnvPool, AcrobotGymEnvPool = py_env(
   _AcrobotEnvSpec, _AcrobotEnvPool
 )
 
+CartPolePixelEnvSpec, CartPolePixelDMEnvPool, CartPolePixelGymEnvPool = py_env(
+  _CartPolePixelEnvSpec, _CartPolePixelEnvPool
+)
+
+PendulumPixelEnvSpec, PendulumPixelDMEnvPool, PendulumPixelGymEnvPool = py_env(
+  _PendulumPixelEnvSpec, _PendulumPixelEnvPool
+)
+
+(
+  MountainCarPixelEnvSpec, MountainCarPixelDMEnvPool,
+  MountainCarPixelGymEnvPool
+) = py_env(_MountainCarPixelEnvSpec, _MountainCarPixelEnvPool)
+
+(
+  MountainCarContinuousPixelEnvSpec, MountainCarContinuousPixelDMEnvPool,
+  MountainCarContinuousPixelGymEnvPool
+) = py_env(
+  _MountainCarContinuousPixelEnvSpec, _MountainCarContinuousPixelEnvPool
+)
+
+AcrobotPixelEnvSpec, AcrobotPixelDMEnvPool, AcrobotPixelGymEnvPool = py_env(
+  _AcrobotPixelEnvSpec, _AcrobotPixelEnvPool
+)
+
 __all__ = [
   "CartPoleEnvSpec",
   "CartPoleDMEnvPool",
@@ -64,4 +98,19 @@ __all__ = [
   "AcrobotEnvSpec",
   "AcrobotDMEnvPool",
   "AcrobotGymEnvPool",
+  "CartPolePixelEnvSpec",
+  "CartPolePixelDMEnvPool",
+  "CartPolePixelGymEnvPool",
+  "PendulumPixelEnvSpec",
+  "PendulumPixelDMEnvPool",
+  "PendulumPixelGymEnvPool",
+  "MountainCarPixelEnvSpec",
+  "MountainCarPixelDMEnvPool",
+  "MountainCarPixelGymEnvPool",
+  "MountainCarContinuousPixelEnvSpec",
+  "MountainCarContinuousPixelDMEnvPool",
+  "MountainCarContinuousPixelGymEnvPool",
+  "AcrobotPixelEnvSpec",
+  "AcrobotPixelDMEnvPool",
+  "AcrobotPixelGymEnvPool",
 ]
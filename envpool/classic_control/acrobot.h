@@ -21,6 +21,7 @@
 #include <cmath>
 #include <random>
 
+#include "envpool/classic_control/pixel_obs.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
 
@@ -45,8 +46,10 @@ class AcrobotEnvFns {
 };
 
 using AcrobotEnvSpec = EnvSpec<AcrobotEnvFns>;
+using AcrobotPixelEnvSpec = EnvSpec<PixelEnvFns<AcrobotEnvFns>>;
 
-class AcrobotEnv : public Env<AcrobotEnvSpec> {
+template <typename EnvSpec>
+class AcrobotEnvBase : public Env<EnvSpec> {
   struct V5 {
     double s0{0}, s1{0}, s2{0}, s3{0}, s4{0};
     V5() = default;
@@ -60,6 +63,10 @@ class AcrobotEnv : public Env<AcrobotEnvSpec> {
     }
   };
 
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
+
  protected:
   const double kG = 9.8;
   const double kDt = 0.2;
@@ -77,8 +84,8 @@ class AcrobotEnv : public Env<AcrobotEnvSpec> {
   bool done_;
 
  public:
-  AcrobotEnv(const Spec& spec, int env_id)
-      : Env<AcrobotEnvSpec>(spec, env_id),
+  AcrobotEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         max_episode_steps_(spec.config["max_episode_steps"_]),
         elapsed_step_(max_episode_steps_ + 1),
         dist_(-kInitRange, kInitRange),
@@ -87,10 +94,10 @@ class AcrobotEnv : public Env<AcrobotEnvSpec> {
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    s_.s0 = dist_(gen_);
-    s_.s1 = dist_(gen_);
-    s_.s2 = dist_(gen_);
-    s_.s3 = dist_(gen_);
+    s_.s0 = dist_(this->gen_);
+    s_.s1 = dist_(this->gen_);
+    s_.s2 = dist_(this->gen_);
+    s_.s3 = dist_(this->gen_);
     s_.s4 = 0;
     done_ = false;
     elapsed_step_ = 0;
@@ -168,20 +175,50 @@ class AcrobotEnv : public Env<AcrobotEnvSpec> {
   }
 
   void WriteState(float reward) {
-    State state = Allocate();
-    state["obs"_][0] = static_cast<float>(std::cos(s_.s0));
-    state["obs"_][1] = static_cast<float>(std::sin(s_.s0));
-    state["obs"_][2] = static_cast<float>(std::cos(s_.s1));
-    state["obs"_][3] = static_cast<float>(std::sin(s_.s1));
-    state["obs"_][4] = static_cast<float>(s_.s2);
-    state["obs"_][5] = static_cast<float>(s_.s3);
-    state["info:state"_][0] = static_cast<float>(s_.s0);
-    state["info:state"_][1] = static_cast<float>(s_.s1);
+    State state = this->Allocate();
+    Array& obs = StateObs<EnvSpec>(&state);
+    obs[0] = static_cast<float>(std::cos(s_.s0));
+    obs[1] = static_cast<float>(std::sin(s_.s0));
+    obs[2] = static_cast<float>(std::cos(s_.s1));
+    obs[3] = static_cast<float>(std::sin(s_.s1));
+    obs[4] = static_cast<float>(s_.s2);
+    obs[5] = static_cast<float>(s_.s3);
     state["reward"_] = reward;
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      Render(static_cast<uint8_t*>(state["obs"_].Data()));
+    } else {
+      state["info:state"_][0] = static_cast<float>(s_.s0);
+      state["info:state"_][1] = static_cast<float>(s_.s1);
+    }
+  }
+
+  // gym AcrobotEnv.render
+  void Render(uint8_t* rgb) {
+    const double scale = 500 / 4.4;
+    const double offset = 250;
+    const double width = 0.1 * scale;
+    Canvas canvas(rgb, this->spec_.config["img_width"_],
+                  this->spec_.config["img_height"_], 500, 500);
+    canvas.Clear({255, 255, 255});
+    canvas.Line({0, offset + scale}, {500, offset + scale}, 1, {0, 0, 0});
+    Canvas::Point p0{offset, offset};
+    Canvas::Point p1{offset + kL * scale * std::sin(s_.s0),
+                     offset - kL * scale * std::cos(s_.s0)};
+    double th[2] = {s_.s0 - M_PI / 2, s_.s0 + s_.s1 - M_PI / 2};
+    Canvas::Point joints[2] = {p0, p1};
+    for (int i = 0; i < 2; ++i) {
+      canvas.FillPolygon(Canvas::RotatedRect(0, -width, kL * scale, width,
+                                             th[i], joints[i]),
+                         {0, 204, 204});
+      canvas.FillCircle(joints[i][0], joints[i][1], width, {204, 204, 0});
+    }
   }
 };
 
+using AcrobotEnv = AcrobotEnvBase<AcrobotEnvSpec>;
+using AcrobotPixelEnv = AcrobotEnvBase<AcrobotPixelEnvSpec>;
 using AcrobotEnvPool = AsyncEnvPool<AcrobotEnv>;
+using AcrobotPixelEnvPool = AsyncEnvPool<AcrobotPixelEnv>;
 
 }  // namespace classic_control
 
@@ -22,6 +22,7 @@
 #include <limits>
 #include <random>
 
+#include "envpool/classic_control/pixel_obs.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
 
@@ -46,8 +47,14 @@ class CartPoleEnvFns {
 };
 
 using CartPoleEnvSpec = EnvSpec<CartPoleEnvFns>;
+using CartPolePixelEnvSpec = EnvSpec<PixelEnvFns<CartPoleEnvFns>>;
+
+template <typename EnvSpec>
+class CartPoleEnvBase : public Env<EnvSpec> {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class CartPoleEnv : public Env<CartPoleEnvSpec> {
  protected:
   const double kGravity = 9.8;
   const double kMassCart = 1.0;
@@ -66,8 +73,8 @@ class CartPoleEnv : public Env<CartPoleEnvSpec> {
   bool done_;
 
  public:
-  CartPoleEnv(const Spec& spec, int env_id)
-      : Env<CartPoleEnvSpec>(spec, env_id),
+  CartPoleEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         max_episode_steps_(spec.config["max_episode_steps"_]),
         elapsed_step_(max_episode_steps_ + 1),
         dist_(-kInitRange, kInitRange),
@@ -76,10 +83,10 @@ class CartPoleEnv : public Env<CartPoleEnvSpec> {
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    x_ = dist_(gen_);
-    x_dot_ = dist_(gen_);
-    theta_ = dist_(gen_);
-    theta_dot_ = dist_(gen_);
+    x_ = dist_(this->gen_);
+    x_dot_ = dist_(this->gen_);
+    theta_ = dist_(this->gen_);
+    theta_dot_ = dist_(this->gen_);
     done_ = false;
     elapsed_step_ = 0;
     WriteState(0.0);
@@ -112,16 +119,49 @@ class CartPoleEnv : public Env<CartPoleEnvSpec> {
 
  private:
   void WriteState(float reward) {
-    State state = Allocate();
-    state["obs"_][0] = static_cast<float>(x_);
-    state["obs"_][1] = static_cast<float>(x_dot_);
-    state["obs"_][2] = static_cast<float>(theta_);
-    state["obs"_][3] = static_cast<float>(theta_dot_);
+    State state = this->Allocate();
+    Array& obs = StateObs<EnvSpec>(&state);
+    obs[0] = static_cast<float>(x_);
+    obs[1] = static_cast<float>(x_dot_);
+    obs[2] = static_cast<float>(theta_);
+    obs[3] = static_cast<float>(theta_dot_);
     state["reward"_] = reward;
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      Render(static_cast<uint8_t*>(state["obs"_].Data()));
+    }
+  }
+
+  // gym CartPoleEnv.render
+  void Render(uint8_t* rgb) {
+    const double scale = 600 / (kXThreshold * 2);
+    const double pole_width = 10;
+    const double pole_len = scale * (2 * kLength);
+    const double cart_width = 50;
+    const double cart_height = 30;
+    const double axle_offset = cart_height / 4;
+    double cart_x = x_ * scale + 300;
+    double cart_y = 100;
+    Canvas canvas(rgb, this->spec_.config["img_width"_],
+                  this->spec_.config["img_height"_], 600, 400);
+    canvas.Clear({255, 255, 255});
+    canvas.FillRect(cart_x - cart_width / 2, cart_y - cart_height / 2,
+                    cart_x + cart_width / 2, cart_y + cart_height / 2,
+                    {0, 0, 0});
+    canvas.FillPolygon(
+        Canvas::RotatedRect(-pole_width / 2, -pole_width / 2, pole_width / 2,
+                            pole_len - pole_width / 2, -theta_,
+                            {cart_x, cart_y + axle_offset}),
+        {202, 152, 101});
+    canvas.FillCircle(cart_x, cart_y + axle_offset, pole_width / 2,
+                      {129, 132, 203});
+    canvas.Line({0, cart_y}, {600, cart_y}, 1, {0, 0, 0});
   }
 };
 
+using CartPoleEnv = CartPoleEnvBase<CartPoleEnvSpec>;
+using CartPolePixelEnv = CartPoleEnvBase<CartPolePixelEnvSpec>;
 using CartPoleEnvPool = AsyncEnvPool<CartPoleEnv>;
+using CartPolePixelEnvPool = AsyncEnvPool<CartPolePixelEnv>;
 
 }  // namespace classic_control
 
@@ -21,25 +21,45 @@
 
 using CartPoleEnvSpec = PyEnvSpec<classic_control::CartPoleEnvSpec>;
 using CartPoleEnvPool = PyEnvPool<classic_control::CartPoleEnvPool>;
+using CartPolePixelEnvSpec = PyEnvSpec<classic_control::CartPolePixelEnvSpec>;
+using CartPolePixelEnvPool = PyEnvPool<classic_control::CartPolePixelEnvPool>;
 
 using PendulumEnvSpec = PyEnvSpec<classic_control::PendulumEnvSpec>;
 using PendulumEnvPool = PyEnvPool<classic_control::PendulumEnvPool>;
+using PendulumPixelEnvSpec = PyEnvSpec<classic_control::PendulumPixelEnvSpec>;
+using PendulumPixelEnvPool = PyEnvPool<classic_control::PendulumPixelEnvPool>;
 
 using MountainCarEnvSpec = PyEnvSpec<classic_control::MountainCarEnvSpec>;
 using MountainCarEnvPool = PyEnvPool<classic_control::MountainCarEnvPool>;
+using MountainCarPixelEnvSpec =
+    PyEnvSpec<classic_control::MountainCarPixelEnvSpec>;
+using MountainCarPixelEnvPool =
+    PyEnvPool<classic_control::MountainCarPixelEnvPool>;
 
 using MountainCarContinuousEnvSpec =
     PyEnvSpec<classic_control::MountainCarContinuousEnvSpec>;
 using MountainCarContinuousEnvPool =
     PyEnvPool<classic_control::MountainCarContinuousEnvPool>;
+using MountainCarContinuousPixelEnvSpec =
+    PyEnvSpec<classic_control::MountainCarContinuousPixelEnvSpec>;
+using MountainCarContinuousPixelEnvPool =
+    PyEnvPool<classic_control::MountainCarContinuousPixelEnvPool>;
 
 using AcrobotEnvSpec = PyEnvSpec<classic_control::AcrobotEnvSpec>;
 using AcrobotEnvPool = PyEnvPool<classic_control::AcrobotEnvPool>;
+using AcrobotPixelEnvSpec = PyEnvSpec<classic_control::AcrobotPixelEnvSpec>;
+using AcrobotPixelEnvPool = PyEnvPool<classic_control::AcrobotPixelEnvPool>;
 
 PYBIND11_MODULE(classic_control_envpool, m) {
   REGISTER(m, CartPoleEnvSpec, CartPoleEnvPool)
+  REGISTER(m, CartPolePixelEnvSpec, CartPolePixelEnvPool)
   REGISTER(m, PendulumEnvSpec, PendulumEnvPool)
+  REGISTER(m, PendulumPixelEnvSpec, PendulumPixelEnvPool)
   REGISTER(m, MountainCarEnvSpec, MountainCarEnvPool)
+  REGISTER(m, MountainCarPixelEnvSpec, MountainCarPixelEnvPool)
   REGISTER(m, MountainCarContinuousEnvSpec, MountainCarContinuousEnvPool)
+  REGISTER(m, MountainCarContinuousPixelEnvSpec,
+           MountainCarContinuousPixelEnvPool)
   REGISTER(m, AcrobotEnvSpec, AcrobotEnvPool)
+  REGISTER(m, AcrobotPixelEnvSpec, AcrobotPixelEnvPool)
 }
@@ -13,14 +13,15 @@
 # limitations under the License.
 """Unit tests for classic control environments."""
 
-from typing import Any, no_type_check
+import threading
+from typing import Any, List, no_type_check
 
 import gym
 import numpy as np
 from absl.testing import absltest
 
 import envpool.classic_control.registration  # noqa: F401
-from envpool.registration import make_gym
+from envpool.registration import make_dm, make_gym
 
 
 class _ClassicControlEnvPoolTest(absltest.TestCase):
@@ -123,6 +124,128 @@ class _ClassicControlEnvPoolTest(absltest.TestCase):
     self.run_space_check(env0, env1)
     # self.run_align_check(env0, env1, reset_fn)
 
+  def test_reset_with_seed(self) -> None:
+    env0 = make_gym("Pendulum-v1", num_envs=4, seed=3)
+    env1 = make_gym("Pendulum-v1", num_envs=4, seed=0)
+    obs0, _ = env0.reset()
+    # reseeding reproduces the episodes of a pool built with that seed
+    obs1, _ = env1.reset(seed=3)
+    np.testing.assert_allclose(obs0, obs1)
+    obs1, _ = env1.reset(np.array([2, 0]), seed=np.array([5, 3]))
+    np.testing.assert_allclose(obs1, obs0[[2, 0]])
+    for _ in range(10):
+      action = np.ones((4, 1))
+      np.testing.assert_allclose(env0.step(action)[0], env1.step(action)[0])
+
+  def test_pools_in_threads(self) -> None:
+    num_pools, num_envs = 4, 8
+
+    def rollout(seed: int, out: List[np.ndarray]) -> None:
+      env = make_gym("Pendulum-v1", num_envs=num_envs, seed=seed)
+      obs, _ = env.reset()
+      action = np.ones((num_envs, 1)) * (seed % 3 - 1)
+      for _ in range(200):
+        obs = env.step(action)[0]
+      out.append(obs)
+
+    expected: List[np.ndarray] = []
+    for seed in range(num_pools):
+      rollout(seed, expected)
+    results: List[List[np.ndarray]] = [[] for _ in range(num_pools)]
+    threads = [
+      threading.Thread(target=rollout, args=(seed, results[seed]))
+      for seed in range(num_pools)
+    ]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+    for seed in range(num_pools):
+      np.testing.assert_allclose(results[seed][0], expected[seed])
+
+  def test_user_state(self) -> None:
+    # without a payload, the observations and infos are unchanged
+    _, info = make_gym("CartPole-v1", num_envs=2).reset()
+    self.assertNotIn("user_state", info)
+    env = make_dm("CartPole-v1", num_envs=2)
+    self.assertNotIn("user_state", env.observation_spec()._fields)
+    self.assertNotIn("user_state", env.reset().observation._fields)
+    num_envs, batch_size, hidden = 8, 4, 16
+    env = make_gym(
+      "CartPole-v1",
+      num_envs=num_envs,
+      batch_size=batch_size,
+      user_state_size=hidden,
+    )
+    user_state_spec = env.spec.state_array_spec["info:user_state"]
+    self.assertEqual(tuple(user_state_spec.shape), (hidden,))
+    # the recurrent state of each env, kept on the learner side for reference
+    expected = np.zeros((num_envs, hidden), dtype=np.float32)
+    env.async_reset()
+    for t in range(300):
+      _, _, _, _, info = env.recv()
+      env_id = info["env_id"]
+      first = info["elapsed_step"] == 0
+      expected[env_id[first]] = 0
+      np.testing.assert_array_equal(info["user_state"], expected[env_id])
+      next_state = info["user_state"] + t + 1
+      expected[env_id] = next_state
+      env.send(np.zeros(batch_size, dtype=int), env_id, user_state=next_state)
+    self.assertRaises(
+      ValueError,
+      make_gym,
+      "CartPole-v1",
+      user_state_size=-1,
+    )
+
+  def test_evaluate(self) -> None:
+    num_envs = 6
+    quota = np.array([0, 1, 2, 3, 1, 5])
+    for batch_size in [num_envs, 4]:
+      env = make_gym("CartPole-v1", num_envs=num_envs, batch_size=batch_size)
+      episodes = env.evaluate(
+        lambda ts: (ts[0][:, 2] > 0).astype(np.int32), quota
+      )
+      np.testing.assert_array_equal(
+        np.bincount(episodes["env_id"], minlength=num_envs), quota
+      )
+      np.testing.assert_allclose(episodes["return"], episodes["length"])
+      self.assertTrue((episodes["length"] > 0).all())
+      # the envs which finished their quota are not restarted
+      self.assertFalse(env.gauges()["in_flight"].any())
+    self.assertRaises(ValueError, env.evaluate, lambda ts: ts, -1)
+
+  def test_pixels(self) -> None:
+    num_envs = 4
+    for task_id in [
+      "CartPole-v1", "Pendulum-v1", "MountainCar-v0",
+      "MountainCarContinuous-v0", "Acrobot-v1"
+    ]:
+      env0 = make_gym(task_id, num_envs=num_envs, seed=0, obs_type="pixels")
+      env1 = make_gym(task_id, num_envs=num_envs, seed=0, obs_type="pixels")
+      state_env = make_gym(task_id, num_envs=num_envs, seed=0)
+      self.assertEqual(env0.observation_space.shape, (3, 84, 84))
+      self.assertEqual(env0.observation_space.dtype, np.uint8)
+      obs0, info0 = env0.reset()
+      obs1, _ = env1.reset()
+      state_obs, _ = state_env.reset()
+      self.assertEqual(obs0.shape, (num_envs, 3, 84, 84))
+      self.assertEqual(obs0.dtype, np.uint8)
+      np.testing.assert_array_equal(obs0, obs1)
+      # the state observation is the one of the default obs_type
+      np.testing.assert_allclose(info0["state_obs"], state_obs)
+      # the scene is not a blank background
+      self.assertGreater(np.ptp(obs0[0]), 32, task_id)
+      action = np.array([env0.action_space.sample()] * num_envs)
+      for _ in range(10):
+        next0 = env0.step(action)[0]
+        next1 = env1.step(action)[0]
+      np.testing.assert_array_equal(next0, next1)
+      self.assertFalse(np.array_equal(obs0, next0), task_id)
+    env = make_gym("CartPole-v1", obs_type="pixels", img_width=64)
+    self.assertEqual(env.reset()[0].shape, (1, 3, 84, 64))
+    self.assertRaises(ValueError, make_gym, "CartPole-v1", obs_type="rgb")
+
 
 if __name__ == "__main__":
   absltest.main()
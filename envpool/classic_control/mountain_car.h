@@ -21,6 +21,7 @@
 #include <cmath>
 #include <random>
 
+#include "envpool/classic_control/pixel_obs.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
 
@@ -42,9 +43,51 @@ class MountainCarEnvFns {
   }
 };
 
+// gym MountainCarEnv.render, shared with MountainCarContinuous
+inline void RenderMountainCar(Canvas* canvas, double pos, double goal_pos) {
+  const double min_pos = -1.2;
+  const double scale = 600 / 1.8;
+  const double car_width = 40;
+  const double car_height = 20;
+  const double clearance = 10;
+  auto height = [](double x) { return std::sin(3 * x) * 0.45 + 0.55; };
+  canvas->Clear({255, 255, 255});
+  Canvas::Point prev{0, height(min_pos) * scale};
+  for (int i = 1; i < 100; ++i) {
+    double x = min_pos + 1.8 * i / 99;
+    Canvas::Point next{(x - min_pos) * scale, height(x) * scale};
+    canvas->Line(prev, next, 1, {0, 0, 0});
+    prev = next;
+  }
+  double angle = std::cos(3 * pos);
+  Canvas::Point shift{(pos - min_pos) * scale,
+                      clearance + height(pos) * scale};
+  canvas->FillPolygon(Canvas::RotatedRect(-car_width / 2, 0, car_width / 2,
+                                          car_height, angle, shift),
+                      {0, 0, 0});
+  for (double wx : {car_width / 4, -car_width / 4}) {
+    double x = wx * std::cos(angle) + shift[0];
+    double y = wx * std::sin(angle) + shift[1];
+    canvas->FillCircle(x, y, car_height / 2.5, {128, 128, 128});
+  }
+  double flag_x = (goal_pos - min_pos) * scale;
+  double flag_y1 = height(goal_pos) * scale;
+  double flag_y2 = flag_y1 + 50;
+  canvas->Line({flag_x, flag_y1}, {flag_x, flag_y2}, 1, {0, 0, 0});
+  canvas->FillPolygon(
+      {{flag_x, flag_y2}, {flag_x, flag_y2 - 10}, {flag_x + 25, flag_y2 - 5}},
+      {204, 204, 0});
+}
+
 using MountainCarEnvSpec = EnvSpec<MountainCarEnvFns>;
+using MountainCarPixelEnvSpec = EnvSpec<PixelEnvFns<MountainCarEnvFns>>;
+
+template <typename EnvSpec>
+class MountainCarEnvBase : public Env<EnvSpec> {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class MountainCarEnv : public Env<MountainCarEnvSpec> {
  protected:
   const double kMinPos = -1.2;
   const double kMaxPos = 0.6;
@@ -59,8 +102,8 @@ class MountainCarEnv : public Env<MountainCarEnvSpec> {
   bool done_;
 
  public:
-  MountainCarEnv(const Spec& spec, int env_id)
-      : Env<MountainCarEnvSpec>(spec, env_id),
+  MountainCarEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         max_episode_steps_(spec.config["max_episode_steps"_]),
         elapsed_step_(max_episode_steps_ + 1),
         dist_(-0.6, -0.4),
@@ -69,7 +112,7 @@ class MountainCarEnv : public Env<MountainCarEnvSpec> {
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    pos_ = dist_(gen_);
+    pos_ = dist_(this->gen_);
     vel_ = 0.0;
     done_ = false;
     elapsed_step_ = 0;
@@ -102,14 +145,27 @@ class MountainCarEnv : public Env<MountainCarEnvSpec> {
 
  private:
   void WriteState(float reward) {
-    State state = Allocate();
-    state["obs"_][0] = static_cast<float>(pos_);
-    state["obs"_][1] = static_cast<float>(vel_);
+    State state = this->Allocate();
+    Array& obs = StateObs<EnvSpec>(&state);
+    obs[0] = static_cast<float>(pos_);
+    obs[1] = static_cast<float>(vel_);
     state["reward"_] = reward;
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      Render(static_cast<uint8_t*>(state["obs"_].Data()));
+    }
+  }
+
+  void Render(uint8_t* rgb) {
+    Canvas canvas(rgb, this->spec_.config["img_width"_],
+                  this->spec_.config["img_height"_], 600, 400);
+    RenderMountainCar(&canvas, pos_, kGoalPos);
   }
 };
 
+using MountainCarEnv = MountainCarEnvBase<MountainCarEnvSpec>;
+using MountainCarPixelEnv = MountainCarEnvBase<MountainCarPixelEnvSpec>;
 using MountainCarEnvPool = AsyncEnvPool<MountainCarEnv>;
+using MountainCarPixelEnvPool = AsyncEnvPool<MountainCarPixelEnv>;
 
 }  // namespace classic_control
 
@@ -21,6 +21,8 @@
 #include <cmath>
 #include <random>
 
+#include "envpool/classic_control/mountain_car.h"
+#include "envpool/classic_control/pixel_obs.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
 
@@ -43,8 +45,15 @@ class MountainCarContinuousEnvFns {
 };
 
 using MountainCarContinuousEnvSpec = EnvSpec<MountainCarContinuousEnvFns>;
+using MountainCarContinuousPixelEnvSpec =
+    EnvSpec<PixelEnvFns<MountainCarContinuousEnvFns>>;
+
+template <typename EnvSpec>
+class MountainCarContinuousEnvBase : public Env<EnvSpec> {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class MountainCarContinuousEnv : public Env<MountainCarContinuousEnvSpec> {
  protected:
   const double kMinPos = -1.2;
   const double kMaxPos = 0.6;
@@ -59,8 +68,8 @@ class MountainCarContinuousEnv : public Env<MountainCarContinuousEnvSpec> {
   bool done_;
 
  public:
-  MountainCarContinuousEnv(const Spec& spec, int env_id)
-      : Env<MountainCarContinuousEnvSpec>(spec, env_id),
+  MountainCarContinuousEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         max_episode_steps_(spec.config["max_episode_steps"_]),
         elapsed_step_(max_episode_steps_ + 1),
         dist_(-0.6, -0.4),
@@ -69,7 +78,7 @@ class MountainCarContinuousEnv : public Env<MountainCarContinuousEnvSpec> {
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    pos_ = dist_(gen_);
+    pos_ = dist_(this->gen_);
     vel_ = 0.0;
     done_ = false;
     elapsed_step_ = 0;
@@ -109,14 +118,30 @@ class MountainCarContinuousEnv : public Env<MountainCarContinuousEnvSpec> {
 
  private:
   void WriteState(float reward) {
-    State state = Allocate();
-    state["obs"_][0] = static_cast<float>(pos_);
-    state["obs"_][1] = static_cast<float>(vel_);
+    State state = this->Allocate();
+    Array& obs = StateObs<EnvSpec>(&state);
+    obs[0] = static_cast<float>(pos_);
+    obs[1] = static_cast<float>(vel_);
     state["reward"_] = reward;
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      Render(static_cast<uint8_t*>(state["obs"_].Data()));
+    }
+  }
+
+  void Render(uint8_t* rgb) {
+    Canvas canvas(rgb, this->spec_.config["img_width"_],
+                  this->spec_.config["img_height"_], 600, 400);
+    RenderMountainCar(&canvas, pos_, kGoalPos);
   }
 };
 
+using MountainCarContinuousEnv =
+    MountainCarContinuousEnvBase<MountainCarContinuousEnvSpec>;
+using MountainCarContinuousPixelEnv =
+    MountainCarContinuousEnvBase<MountainCarContinuousPixelEnvSpec>;
 using MountainCarContinuousEnvPool = AsyncEnvPool<MountainCarContinuousEnv>;
+using MountainCarContinuousPixelEnvPool =
+    AsyncEnvPool<MountainCarContinuousPixelEnv>;
 
 }  // namespace classic_control
 
@@ -21,6 +21,7 @@
 #include <cmath>
 #include <random>
 
+#include "envpool/classic_control/pixel_obs.h"
 #include "envpool/core/async_envpool.h"
 #include "envpool/core/env.h"
 
@@ -41,8 +42,14 @@ class PendulumEnvFns {
 };
 
 using PendulumEnvSpec = EnvSpec<PendulumEnvFns>;
+using PendulumPixelEnvSpec = EnvSpec<PixelEnvFns<PendulumEnvFns>>;
+
+template <typename EnvSpec>
+class PendulumEnvBase : public Env<EnvSpec> {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class PendulumEnv : public Env<PendulumEnvSpec> {
  protected:
   const double kMaxSpeed = 8;
   const double kMaxTorque = 2;
@@ -56,8 +63,8 @@ class PendulumEnv : public Env<PendulumEnvSpec> {
   bool done_;
 
  public:
-  PendulumEnv(const Spec& spec, int env_id)
-      : Env<PendulumEnvSpec>(spec, env_id),
+  PendulumEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         max_episode_steps_(spec.config["max_episode_steps"_]),
         elapsed_step_(max_episode_steps_ + 1),
         version_(spec.config["version"_]),
@@ -68,8 +75,8 @@ class PendulumEnv : public Env<PendulumEnvSpec> {
   bool IsDone() override { return done_; }
 
   void Reset() override {
-    theta_ = dist_(gen_);
-    theta_dot_ = dist_dot_(gen_);
+    theta_ = dist_(this->gen_);
+    theta_dot_ = dist_dot_(this->gen_);
     done_ = false;
     elapsed_step_ = 0;
     WriteState(0.0);
@@ -105,15 +112,42 @@ class PendulumEnv : public Env<PendulumEnvSpec> {
 
  private:
   void WriteState(float reward) {
-    State state = Allocate();
-    state["obs"_][0] = static_cast<float>(std::cos(theta_));
-    state["obs"_][1] = static_cast<float>(std::sin(theta_));
-    state["obs"_][2] = static_cast<float>(theta_dot_);
+    State state = this->Allocate();
+    Array& obs = StateObs<EnvSpec>(&state);
+    obs[0] = static_cast<float>(std::cos(theta_));
+    obs[1] = static_cast<float>(std::sin(theta_));
+    obs[2] = static_cast<float>(theta_dot_);
     state["reward"_] = reward;
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      Render(static_cast<uint8_t*>(state["obs"_].Data()));
+    }
+  }
+
+  // gym PendulumEnv.render
+  void Render(uint8_t* rgb) {
+    const double scale = 500 / 4.4;
+    const double offset = 250;
+    const double rod_width = 0.2 * scale;
+    double angle = theta_ + M_PI / 2;
+    Canvas canvas(rgb, this->spec_.config["img_width"_],
+                  this->spec_.config["img_height"_], 500, 500);
+    canvas.Clear({255, 255, 255});
+    canvas.FillPolygon(Canvas::RotatedRect(0, -rod_width / 2, scale,
+                                           rod_width / 2, angle,
+                                           {offset, offset}),
+                       {204, 77, 77});
+    canvas.FillCircle(offset, offset, rod_width / 2, {204, 77, 77});
+    canvas.FillCircle(offset + scale * std::cos(angle),
+                      offset + scale * std::sin(angle), rod_width / 2,
+                      {204, 77, 77});
+    canvas.FillCircle(offset, offset, 0.05 * scale, {0, 0, 0});
   }
 };
 
+using PendulumEnv = PendulumEnvBase<PendulumEnvSpec>;
+using PendulumPixelEnv = PendulumEnvBase<PendulumPixelEnvSpec>;
 using PendulumEnvPool = AsyncEnvPool<PendulumEnv>;
+using PendulumPixelEnvPool = AsyncEnvPool<PendulumPixelEnv>;
 
 }  // namespace classic_control
 
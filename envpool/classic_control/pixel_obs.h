@@ -0,0 +1,225 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CLASSIC_CONTROL_PIXEL_OBS_H_
+#define ENVPOOL_CLASSIC_CONTROL_PIXEL_OBS_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "envpool/core/env_spec.h"
+
+namespace classic_control {
+
+struct Color {
+  uint8_t r, g, b;
+};
+
+/**
+ * 2D rasterizer of the gym classic_control scenes into a [3, height, width]
+ * uint8 image. Shapes are given in the coordinates of the gym pygame screen
+ * (scene_width x scene_height, y up) and scaled to the image size. Every
+ * shape is cut into horizontal spans, each filled with one memset per
+ * channel, and is at least one pixel wide so that thin lines survive
+ * downscaling.
+ */
+class Canvas {
+ public:
+  using Point = std::array<double, 2>;
+
+ protected:
+  uint8_t* rgb_;
+  int width_, height_;
+  double scene_height_, sx_, sy_;
+  std::size_t plane_;
+
+ public:
+  Canvas(uint8_t* rgb, int width, int height, double scene_width,
+         double scene_height)
+      : rgb_(rgb),
+        width_(width),
+        height_(height),
+        scene_height_(scene_height),
+        sx_(width / scene_width),
+        sy_(height / scene_height),
+        plane_(static_cast<std::size_t>(width) * height) {}
+
+  void Clear(Color c) {
+    std::memset(rgb_, c.r, plane_);
+    std::memset(rgb_ + plane_, c.g, plane_);
+    std::memset(rgb_ + 2 * plane_, c.b, plane_);
+  }
+
+  // points of a convex polygon, in either order
+  void FillPolygon(const std::vector<Point>& points, Color c) {
+    std::vector<Point> p;
+    for (const auto& q : points) {
+      p.push_back(ToImage(q));
+    }
+    double ymin = p[0][1];
+    double ymax = p[0][1];
+    for (const auto& q : p) {
+      ymin = std::min(ymin, q[1]);
+      ymax = std::max(ymax, q[1]);
+    }
+    int r0 = std::max(0, static_cast<int>(std::floor(ymin)));
+    int r1 = std::min(height_ - 1, static_cast<int>(std::ceil(ymax)));
+    for (int row = r0; row <= r1; ++row) {
+      double yc = row + 0.5;
+      double xl = 1e30;
+      double xr = -1e30;
+      for (std::size_t i = 0; i < p.size(); ++i) {
+        const Point& a = p[i];
+        const Point& b = p[(i + 1) % p.size()];
+        if ((a[1] <= yc && yc < b[1]) || (b[1] <= yc && yc < a[1])) {
+          double x = a[0] + (yc - a[1]) * (b[0] - a[0]) / (b[1] - a[1]);
+          xl = std::min(xl, x);
+          xr = std::max(xr, x);
+        }
+      }
+      if (xl <= xr) {
+        Span(row, xl, xr, c);
+      }
+    }
+  }
+
+  void FillRect(double l, double b, double r, double t, Color c) {
+    FillPolygon({{l, b}, {l, t}, {r, t}, {r, b}}, c);
+  }
+
+  void FillCircle(double x, double y, double radius, Color c) {
+    Point center = ToImage({x, y});
+    double rx = std::max(0.5, radius * sx_);
+    double ry = std::max(0.5, radius * sy_);
+    int r0 = std::max(0, static_cast<int>(std::floor(center[1] - ry)));
+    int r1 = std::min(height_ - 1, static_cast<int>(std::ceil(center[1] + ry)));
+    for (int row = r0; row <= r1; ++row) {
+      double dy = (row + 0.5 - center[1]) / ry;
+      if (std::abs(dy) <= 1) {
+        double half = rx * std::sqrt(1 - dy * dy);
+        Span(row, center[0] - half, center[0] + half, c);
+      }
+    }
+  }
+
+  // segment from a to b of the given width, in scene units
+  void Line(const Point& a, const Point& b, double width, Color c) {
+    Point pa = ToImage(a);
+    Point pb = ToImage(b);
+    double dx = pb[0] - pa[0];
+    double dy = pb[1] - pa[1];
+    double len = std::hypot(dx, dy);
+    if (len == 0) {
+      return;
+    }
+    double half = std::max(0.5, 0.5 * width * std::sqrt(sx_ * sy_));
+    // the image normal (-dy, dx) back in the scene, where y is flipped
+    double nx = -dy / len * half / sx_;
+    double ny = -dx / len * half / sy_;
+    FillPolygon({{a[0] + nx, a[1] + ny},
+                 {b[0] + nx, b[1] + ny},
+                 {b[0] - nx, b[1] - ny},
+                 {a[0] - nx, a[1] - ny}},
+                c);
+  }
+
+  // corners of the rectangle [l, r] x [b, t] rotated by angle, then shifted
+  static std::vector<Point> RotatedRect(double l, double b, double r, double t,
+                                        double angle, const Point& shift) {
+    double cs = std::cos(angle);
+    double sn = std::sin(angle);
+    std::vector<Point> points;
+    for (const Point& p : {Point{l, b}, Point{l, t}, Point{r, t},
+                           Point{r, b}}) {
+      points.push_back({p[0] * cs - p[1] * sn + shift[0],
+                        p[0] * sn + p[1] * cs + shift[1]});
+    }
+    return points;
+  }
+
+ protected:
+  [[nodiscard]] Point ToImage(const Point& p) const {
+    return {p[0] * sx_, (scene_height_ - p[1]) * sy_};
+  }
+
+  // fill the pixels of row whose centers are in [xl, xr], or the nearest one
+  void Span(int row, double xl, double xr, Color c) {
+    int x0 = static_cast<int>(std::ceil(xl - 0.5));
+    int x1 = static_cast<int>(std::floor(xr - 0.5));
+    if (x0 > x1) {
+      x0 = x1 = static_cast<int>(std::floor(0.5 * (xl + xr)));
+    }
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width_ - 1);
+    if (x0 > x1) {
+      return;
+    }
+    std::size_t offset = static_cast<std::size_t>(row) * width_ + x0;
+    std::size_t n = x1 - x0 + 1;
+    std::memset(rgb_ + offset, c.r, n);
+    std::memset(rgb_ + plane_ + offset, c.g, n);
+    std::memset(rgb_ + 2 * plane_ + offset, c.b, n);
+  }
+};
+
+/**
+ * EnvFns of the obs_type="pixels" variant of a classic_control env: "obs" is
+ * the [3, img_height, img_width] image of the gym scene, and the original
+ * state observation moves to "info:state_obs".
+ */
+template <typename EnvFns>
+class PixelEnvFns {
+ public:
+  static decltype(auto) DefaultConfig() {
+    return ConcatDict(EnvFns::DefaultConfig(),
+                      MakeDict("img_height"_.Bind(84), "img_width"_.Bind(84)));
+  }
+  template <typename Config>
+  static decltype(auto) StateSpec(const Config& conf) {
+    auto state_obs = EnvFns::StateSpec(conf)["obs"_];
+    Spec<uint8_t> image({3, conf["img_height"_], conf["img_width"_]}, {0, 255});
+    return MakeDict("obs"_.Bind(image), "info:state_obs"_.Bind(state_obs));
+  }
+  template <typename Config>
+  static decltype(auto) ActionSpec(const Config& conf) {
+    return EnvFns::ActionSpec(conf);
+  }
+};
+
+template <typename Spec>
+struct IsPixelObs : std::false_type {};
+
+template <typename EnvFns>
+struct IsPixelObs<EnvSpec<PixelEnvFns<EnvFns>>> : std::true_type {};
+
+// the state observation, "obs" or "info:state_obs" of the pixel variant
+template <typename EnvSpec, typename State>
+Array& StateObs(State* state) {
+  if constexpr (IsPixelObs<EnvSpec>::value) {
+    return (*state)["info:state_obs"_];
+  } else {
+    return (*state)["obs"_];
+  }
+}
+
+}  // namespace classic_control
+
+#endif  // ENVPOOL_CLASSIC_CONTROL_PIXEL_OBS_H_
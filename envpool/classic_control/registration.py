@@ -21,6 +21,13 @@ register(
   spec_cls="CartPoleEnvSpec",
   dm_cls="CartPoleDMEnvPool",
   gym_cls="CartPoleGymEnvPool",
+  obs_types={
+    "pixels": (
+      "CartPolePixelEnvSpec",
+      "CartPolePixelDMEnvPool",
+      "CartPolePixelGymEnvPool",
+    )
+  },
   max_episode_steps=200,
   reward_threshold=195.0,
 )
@@ -31,6 +38,13 @@ register(
   spec_cls="CartPoleEnvSpec",
   dm_cls="CartPoleDMEnvPool",
   gym_cls="CartPoleGymEnvPool",
+  obs_types={
+    "pixels": (
+      "CartPolePixelEnvSpec",
+      "CartPolePixelDMEnvPool",
+      "CartPolePixelGymEnvPool",
+    )
+  },
   max_episode_steps=500,
   reward_threshold=475.0,
 )
@@ -41,6 +55,13 @@ register(
   spec_cls="PendulumEnvSpec",
   dm_cls="PendulumDMEnvPool",
   gym_cls="PendulumGymEnvPool",
+  obs_types={
+    "pixels": (
+      "PendulumPixelEnvSpec",
+      "PendulumPixelDMEnvPool",
+      "PendulumPixelGymEnvPool",
+    )
+  },
   version=0,
   max_episode_steps=200,
 )
@@ -51,6 +72,13 @@ register(
   spec_cls="PendulumEnvSpec",
   dm_cls="PendulumDMEnvPool",
   gym_cls="PendulumGymEnvPool",
+  obs_types={
+    "pixels": (
+      "PendulumPixelEnvSpec",
+      "PendulumPixelDMEnvPool",
+      "PendulumPixelGymEnvPool",
+    )
+  },
   version=1,
   max_episode_steps=200,
 )
@@ -61,6 +89,13 @@ register(
   spec_cls="MountainCarEnvSpec",
   dm_cls="MountainCarDMEnvPool",
   gym_cls="MountainCarGymEnvPool",
+  obs_types={
+    "pixels": (
+      "MountainCarPixelEnvSpec",
+      "MountainCarPixelDMEnvPool",
+      "MountainCarPixelGymEnvPool",
+    )
+  },
   max_episode_steps=200,
 )
 
@@ -70,6 +105,13 @@ register(
   spec_cls="MountainCarContinuousEnvSpec",
   dm_cls="MountainCarContinuousDMEnvPool",
   gym_cls="MountainCarContinuousGymEnvPool",
+  obs_types={
+    "pixels": (
+      "MountainCarContinuousPixelEnvSpec",
+      "MountainCarContinuousPixelDMEnvPool",
+      "MountainCarContinuousPixelGymEnvPool",
+    )
+  },
   max_episode_steps=999,
 )
 
@@ -79,5 +121,12 @@ register(
   spec_cls="AcrobotEnvSpec",
   dm_cls="AcrobotDMEnvPool",
   gym_cls="AcrobotGymEnvPool",
+  obs_types={
+    "pixels": (
+      "AcrobotPixelEnvSpec",
+      "AcrobotPixelDMEnvPool",
+      "AcrobotPixelGymEnvPool",
+    )
+  },
   max_episode_steps=500,
 )
@@ -21,6 +21,7 @@
 #define MOODYCAMEL_DELETE_FUNCTION = delete
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <utility>
@@ -31,6 +32,11 @@
 
 /**
  * Lock-free action buffer queue.
+ *
+ * Actions are split into priority lanes by the env_id of each action slice.
+ * Workers always drain the lane with the highest priority first. To avoid
+ * starvation, a non-empty lane which has been skipped for more than
+ * `max_skip` consecutive dequeues is served next.
  */
 class ActionBufferQueue {
  public:
@@ -39,30 +45,70 @@ class ActionBufferQueue {
     int order;
     bool force_reset;
   };
+  static constexpr std::size_t kMaxSkip = 16;
 
  protected:
-  std::atomic<uint64_t> alloc_ptr_, done_ptr_;
+  struct Lane {
+    std::atomic<uint64_t> alloc_ptr{0}, done_ptr{0};
+    std::vector<ActionSlice> queue;
+    std::size_t skipped{0};
+
+    [[nodiscard]] uint64_t Pending() const {
+      // load done_ptr first, which never passes alloc_ptr
+      uint64_t done = done_ptr;
+      return alloc_ptr - done;
+    }
+  };
+
   std::size_t queue_size_;
-  std::vector<ActionSlice> queue_;
+  std::vector<int> env_lane_;
+  std::vector<Lane> lanes_;
+  std::size_t max_skip_;
   moodycamel::LightweightSemaphore sem_, sem_enqueue_, sem_dequeue_;
 
  public:
-  explicit ActionBufferQueue(std::size_t num_envs)
-      : alloc_ptr_(0),
-        done_ptr_(0),
-        queue_size_(num_envs * 2),
-        queue_(queue_size_),
+  /**
+   * env_lane[env_id] is the priority lane of each env, the larger the higher
+   * priority. An empty env_lane puts all envs into a single lane.
+   */
+  explicit ActionBufferQueue(std::size_t num_envs,
+                             std::vector<int> env_lane = {},
+                             std::size_t max_skip = kMaxSkip)
+      : queue_size_(num_envs * 2),
+        env_lane_(std::move(env_lane)),
+        lanes_(env_lane_.empty()
+                   ? 1
+                   : *std::max_element(env_lane_.begin(), env_lane_.end()) +
+                         1),
+        max_skip_(max_skip),
         sem_(0),
         sem_enqueue_(1),
-        sem_dequeue_(1) {}
+        sem_dequeue_(1) {
+    for (auto& lane : lanes_) {
+      lane.queue.resize(queue_size_);
+    }
+  }
 
   void EnqueueBulk(const std::vector<ActionSlice>& action) {
     // ensure only one enqueue_bulk happens at any time
     while (!sem_enqueue_.wait()) {
     }
-    uint64_t pos = alloc_ptr_.fetch_add(action.size());
-    for (std::size_t i = 0; i < action.size(); ++i) {
-      queue_[(pos + i) % queue_size_] = action[i];
+    // publish the slices only after they are written, so that a dequeuer
+    // never observes a pending but unwritten slice in any lane
+    if (lanes_.size() == 1) {
+      Lane& lane = lanes_[0];
+      uint64_t pos = lane.alloc_ptr;
+      for (std::size_t i = 0; i < action.size(); ++i) {
+        lane.queue[(pos + i) % queue_size_] = action[i];
+      }
+      lane.alloc_ptr = pos + action.size();
+    } else {
+      for (const auto& a : action) {
+        Lane& lane = lanes_[LaneOf(a.env_id)];
+        uint64_t pos = lane.alloc_ptr;
+        lane.queue[pos % queue_size_] = a;
+        lane.alloc_ptr = pos + 1;
+      }
     }
     sem_.signal(action.size());
     sem_enqueue_.signal(1);
@@ -73,14 +119,82 @@ class ActionBufferQueue {
     }
     while (!sem_dequeue_.wait()) {
     }
-    auto ptr = done_ptr_.fetch_add(1);
-    auto ret = queue_[ptr % queue_size_];
+    Lane& lane = lanes_[PickLane()];
+    auto ptr = lane.done_ptr.fetch_add(1);
+    auto ret = lane.queue[ptr % queue_size_];
     sem_dequeue_.signal(1);
     return ret;
   }
 
-  std::size_t SizeApprox() {
-    return static_cast<std::size_t>(alloc_ptr_ - done_ptr_);
+  /**
+   * Dequeue up to max_num slices into out, blocking until at least one is
+   * available, and return the number of slices dequeued. With a single lane
+   * the whole block is claimed with one atomic operation; with priority lanes
+   * each slice still goes through PickLane.
+   */
+  std::size_t DequeueBulk(std::size_t max_num, std::vector<ActionSlice>* out) {
+    std::size_t num;
+    while ((num = sem_.waitMany(max_num)) == 0) {
+    }
+    out->resize(num);
+    if (lanes_.size() == 1) {
+      // the tokens of sem_ already reserve num published slices
+      Lane& lane = lanes_[0];
+      auto ptr = lane.done_ptr.fetch_add(num);
+      for (std::size_t i = 0; i < num; ++i) {
+        (*out)[i] = lane.queue[(ptr + i) % queue_size_];
+      }
+      return num;
+    }
+    while (!sem_dequeue_.wait()) {
+    }
+    for (std::size_t i = 0; i < num; ++i) {
+      Lane& lane = lanes_[PickLane()];
+      auto ptr = lane.done_ptr.fetch_add(1);
+      (*out)[i] = lane.queue[ptr % queue_size_];
+    }
+    sem_dequeue_.signal(1);
+    return num;
+  }
+
+  [[nodiscard]] std::size_t SizeApprox() const {
+    std::size_t size = 0;
+    for (const auto& lane : lanes_) {
+      size += static_cast<std::size_t>(lane.Pending());
+    }
+    return size;
+  }
+
+  [[nodiscard]] std::size_t NumLanes() const { return lanes_.size(); }
+
+  [[nodiscard]] int LaneOf(int env_id) const {
+    return env_lane_.empty() ? 0 : env_lane_[env_id];
+  }
+
+ protected:
+  /**
+   * Choose the lane to dequeue from, called with sem_dequeue_ held. Holding a
+   * token of sem_ guarantees that at least one lane is non-empty.
+   */
+  std::size_t PickLane() {
+    if (lanes_.size() == 1) {
+      return 0;
+    }
+    std::size_t pick = lanes_.size();
+    for (std::size_t l = lanes_.size(); l-- > 0;) {
+      if (lanes_[l].Pending() == 0) {
+        continue;
+      }
+      if (pick == lanes_.size()) {
+        pick = l;
+      } else if (++lanes_[l].skipped > max_skip_) {
+        pick = l;
+        break;
+      }
+    }
+    DCHECK_LT(pick, lanes_.size());
+    lanes_[pick].skipped = 0;
+    return pick;
   }
 };
 
@@ -19,8 +19,10 @@
 
 #include <queue>
 #include <random>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "ThreadPool.h"
 #include "envpool/core/dict.h"
@@ -71,3 +73,105 @@ TEST(ActionBufferQueueTest, Concurrent) {
   send.join();
   EXPECT_EQ(queue.SizeApprox(), num_envs);
 }
+
+TEST(ActionBufferQueueTest, PriorityLane) {
+  std::size_t num_envs = 8;
+  // env 6 and 7 have higher priority
+  std::vector<int> env_lane({0, 0, 0, 0, 0, 0, 1, 1});
+  std::size_t max_skip = 3;
+  ActionBufferQueue queue(num_envs, env_lane, max_skip);
+  EXPECT_EQ(queue.NumLanes(), 2);
+  std::vector<ActionSlice> actions;
+  for (std::size_t i = 0; i < num_envs; ++i) {
+    actions.push_back(ActionSlice{
+        .env_id = static_cast<int>(i), .order = -1, .force_reset = false});
+  }
+  queue.EnqueueBulk(actions);
+  EXPECT_EQ(queue.SizeApprox(), num_envs);
+  // high priority lane is drained first, in fifo order
+  EXPECT_EQ(queue.Dequeue().env_id, 6);
+  EXPECT_EQ(queue.Dequeue().env_id, 7);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(queue.Dequeue().env_id, i);
+  }
+  EXPECT_EQ(queue.SizeApprox(), 0);
+  // starvation protection: keep the high lane busy, the low lane is still
+  // served once every max_skip + 1 dequeues
+  actions.clear();
+  for (int i = 0; i < 6; ++i) {
+    actions.push_back(
+        ActionSlice{.env_id = i, .order = -1, .force_reset = false});
+  }
+  queue.EnqueueBulk(actions);
+  std::vector<int> low_pos;
+  for (int t = 0; t < 20; ++t) {
+    queue.EnqueueBulk({ActionSlice{
+        .env_id = 6 + t % 2, .order = -1, .force_reset = false}});
+    if (queue.Dequeue().env_id < 6) {
+      low_pos.push_back(t);
+    }
+  }
+  EXPECT_EQ(low_pos, std::vector<int>({3, 7, 11, 15, 19}));
+}
+
+TEST(ActionBufferQueueTest, DequeueBulk) {
+  std::size_t num_envs = 8;
+  ActionBufferQueue queue(num_envs);
+  std::vector<ActionSlice> actions;
+  for (std::size_t i = 0; i < num_envs; ++i) {
+    actions.push_back(ActionSlice{
+        .env_id = static_cast<int>(i), .order = -1, .force_reset = false});
+  }
+  queue.EnqueueBulk(actions);
+  std::vector<ActionSlice> chunk;
+  // a block is claimed in fifo order, and never exceeds what is pending
+  EXPECT_EQ(queue.DequeueBulk(3, &chunk), 3);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(chunk[i].env_id, i);
+  }
+  EXPECT_EQ(queue.Dequeue().env_id, 3);
+  EXPECT_EQ(queue.DequeueBulk(16, &chunk), 4);
+  EXPECT_EQ(chunk.size(), 4);
+  EXPECT_EQ(chunk.back().env_id, 7);
+  EXPECT_EQ(queue.SizeApprox(), 0);
+  // concurrent workers see every slice exactly once
+  std::size_t total = 100000;
+  std::vector<std::atomic<int>> seen(num_envs);
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> count(0);
+  std::atomic<int> running(4);
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([&] {
+      std::vector<ActionSlice> c;
+      while (count < total) {
+        queue.DequeueBulk(1 + std::rand() % 8, &c);
+        for (const auto& a : c) {
+          if (a.env_id >= 0) {
+            ++seen[a.env_id];
+            ++count;
+          }
+        }
+      }
+      --running;
+    });
+  }
+  for (std::size_t sent = 0; sent < total; sent += num_envs) {
+    while (queue.SizeApprox() > num_envs) {
+    }
+    queue.EnqueueBulk(actions);
+  }
+  // wake up the workers blocked in DequeueBulk
+  while (running > 0) {
+    if (queue.SizeApprox() == 0) {
+      queue.EnqueueBulk(
+          {ActionSlice{.env_id = -1, .order = -1, .force_reset = false}});
+    }
+    std::this_thread::yield();
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  for (std::size_t i = 0; i < num_envs; ++i) {
+    EXPECT_EQ(seen[i], total / num_envs);
+  }
+}
@@ -19,8 +19,18 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -28,8 +38,40 @@
 #include "envpool/core/action_buffer_queue.h"
 #include "envpool/core/array.h"
 #include "envpool/core/envpool.h"
+#include "envpool/core/rate_limiter.h"
 #include "envpool/core/spec.h"
 #include "envpool/core/state_buffer_queue.h"
+
+/**
+ * Whether an env can continue the episode of another env of the same type,
+ * see `AsyncEnvPool::Branch`.
+ */
+template <typename Env>
+using CopyStateFromT = decltype(std::declval<Env&>().CopyStateFrom(
+    std::declval<const Env&>()));
+
+template <typename Env, typename = void>
+struct HasCopyStateFrom : std::false_type {};
+
+template <typename Env>
+struct HasCopyStateFrom<Env, std::void_t<CopyStateFromT<Env>>>
+    : std::true_type {};
+
+/**
+ * Whether an env computes the Jacobians of its dynamics, see
+ * `AsyncEnvPool::Jacobians`.
+ */
+template <typename Env>
+using TransitionJacobianT = decltype(std::declval<Env&>().TransitionJacobian(
+    0.0, false, std::declval<double*>(), std::declval<double*>()));
+
+template <typename Env, typename = void>
+struct HasTransitionJacobian : std::false_type {};
+
+template <typename Env>
+struct HasTransitionJacobian<Env, std::void_t<TransitionJacobianT<Env>>>
+    : std::true_type {};
+
 /**
  * Async EnvPool
  *
@@ -44,22 +86,77 @@ class AsyncEnvPool : public EnvPool<typename Env::Spec> {
   std::size_t num_envs_;
   std::size_t batch_;
   std::size_t max_num_players_;
-  std::size_t num_threads_;
+  // resized by SetNumThreads while Branch / Jacobians may read it
+  std::atomic<std::size_t> num_threads_;
+  // workers [0, active_threads_) dequeue actions, the rest are parked; in
+  // elastic mode active_threads_ floats in [1, num_threads_]
+  std::atomic<std::size_t> active_threads_;
+  bool elastic_threads_;
+  int thread_affinity_offset_;
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+  // in elastic mode, the largest number of queued actions seen since the
+  // last park decision, and when that decision was made; under park_mutex_
+  std::size_t peak_backlog_;
+  std::chrono::steady_clock::time_point last_park_;
+  // upper bound of the number of envs a worker claims per dequeue, derived
+  // from batch_ / num_threads_ unless set in the config
+  std::atomic<std::size_t> max_chunk_size_;
+  bool auto_chunk_size_;
   bool is_sync_;
+  // deterministic async mode: each batch is made of the batch_ envs in flight
+  // with the smallest (number of steps sent to the env, env_id), instead of
+  // the first batch_ envs to finish
+  bool deterministic_;
+  std::vector<uint64_t> logical_step_;
+  std::set<std::pair<uint64_t, int>> pending_;
+  // single-env states which finished before their turn
+  std::vector<std::vector<Array>> early_state_;
   std::atomic<int> stop_;
   std::atomic<std::size_t> stepping_env_num_;
   std::vector<std::thread> workers_;
   std::unique_ptr<ActionBufferQueue> action_buffer_queue_;
   std::unique_ptr<StateBufferQueue> state_buffer_queue_;
   std::vector<std::unique_ptr<Env>> envs_;
+  // number of pending steps of each env, from Send / Reset until its state
+  // is written
   std::vector<std::atomic<int>> stepping_env_;
   std::chrono::duration<double> dur_send_, dur_recv_, dur_send_all_;
+  // per-lane step latency from send to the state being written, only
+  // recorded when there is more than one priority lane
+  struct LaneStat {
+    std::atomic<uint64_t> count{0}, total_ns{0}, max_ns{0};
+  };
+  bool record_latency_;
+  std::vector<std::chrono::steady_clock::time_point> send_time_;
+  std::vector<LaneStat> lane_stat_;
+  // token buckets of env steps and of worker busy time in ns, null when
+  // max_fps / cpu_quota is not set
+  std::unique_ptr<RateLimiter> step_limiter_, cpu_limiter_;
+  std::chrono::steady_clock::time_point start_time_;
+  // threads of Branch and Jacobians besides the caller, see `RunAux`
+  std::mutex aux_mutex_;
+  std::unique_ptr<ThreadPool> aux_pool_;
+  // scratch envs of Branch and the state buffers they write
+  std::vector<std::unique_ptr<Env>> scratch_envs_;
+  std::unique_ptr<StateBufferQueue> branch_sbq_;
+  int branch_rows_;
 
  public:
   using Spec = typename Env::Spec;
   using Action = typename Env::Action;
   using State = typename Env::State;
   using ActionSlice = typename ActionBufferQueue::ActionSlice;
+  // a chunk of cheap envs is sized to take about this long to step
+  static constexpr double kChunkTargetNs = 2000;
+  static constexpr std::size_t kMaxChunkSize = 32;
+  // in elastic mode, a worker which waits this long for an action asks to
+  // park one worker, which happens at most once per kParkInterval and only
+  // if the backlog in that interval never needed all active workers
+  static constexpr std::chrono::milliseconds kIdleTime{20};
+  static constexpr std::chrono::milliseconds kParkInterval{100};
+  // the limiters tolerate bursts of this many seconds of quota
+  static constexpr double kBurstTime = 0.01;
 
   explicit AsyncEnvPool(const Spec& spec)
       : EnvPool<Spec>(spec),
@@ -68,15 +165,45 @@ class AsyncEnvPool : public EnvPool<typename Env::Spec> {
                                                : spec.config["batch_size"_]),
         max_num_players_(spec.config["max_num_players"_]),
         num_threads_(spec.config["num_threads"_]),
+        active_threads_(0),
+        elastic_threads_(spec.config["elastic_threads"_]),
+        thread_affinity_offset_(spec.config["thread_affinity_offset"_]),
+        peak_backlog_(0),
+        last_park_(std::chrono::steady_clock::now()),
+        max_chunk_size_(spec.config["max_chunk_size"_]),
+        auto_chunk_size_(spec.config["max_chunk_size"_] == 0),
         is_sync_(batch_ == num_envs_ && max_num_players_ == 1),
+        deterministic_(spec.config["deterministic_async"_] && !is_sync_),
+        logical_step_(deterministic_ ? num_envs_ : 0),
+        early_state_(deterministic_ ? num_envs_ : 0),
         stop_(0),
         stepping_env_num_(0),
-        action_buffer_queue_(new ActionBufferQueue(num_envs_)),
+        action_buffer_queue_(
+            new ActionBufferQueue(num_envs_, spec.config["env_priority"_])),
+        // in deterministic mode, every state is received on its own and
+        // batches are assembled in Recv
         state_buffer_queue_(new StateBufferQueue(
-            batch_, num_envs_, max_num_players_,
+            deterministic_ ? 1 : batch_, num_envs_, max_num_players_,
             spec.state_spec.template AllValues<ShapeSpec>())),
-        envs_(num_envs_) {
+        envs_(num_envs_),
+        stepping_env_(num_envs_),
+        record_latency_(action_buffer_queue_->NumLanes() > 1),
+        send_time_(num_envs_),
+        lane_stat_(action_buffer_queue_->NumLanes()),
+        start_time_(std::chrono::steady_clock::now()),
+        branch_rows_(0) {
     std::size_t processor_count = std::thread::hardware_concurrency();
+    double max_fps = spec.config["max_fps"_];
+    double cpu_quota = spec.config["cpu_quota"_];
+    if (max_fps > 0) {
+      step_limiter_ =
+          std::make_unique<RateLimiter>(max_fps, max_fps * kBurstTime);
+    }
+    if (cpu_quota > 0) {
+      // one token is one ns of cpu time
+      cpu_limiter_ = std::make_unique<RateLimiter>(
+          cpu_quota * 1e9, cpu_quota * 1e9 * kBurstTime);
+    }
     ThreadPool init_pool(std::min(processor_count, num_envs_));
     std::vector<std::future<void>> result;
     for (std::size_t i = 0; i < num_envs_; ++i) {
@@ -86,39 +213,37 @@ class AsyncEnvPool : public EnvPool<typename Env::Spec> {
     for (auto& f : result) {
       f.get();
     }
+    for (std::size_t i = 0; i < num_envs_; ++i) {
+      envs_[i]->SetInFlightCounter(&stepping_env_[i]);
+    }
     if (num_threads_ == 0) {
       num_threads_ = std::min(batch_, processor_count);
+      if (cpu_quota > 0) {
+        // no more threads than the cores we are allowed to use
+        num_threads_ = std::min(num_threads_.load(),
+                                static_cast<std::size_t>(std::ceil(cpu_quota)));
+      }
     }
-    for (std::size_t i = 0; i < num_threads_; ++i) {
-      workers_.emplace_back([this] {
-        for (;;) {
-          ActionSlice raw_action = action_buffer_queue_->Dequeue();
-          if (stop_ == 1) {
-            break;
-          }
-          int env_id = raw_action.env_id;
-          int order = raw_action.order;
-          bool reset = raw_action.force_reset || envs_[env_id]->IsDone();
-          envs_[env_id]->EnvStep(state_buffer_queue_.get(), order, reset);
-        }
-      });
+    if (auto_chunk_size_) {
+      max_chunk_size_ = DefaultChunkSize(num_threads_);
     }
-    if (spec.config["thread_affinity_offset"_] >= 0) {
-      std::size_t thread_affinity_offset =
-          spec.config["thread_affinity_offset"_];
-      for (std::size_t tid = 0; tid < num_threads_; ++tid) {
-        cpu_set_t cpuset;
-        CPU_ZERO(&cpuset);
-        std::size_t cid = (thread_affinity_offset + tid) % processor_count;
-        CPU_SET(cid, &cpuset);
-        pthread_setaffinity_np(workers_[tid].native_handle(), sizeof(cpu_set_t),
-                               &cpuset);
-      }
+    active_threads_ = num_threads_.load();
+    for (std::size_t tid = 0; tid < num_threads_; ++tid) {
+      StartWorker(tid);
     }
   }
 
   ~AsyncEnvPool() {
-    stop_ = 1;
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      stop_ = 1;
+    }
+    park_cv_.notify_all();
+    for (auto* limiter : {step_limiter_.get(), cpu_limiter_.get()}) {
+      if (limiter != nullptr) {
+        limiter->Cancel();
+      }
+    }
     // LOG(INFO) << "envpool send: " << dur_send_.count();
     // LOG(INFO) << "envpool recv: " << dur_recv_.count();
     // send n actions to clear threadpool
@@ -138,32 +263,66 @@ class AsyncEnvPool : public EnvPool<typename Env::Spec> {
     for (int i = 0; i < shared_offset; ++i) {
       int eid = env_id[i];
       envs_[eid]->SetAction(action_batch, i);
+      stepping_env_[eid].fetch_add(1);
+      if (deterministic_) {
+        pending_.emplace(logical_step_[eid]++, eid);
+      }
       actions.emplace_back(ActionSlice{
           .env_id = eid,
           .order = is_sync_ ? i : -1,
           .force_reset = false,
       });
     }
-    if (is_sync_) {
-      stepping_env_num_ += shared_offset;
+    stepping_env_num_ += shared_offset;
+    if (record_latency_) {
+      MarkSendTime(actions);
     }
     // add to abq
     auto start = std::chrono::system_clock::now();
     action_buffer_queue_->EnqueueBulk(actions);
     dur_send_ += std::chrono::system_clock::now() - start;
+    WakeForBacklog(shared_offset);
+  }
+
+  /**
+   * Send with a per-env user payload, e.g. the hidden state of a recurrent
+   * policy: row i of user_state, of shape (n, user_state_size), is returned
+   * as "info:user_state" with the next state of env env_id[i], in the batch
+   * order of Recv. The payload is zeroed when an episode starts.
+   */
+  void Send(const std::vector<Array>& action, const Array& user_state) {
+    std::size_t user_state_size = this->spec.config["user_state_size"_];
+    std::size_t n = action[0].Shape(0);
+    if (user_state.size != n * user_state_size) {
+      throw std::invalid_argument(
+          "It is required that user_state has shape (" + std::to_string(n) +
+          ", " + std::to_string(user_state_size) + "), got " +
+          std::to_string(user_state.size) + " elements");
+    }
+    if (user_state_size > 0) {
+      int* env_id = static_cast<int*>(action[0].Data());
+      for (std::size_t i = 0; i < n; ++i) {
+        envs_[env_id[i]]->SetUserState(user_state, i);
+      }
+    }
+    Send(action);
   }
 
   std::vector<Array> Recv() override {
+    if (deterministic_) {
+      return RecvDeterministic();
+    }
+    // with fewer than batch_size envs in flight, e.g. when some envs are no
+    // longer sent actions, the batch shrinks to the envs in flight instead of
+    // blocking forever; they all land in the buffer at the head
     int additional_wait = 0;
-    if (is_sync_ && stepping_env_num_ < batch_) {
+    if (stepping_env_num_ < batch_) {
       additional_wait = batch_ - stepping_env_num_;
     }
     auto start = std::chrono::system_clock::now();
     auto ret = state_buffer_queue_->Wait(additional_wait);
     dur_recv_ += std::chrono::system_clock::now() - start;
-    if (is_sync_) {
-      stepping_env_num_ -= ret[0].Shape(0);
-    }
+    stepping_env_num_ -= ret[0].Shape(0);
     return ret;
   }
 
@@ -174,11 +333,500 @@ class AsyncEnvPool : public EnvPool<typename Env::Spec> {
       actions[i].force_reset = true;
       actions[i].env_id = env_ids[i];
       actions[i].order = is_sync_ ? i : -1;
+      stepping_env_[actions[i].env_id].fetch_add(1);
+      if (deterministic_) {
+        pending_.emplace(logical_step_[actions[i].env_id]++,
+                         actions[i].env_id);
+      }
     }
-    if (is_sync_) {
-      stepping_env_num_ += shared_offset;
+    stepping_env_num_ += shared_offset;
+    if (record_latency_) {
+      MarkSendTime(actions);
     }
     action_buffer_queue_->EnqueueBulk(actions);
+    WakeForBacklog(shared_offset);
+  }
+
+  /**
+   * Reset envs in env_ids, with seeds[i] as the new seed of env_ids[i].
+   */
+  void Reset(const Array& env_ids, const Array& seeds) {
+    int shared_offset = env_ids.Shape(0);
+    if (static_cast<int>(seeds.size) != shared_offset) {
+      throw std::invalid_argument(
+          "It is required that len(seeds) == len(env_ids), got len(env_ids) "
+          "= " +
+          std::to_string(shared_offset) +
+          ", len(seeds) = " + std::to_string(seeds.size));
+    }
+    for (int i = 0; i < shared_offset; ++i) {
+      int eid = env_ids[i];
+      int seed = seeds[i];
+      envs_[eid]->SetSeed(seed);
+    }
+    Reset(env_ids);
+  }
+
+  /**
+   * Roll out copies of env env_id from its current state, leaving the env
+   * itself untouched. action is laid out as in Send with num_branches *
+   * horizon rows, where row k * horizon + h is the h-th action of branch k.
+   * The branches are spread across up to num_threads scratch envs, and the
+   * states are returned in the same row order. A branch whose episode ends
+   * keeps stepping from its terminal state, mask these steps out with done.
+   *
+   * Only single-player envs which implement `CopyStateFrom` can be branched,
+   * and env_id must not be in flight.
+   */
+  std::vector<Array> Branch(int env_id, int horizon,
+                            const std::vector<Array>& action) {
+    if constexpr (!HasCopyStateFrom<Env>::value) {
+      throw std::runtime_error("This env does not support branch");
+    } else {
+      if (max_num_players_ != 1) {
+        throw std::invalid_argument("branch requires a single-player env");
+      }
+      if (env_id < 0 || env_id >= static_cast<int>(num_envs_)) {
+        throw std::out_of_range("env_id " + std::to_string(env_id) +
+                                " out of range");
+      }
+      if (stepping_env_[env_id] > 0) {
+        throw std::runtime_error("env " + std::to_string(env_id) +
+                                 " is in flight, recv it before branch");
+      }
+      int rows = action[0].Shape(0);
+      if (horizon <= 0 || rows == 0 || rows % horizon != 0) {
+        throw std::invalid_argument(
+            "branch requires num_branches * horizon actions, got " +
+            std::to_string(rows) + " with horizon " +
+            std::to_string(horizon));
+      }
+      std::size_t num_branches = rows / horizon;
+      std::lock_guard<std::mutex> lock(aux_mutex_);
+      std::size_t num_tasks = std::min(num_branches, num_threads_.load());
+      while (scratch_envs_.size() < num_tasks) {
+        scratch_envs_.emplace_back(
+            new Env(this->spec, num_envs_ + scratch_envs_.size()));
+      }
+      if (branch_rows_ != rows) {
+        // every branch call fills exactly one ordered state buffer
+        branch_sbq_ = std::make_unique<StateBufferQueue>(
+            rows, rows, 1,
+            this->spec.state_spec.template AllValues<ShapeSpec>());
+        branch_rows_ = rows;
+      }
+      auto action_batch = std::make_shared<std::vector<Array>>(action);
+      const Env& src = *envs_[env_id];
+      RunAux(num_tasks, [&](std::size_t s) {
+        Env* env = scratch_envs_[s].get();
+        for (std::size_t k = s; k < num_branches; k += num_tasks) {
+          env->CopyCommonState(src);
+          env->CopyStateFrom(src);
+          for (int h = 0; h < horizon; ++h) {
+            int row = static_cast<int>(k) * horizon + h;
+            env->SetAction(action_batch, row);
+            env->EnvStep(branch_sbq_.get(), row, false);
+          }
+        }
+      });
+      return branch_sbq_->Wait();
+    }
+  }
+
+  /**
+   * Finite-difference Jacobians of one step of envs env_ids, linearized
+   * around their current state and last action, as float64 arrays a of
+   * shape [n, nx, nx] and b of shape [n, nx, nu], where nx is the size of the
+   * state in the env's own layout (see its `TransitionJacobian`). The envs
+   * are spread across up to num_threads threads and must not be in flight.
+   */
+  std::pair<Array, Array> Jacobians(const Array& env_ids, double eps,
+                                    bool centered) {
+    if constexpr (!HasTransitionJacobian<Env>::value) {
+      throw std::runtime_error("This env does not support jacobians");
+    } else {
+      int n = env_ids.Shape(0);
+      std::vector<bool> seen(num_envs_);
+      for (int i = 0; i < n; ++i) {
+        int eid = env_ids[i];
+        if (eid < 0 || eid >= static_cast<int>(num_envs_) || seen[eid]) {
+          throw std::invalid_argument("invalid or duplicated env_id " +
+                                      std::to_string(eid));
+        }
+        if (stepping_env_[eid] > 0) {
+          throw std::runtime_error("env " + std::to_string(eid) +
+                                   " is in flight, recv it before jacobians");
+        }
+        seen[eid] = true;
+      }
+      auto [nx, nu] = envs_[0]->TransitionDims();
+      Array a(::Spec<double>({n, nx, nx}));
+      Array b(::Spec<double>({n, nx, nu}));
+      std::lock_guard<std::mutex> lock(aux_mutex_);
+      int num_tasks = static_cast<int>(
+          std::min(static_cast<std::size_t>(n), num_threads_.load()));
+      RunAux(num_tasks, [&](std::size_t s) {
+        for (int i = static_cast<int>(s); i < n; i += num_tasks) {
+          int eid = env_ids[i];
+          envs_[eid]->TransitionJacobian(eps, centered,
+                                         static_cast<double*>(a[i].Data()),
+                                         static_cast<double*>(b[i].Data()));
+        }
+      });
+      return {std::move(a), std::move(b)};
+    }
+  }
+
+  /**
+   * Resize the worker pool of a live EnvPool. Workers beyond num_threads are
+   * parked after their current chunk, and new workers are started if needed.
+   * In elastic mode, num_threads is the upper bound of active workers. The
+   * chunk size follows the new number of workers unless max_chunk_size is
+   * set in the config.
+   */
+  void SetNumThreads(std::size_t num_threads) {
+    if (num_threads == 0) {
+      throw std::invalid_argument("num_threads should be positive");
+    }
+    while (workers_.size() < num_threads) {
+      StartWorker(workers_.size());
+    }
+    {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      num_threads_ = num_threads;
+      if (auto_chunk_size_) {
+        max_chunk_size_ = DefaultChunkSize(num_threads);
+      }
+      active_threads_ = num_threads;
+      last_park_ = std::chrono::steady_clock::now();
+    }
+    park_cv_.notify_all();
+  }
+
+  /**
+   * Number of workers which are currently not parked.
+   */
+  [[nodiscard]] std::size_t NumActiveThreads() const {
+    return active_threads_;
+  }
+
+  /**
+   * Lock-free gauges of how far the envs are ahead of the consumer, as
+   * (action_queue, partial_state_buffers, ready_state_buffers,
+   * stock_state_buffers): the number of actions waiting for a worker, the
+   * number of state buffers partially written, the number of complete state
+   * buffers waiting for Recv, and the number of empty state buffers prepared
+   * in advance.
+   */
+  std::tuple<std::size_t, std::size_t, std::size_t, std::size_t> Gauges()
+      const {
+    auto [num_partial, num_ready] = state_buffer_queue_->Occupancy();
+    return {action_buffer_queue_->SizeApprox(), num_partial, num_ready,
+            state_buffer_queue_->NumStock()};
+  }
+
+  /**
+   * Whether each env has a step or reset in flight, i.e., sent but its state
+   * not yet written.
+   */
+  std::vector<bool> InFlight() const {
+    std::vector<bool> ret(num_envs_);
+    for (std::size_t i = 0; i < num_envs_; ++i) {
+      ret[i] = stepping_env_[i] > 0;
+    }
+    return ret;
+  }
+
+  /**
+   * Throughput counters of max_fps and cpu_quota, as (elapsed_ns, num_steps,
+   * step_throttled_ns, busy_ns, cpu_throttled_ns), where elapsed_ns is the
+   * lifetime of this EnvPool. The counters of a limit which is not set are
+   * zero.
+   */
+  std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t> ThrottleStats()
+      const {
+    uint64_t elapsed_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time_)
+            .count();
+    uint64_t num_steps = 0, step_throttled_ns = 0;
+    uint64_t busy_ns = 0, cpu_throttled_ns = 0;
+    if (step_limiter_ != nullptr) {
+      num_steps = step_limiter_->Acquired();
+      step_throttled_ns = step_limiter_->ThrottledNs();
+    }
+    if (cpu_limiter_ != nullptr) {
+      busy_ns = cpu_limiter_->Acquired();
+      cpu_throttled_ns = cpu_limiter_->ThrottledNs();
+    }
+    return {elapsed_ns, num_steps, step_throttled_ns, busy_ns,
+            cpu_throttled_ns};
+  }
+
+  /**
+   * Step latency of each priority lane, from the lowest to the highest
+   * priority, as (num_steps, total_ns, max_ns).
+   */
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> LaneStats() const {
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> ret;
+    ret.reserve(lane_stat_.size());
+    for (const auto& s : lane_stat_) {
+      ret.emplace_back(s.count.load(), s.total_ns.load(), s.max_ns.load());
+    }
+    return ret;
+  }
+
+ protected:
+  /**
+   * Run task(0), ..., task(num_tasks - 1) for Branch and Jacobians, task(0)
+   * on the calling thread, which waits anyway, and the others on the aux
+   * pool. The worker queue only carries env steps, and a slice of another
+   * kind there would be checked on every step of every worker, so the aux
+   * pool is kept apart. It is created on the first call with more than one
+   * task, and its threads sleep in between. Requires aux_mutex_.
+   */
+  template <typename Task>
+  void RunAux(std::size_t num_tasks, const Task& task) {
+    if (num_tasks > 1 && aux_pool_ == nullptr) {
+      aux_pool_ = std::make_unique<ThreadPool>(
+          std::max(num_tasks, num_threads_.load()) - 1);
+    }
+    std::vector<std::future<void>> result;
+    result.reserve(num_tasks);
+    for (std::size_t s = 1; s < num_tasks; ++s) {
+      result.emplace_back(aux_pool_->enqueue([&task, s] { task(s); }));
+    }
+    std::exception_ptr error;
+    try {
+      task(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // the tasks refer to the caller's frame, wait for all of them first
+    for (auto& f : result) {
+      try {
+        f.get();
+      } catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::vector<Array> RecvDeterministic() {
+    if (pending_.empty()) {
+      throw std::runtime_error("Recv requires at least one env in flight");
+    }
+    // as in Recv, the batch shrinks to the envs in flight
+    std::size_t batch = std::min(batch_, pending_.size());
+    auto last = std::next(pending_.begin(), batch);
+    for (auto it = pending_.begin(); it != last; ++it) {
+      while (early_state_[it->second].empty()) {
+        auto state = state_buffer_queue_->Wait();
+        int env_id = state[0][0];
+        early_state_[env_id] = std::move(state);
+      }
+    }
+    // concatenate the single-env states in (logical step, env_id) order
+    std::vector<Array> ret;
+    const auto& first = early_state_[pending_.begin()->second];
+    for (std::size_t k = 0; k < first.size(); ++k) {
+      std::size_t rows = 0;
+      for (auto it = pending_.begin(); it != last; ++it) {
+        rows += early_state_[it->second][k].Shape(0);
+      }
+      std::vector<int> shape(first[k].Shape().begin(), first[k].Shape().end());
+      shape[0] = static_cast<int>(rows);
+      Array arr(ShapeSpec(static_cast<int>(first[k].element_size), shape));
+      rows = 0;
+      for (auto it = pending_.begin(); it != last; ++it) {
+        const Array& part = early_state_[it->second][k];
+        arr.Slice(rows, rows + part.Shape(0)).Assign(part);
+        rows += part.Shape(0);
+      }
+      ret.push_back(std::move(arr));
+    }
+    for (auto it = pending_.begin(); it != last; ++it) {
+      early_state_[it->second].clear();
+    }
+    pending_.erase(pending_.begin(), last);
+    stepping_env_num_ -= batch;
+    return ret;
+  }
+
+  void StartWorker(std::size_t tid) {
+    workers_.emplace_back([this, tid] {
+      std::vector<ActionSlice> chunk;
+      // moving average of the wall time of one step, which decides how many
+      // envs to claim in the next dequeue
+      double step_ns = kChunkTargetNs;
+      for (;;) {
+        if (tid >= active_threads_ && !Park(tid)) {
+          break;
+        }
+        std::chrono::steady_clock::time_point wait_start;
+        if (elastic_threads_) {
+          wait_start = std::chrono::steady_clock::now();
+        }
+        std::size_t num =
+            action_buffer_queue_->DequeueBulk(ChunkSize(step_ns), &chunk);
+        if (stop_ == 1) {
+          if (num > 1) {
+            // give the extra stop signals back to the other workers
+            action_buffer_queue_->EnqueueBulk(
+                std::vector<ActionSlice>(num - 1));
+          }
+          break;
+        }
+        if (elastic_threads_ &&
+            std::chrono::steady_clock::now() - wait_start > kIdleTime) {
+          ParkOne();
+        }
+        if (step_limiter_ != nullptr) {
+          step_limiter_->Acquire(num);
+        }
+        if (max_chunk_size_ == 1 && cpu_limiter_ == nullptr) {
+          // ChunkSize is 1 for any step_ns here, so skip the clock. If
+          // SetNumThreads raises max_chunk_size_ later, step_ns is still
+          // kChunkTargetNs or an older measurement, which at worst keeps the
+          // chunks small until the moving average below catches up.
+          Step(chunk[0]);
+          continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        // each env still claims its own state slot in Allocate, as only the
+        // env knows its number of players once it has stepped
+        for (const auto& raw_action : chunk) {
+          Step(raw_action);
+        }
+        double ns = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+        step_ns += (ns / static_cast<double>(num) - step_ns) / 8;
+        if (cpu_limiter_ != nullptr) {
+          // pay for the busy time afterwards by sleeping, which keeps the
+          // average cpu usage of all workers under cpu_quota cores
+          cpu_limiter_->Acquire(static_cast<uint64_t>(ns));
+        }
+      }
+    });
+    if (thread_affinity_offset_ >= 0) {
+      // active workers always have the smallest tids, so they are packed on
+      // the first cores after thread_affinity_offset
+      std::size_t processor_count = std::thread::hardware_concurrency();
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      std::size_t cid = (thread_affinity_offset_ + tid) % processor_count;
+      CPU_SET(cid, &cpuset);
+      pthread_setaffinity_np(workers_[tid].native_handle(), sizeof(cpu_set_t),
+                             &cpuset);
+    }
+  }
+
+  /**
+   * Block worker tid until it is active again, return false if the pool is
+   * being destroyed.
+   */
+  bool Park(std::size_t tid) {
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    park_cv_.wait(lock, [&] { return stop_ == 1 || tid < active_threads_; });
+    return stop_ == 0;
+  }
+
+  /**
+   * In elastic mode, wake up as many parked workers as there are queued
+   * actions, n of which were just enqueued.
+   */
+  void WakeForBacklog(std::size_t n) {
+    if (!elastic_threads_) {
+      return;
+    }
+    std::size_t backlog = std::max(n, action_buffer_queue_->SizeApprox());
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    peak_backlog_ = std::max(peak_backlog_, backlog);
+    std::size_t wanted = std::min(backlog, num_threads_.load());
+    if (active_threads_ < wanted) {
+      active_threads_ = wanted;
+      park_cv_.notify_all();
+    }
+  }
+
+  /**
+   * A worker has waited for an action for a while. Retire the last active
+   * worker, which parks once it finishes its current chunk, unless one was
+   * retired less than kParkInterval ago or the backlog since then needed all
+   * active workers, e.g. a batch sent after a slow learner step.
+   */
+  void ParkOne() {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_park_ < kParkInterval) {
+      return;
+    }
+    if (active_threads_ > 1 && peak_backlog_ < active_threads_) {
+      --active_threads_;
+    }
+    peak_backlog_ = 0;
+    last_park_ = now;
+  }
+
+  void Step(const ActionSlice& raw_action) {
+    int env_id = raw_action.env_id;
+    int order = raw_action.order;
+    bool reset = raw_action.force_reset || envs_[env_id]->IsDone();
+    envs_[env_id]->EnvStep(state_buffer_queue_.get(), order, reset);
+    // stepping_env_ is already decremented by the env, see
+    // `SetInFlightCounter`
+    if (record_latency_) {
+      RecordLatency(env_id);
+    }
+  }
+
+  /**
+   * max_chunk_size_ when it is not set in the config: keep every worker busy
+   * within one batch, and leave priority lanes to pick one slice at a time.
+   */
+  [[nodiscard]] std::size_t DefaultChunkSize(std::size_t num_threads) const {
+    if (record_latency_) {
+      return 1;
+    }
+    return std::clamp(batch_ / num_threads, std::size_t(1), kMaxChunkSize);
+  }
+
+  /**
+   * Number of envs to claim in one dequeue: cheap envs are stepped in chunks
+   * to amortize the queue operation, expensive ones one at a time.
+   */
+  [[nodiscard]] std::size_t ChunkSize(double step_ns) const {
+    std::size_t max_chunk_size = max_chunk_size_;
+    if (step_ns * static_cast<double>(max_chunk_size) <= kChunkTargetNs) {
+      return max_chunk_size;
+    }
+    return std::max(std::size_t(1),
+                    static_cast<std::size_t>(kChunkTargetNs / step_ns));
+  }
+
+  void MarkSendTime(const std::vector<ActionSlice>& actions) {
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& a : actions) {
+      send_time_[a.env_id] = now;
+    }
+  }
+
+  void RecordLatency(int env_id) {
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - send_time_[env_id])
+                      .count();
+    LaneStat& s = lane_stat_[action_buffer_queue_->LaneOf(env_id)];
+    s.count.fetch_add(1);
+    s.total_ns.fetch_add(ns);
+    uint64_t max_ns = s.max_ns.load();
+    while (ns > max_ns && !s.max_ns.compare_exchange_weak(max_ns, ns)) {
+    }
   }
 };
 
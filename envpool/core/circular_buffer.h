@@ -55,6 +55,15 @@ class CircularBuffer {
     sem_get_.signal();
   }
 
+  /**
+   * Number of elements which have been put but not yet taken.
+   */
+  [[nodiscard]] std::size_t SizeApprox() const {
+    uint64_t head = head_;
+    uint64_t tail = tail_;
+    return tail > head ? tail - head : 0;
+  }
+
   V Get() {
     while (!sem_get_.wait()) {
     }
@@ -17,6 +17,9 @@
 #ifndef ENVPOOL_CORE_ENV_H_
 #define ENVPOOL_CORE_ENV_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <memory>
 #include <random>
 #include <utility>
@@ -67,6 +70,17 @@ class Env {
   std::shared_ptr<std::vector<Array>> action_batch_;
   std::vector<Array> raw_action_;
   int env_index_;
+  // observation history, see `HistoryMask`
+  int frame_stack_, history_head_;
+  std::vector<std::size_t> history_index_;
+  std::vector<Array> history_ring_, history_dst_;
+  // seed of the next reset, set by `SetSeed`
+  bool reseed_;
+  int next_seed_;
+  // user payload written into "info:user_state", set by `SetUserState`
+  std::vector<float> user_state_;
+  // steps of this env in flight, set by `SetInFlightCounter`
+  std::atomic<int>* in_flight_;
 
  public:
   using Spec = EnvSpec;
@@ -84,8 +98,23 @@ class Env {
         action_specs_(spec.action_spec.template AllValues<ShapeSpec>()),
         is_player_action_(Transform(action_specs_, [](const ShapeSpec& s) {
           return (!s.shape.empty() && s.shape[0] == -1);
-        })) {
+        })),
+        frame_stack_(spec.config["frame_stack"_]),
+        history_head_(0),
+        reseed_(false),
+        next_seed_(0),
+        user_state_(spec.config["user_state_size"_]),
+        in_flight_(nullptr) {
     slice_.done_write = [] { LOG(INFO) << "Use `Allocate` to write state."; };
+    auto mask = HistoryMask(spec.state_spec, frame_stack_);
+    auto state_specs = spec.state_spec.template AllValues<ShapeSpec>();
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+      if (mask[i]) {
+        history_index_.push_back(i);
+        history_ring_.emplace_back(state_specs[i]);
+      }
+    }
+    history_dst_.resize(history_index_.size());
   }
 
   void SetAction(std::shared_ptr<std::vector<Array>> action_batch,
@@ -94,6 +123,49 @@ class Env {
     env_index_ = env_index;
   }
 
+  /**
+   * Count the steps of this env in flight with counter, which is decremented
+   * right before each state is written, so that an env is never seen in
+   * flight once its state has been received.
+   */
+  void SetInFlightCounter(std::atomic<int>* counter) { in_flight_ = counter; }
+
+  /**
+   * Use seed for the next reset, called before the reset is enqueued. The
+   * env is reseeded in the worker thread right before `Reset`.
+   */
+  void SetSeed(int seed) {
+    next_seed_ = seed;
+    reseed_ = true;
+  }
+
+  /**
+   * Keep row env_index of user_state, which is returned with the state of
+   * the next step. Called before the step is enqueued, like `SetSeed`.
+   */
+  void SetUserState(const Array& user_state, int env_index) {
+    std::memcpy(user_state_.data(), user_state[env_index].Data(),
+                user_state_.size() * sizeof(float));
+  }
+
+  /**
+   * Continue the episode of `other`, an env of the same spec: copy its id,
+   * step counter, RNG, observation history and user payload. The simulator
+   * state is copied by `CopyStateFrom` of the envs which support
+   * `AsyncEnvPool::Branch`.
+   */
+  void CopyCommonState(const Env& other) {
+    env_id_ = other.env_id_;
+    seed_ = other.seed_;
+    gen_ = other.gen_;
+    current_step_ = other.current_step_;
+    for (std::size_t j = 0; j < history_ring_.size(); ++j) {
+      history_ring_[j].Assign(other.history_ring_[j]);
+    }
+    history_head_ = other.history_head_;
+    user_state_ = other.user_state_;
+  }
+
   void ParseAction() {
     raw_action_.clear();
     std::size_t action_size = action_batch_->size();
@@ -147,6 +219,12 @@ class Env {
   void EnvStep(StateBufferQueue* sbq, int order, bool reset) {
     PreProcess(sbq, order, reset);
     if (reset) {
+      if (reseed_) {
+        reseed_ = false;
+        seed_ = next_seed_;
+        gen_.seed(seed_);
+        Seed(seed_);
+      }
       Reset();
     } else {
       ParseAction();
@@ -160,6 +238,11 @@ class Env {
     throw std::runtime_error("step not implemented");
   }
   virtual bool IsDone() { throw std::runtime_error("is_done not implemented"); }
+  /**
+   * Reseed simulator-level RNGs when the env is reset with a new seed;
+   * `seed_` and `gen_` are already reseeded at this point.
+   */
+  virtual void Seed(int seed) {}
 
  protected:
   void PreProcess(StateBufferQueue* sbq, int order, bool reset) {
@@ -167,16 +250,51 @@ class Env {
     order_ = order;
     if (reset) {
       current_step_ = 0;
+      // a new episode starts from a zero payload
+      std::fill(user_state_.begin(), user_state_.end(), 0.0F);
     } else {
       ++current_step_;
     }
   }
 
   void PostProcess() {
+    if (!history_index_.empty()) {
+      WriteHistory();
+    }
+    if (in_flight_ != nullptr) {
+      in_flight_->fetch_sub(1);
+    }
     slice_.done_write();
     // action_batch_.reset();
   }
 
+  /**
+   * The env has written its newest frame into the ring slot at history_head_.
+   * Copy the ring into the state buffer from the oldest to the newest frame,
+   * which is at most two contiguous copies per key. After reset, the first
+   * frame is repeated over the whole history.
+   */
+  void WriteHistory() {
+    for (std::size_t j = 0; j < history_index_.size(); ++j) {
+      const Array& ring = history_ring_[j];
+      std::size_t frame_bytes = ring.size / frame_stack_ * ring.element_size;
+      char* src = static_cast<char*>(ring.Data());
+      char* newest = src + history_head_ * frame_bytes;
+      if (current_step_ == 0) {
+        for (int i = 0; i < frame_stack_; ++i) {
+          if (i != history_head_) {
+            std::memcpy(src + i * frame_bytes, newest, frame_bytes);
+          }
+        }
+      }
+      char* dst = static_cast<char*>(history_dst_[j].Data());
+      std::size_t tail = (frame_stack_ - history_head_ - 1) * frame_bytes;
+      std::memcpy(dst, newest + frame_bytes, tail);
+      std::memcpy(dst + tail, src, (history_head_ + 1) * frame_bytes);
+    }
+    history_head_ = (history_head_ + 1) % frame_stack_;
+  }
+
   State Allocate(int player_num = 1) {
     slice_ = sbq_->Allocate(player_num, order_);
     State state(&slice_.arr);
@@ -195,6 +313,9 @@ class Env {
     for (int i = 0; i < player_num; ++i) {
       player_env_id[i] = env_id_;
     }
+    if (!user_state_.empty()) {
+      state["info:user_state"_].Assign(user_state_.data(), user_state_.size());
+    }
     // Inplace initialize all container fields
     int i = 0;
     std::apply(
@@ -202,6 +323,12 @@ class Env {
           (InplaceInitialize(spec, &slice_.arr[i++]), ...);
         },
         spec_.state_spec.AllValues());
+    // Let the env write the newest observation into the history ring
+    for (std::size_t j = 0; j < history_index_.size(); ++j) {
+      Array& arr = slice_.arr[history_index_[j]];
+      history_dst_[j] = std::move(arr);
+      arr = history_ring_[j][history_head_];
+    }
     return state;
   }
 };
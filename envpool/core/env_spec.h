@@ -17,30 +17,94 @@
 #ifndef ENVPOOL_CORE_ENV_SPEC_H_
 #define ENVPOOL_CORE_ENV_SPEC_H_
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "envpool/core/array.h"
 #include "envpool/core/dict.h"
+#include "envpool/core/type_utils.h"
 
-auto common_config =
+inline auto common_config =
     MakeDict("num_envs"_.Bind(1), "batch_size"_.Bind(0), "num_threads"_.Bind(0),
              "max_num_players"_.Bind(1), "thread_affinity_offset"_.Bind(-1),
              "base_path"_.Bind(std::string("envpool")), "seed"_.Bind(42),
              "gym_reset_return_info"_.Bind(false),
-             "max_episode_steps"_.Bind(std::numeric_limits<int>::max()));
+             "max_episode_steps"_.Bind(std::numeric_limits<int>::max()),
+             "frame_stack"_.Bind(1), "env_priority"_.Bind(std::vector<int>{}),
+             "max_chunk_size"_.Bind(0), "elastic_threads"_.Bind(false),
+             "max_fps"_.Bind(0.0), "cpu_quota"_.Bind(0.0),
+             "deterministic_async"_.Bind(false), "user_state_size"_.Bind(0),
+             "xla_container_size"_.Bind(0));
 // Note: this action order is hardcoded in async_envpool Send function
 // and env ParseAction function for performance
-auto common_action_spec = MakeDict("env_id"_.Bind(Spec<int>({})),
-                                   "players.env_id"_.Bind(Spec<int>({-1})));
+inline auto common_action_spec =
+    MakeDict("env_id"_.Bind(Spec<int>({})),
+             "players.env_id"_.Bind(Spec<int>({-1})));
 // Note: this state order is hardcoded in async_envpool Recv function
-auto common_state_spec =
+inline auto common_state_spec =
     MakeDict("info:env_id"_.Bind(Spec<int>({})),
              "info:players.env_id"_.Bind(Spec<int>({-1})),
              "elapsed_step"_.Bind(Spec<int>({})), "done"_.Bind(Spec<bool>({})),
              "reward"_.Bind(Spec<float>({-1})),
              "discount"_.Bind(Spec<float>({-1}, {0.0, 1.0})),
-             "step_type"_.Bind(Spec<int>({})), "trunc"_.Bind(Spec<bool>({})));
+             "step_type"_.Bind(Spec<int>({})), "trunc"_.Bind(Spec<bool>({})),
+             "info:user_state"_.Bind(Spec<float>({0})));
+
+/**
+ * Observation history: when frame_stack > 1, every non-player, non-container
+ * state whose key is "obs" or starts with "obs:" gets a leading dimension of
+ * frame_stack, which holds the last frame_stack observations from the oldest
+ * to the newest. The env itself still writes a single frame, see `Env`.
+ */
+inline bool IsHistoryKey(const std::string& key) {
+  return key == "obs" || key.rfind("obs:", 0) == 0;
+}
+
+template <typename D>
+bool IsHistorySpec(const Spec<D>& spec) {
+  return spec.shape.empty() || spec.shape[0] != -1;
+}
+
+template <typename D>
+bool IsHistorySpec(const Spec<Container<D>>& spec) {
+  return false;
+}
+
+template <typename D>
+void StackSpec(Spec<D>* spec, int frame_stack) {
+  spec->shape.insert(spec->shape.begin(), frame_stack);
+  for (auto* bounds : {&std::get<0>(spec->elementwise_bounds),
+                       &std::get<1>(spec->elementwise_bounds)}) {
+    std::vector<D> frame(*bounds);
+    for (int i = 1; i < frame_stack; ++i) {
+      bounds->insert(bounds->end(), frame.begin(), frame.end());
+    }
+  }
+}
+
+template <typename D>
+void StackSpec(Spec<Container<D>>* spec, int frame_stack) {}
+
+/**
+ * Return whether each state in state_spec is stacked by the history stage.
+ */
+template <typename StateSpec>
+std::vector<bool> HistoryMask(const StateSpec& state_spec, int frame_stack) {
+  std::vector<std::string> keys = StateSpec::AllKeys();
+  std::vector<bool> mask;
+  std::size_t i = 0;
+  std::apply(
+      [&](auto&&... spec) {
+        ((mask.push_back(frame_stack > 1 && IsHistoryKey(keys[i++]) &&
+                         IsHistorySpec(spec))),
+         ...);
+      },
+      state_spec.AllValues());
+  return mask;
+}
 
 /**
  * EnvSpec funciton, it constructs the env spec when a Config is passed.
@@ -80,6 +144,63 @@ class EnvSpec {
     if (config["batch_size"_] == 0) {
       config["batch_size"_] = config["num_envs"_];
     }
+    const std::vector<int>& env_priority = config["env_priority"_];
+    if (!env_priority.empty()) {
+      std::size_t num_envs = config["num_envs"_];
+      if (env_priority.size() != num_envs) {
+        throw std::invalid_argument(
+            "It is required that len(env_priority) == num_envs, got "
+            "num_envs = " +
+            std::to_string(config["num_envs"_]) +
+            ", len(env_priority) = " + std::to_string(env_priority.size()));
+      }
+      if (*std::min_element(env_priority.begin(), env_priority.end()) < 0) {
+        throw std::invalid_argument("env_priority should be non-negative");
+      }
+    }
+    if (config["max_chunk_size"_] < 0) {
+      throw std::invalid_argument(
+          "It is required that max_chunk_size >= 0, got max_chunk_size = " +
+          std::to_string(config["max_chunk_size"_]));
+    }
+    if (config["max_fps"_] < 0 || config["cpu_quota"_] < 0) {
+      throw std::invalid_argument(
+          "max_fps and cpu_quota should be non-negative, 0 means no limit");
+    }
+    int user_state_size = config["user_state_size"_];
+    if (user_state_size < 0) {
+      throw std::invalid_argument(
+          "It is required that user_state_size >= 0, got user_state_size = " +
+          std::to_string(user_state_size));
+    }
+    // opaque per-env payload of the user, see `AsyncEnvPool::Send`
+    state_spec["info:user_state"_] = Spec<float>({user_state_size});
+    int frame_stack = config["frame_stack"_];
+    if (frame_stack < 1) {
+      throw std::invalid_argument(
+          "It is required that frame_stack >= 1, got frame_stack = " +
+          std::to_string(frame_stack));
+    }
+    // envs such as atari and vizdoom stack their own frames along the
+    // channel axis, frame_stack on top of that would stack them twice
+    if constexpr (any_match<decltype("stack_num"_), ConfigKeys>::value) {
+      int stack_num = config["stack_num"_];
+      if (frame_stack > 1 && stack_num > 1) {
+        throw std::invalid_argument(
+            "frame_stack > 1 would stack the frames of this env a second "
+            "time, set stack_num = 1 to use frame_stack instead, got "
+            "stack_num = " +
+            std::to_string(stack_num) +
+            ", frame_stack = " + std::to_string(frame_stack));
+      }
+    }
+    auto mask = HistoryMask(state_spec, frame_stack);
+    std::size_t i = 0;
+    std::apply(
+        [&](auto&&... spec) {
+          ((mask[i++] ? StackSpec(&spec, frame_stack) : void()), ...);
+        },
+        state_spec.AllValues());
   }
 };
 
@@ -100,6 +100,24 @@ Array NumpyToArrayIncRef(const py::array& arr) {
                });
 }
 
+/**
+ * Copy arr into memory owned by the Array. Unlike NumpyToArrayIncRef, the
+ * result holds no Python reference, so the worker threads which release it
+ * never take the GIL: with a busy Python thread, each such release waits up
+ * to the GIL switch interval (5ms by default), while the copy of an action
+ * batch takes well under a microsecond.
+ */
+template <typename dtype>
+Array NumpyToArrayCopy(const py::array& arr) {
+  using ArrayT = py::array_t<dtype, py::array::c_style | py::array::forcecast>;
+  ArrayT arr_t(arr);
+  ShapeSpec spec(arr_t.itemsize(),
+                 std::vector<int>(arr_t.shape(), arr_t.shape() + arr_t.ndim()));
+  Array ret(spec);
+  ret.Assign(arr_t.data(), static_cast<std::size_t>(arr_t.size()));
+  return ret;
+}
+
 template <typename Spec>
 struct SpecTupleHelper {
   static decltype(auto) Make(const Spec& spec) {
@@ -192,7 +210,7 @@ void ToArray(const std::vector<py::array>& py_arrs,
   std::apply(
       [&](auto&&... spec) {
         (ret->emplace_back(
-             NumpyToArrayIncRef<typename Spec::dtype>(py_arrs[index++])),
+             NumpyToArrayCopy<typename Spec::dtype>(py_arrs[index++])),
          ...);
       },
       specs);
@@ -215,21 +233,11 @@ class PyEnvPool : public EnvPool {
       : EnvPool(py_spec), py_spec(py_spec) {}
 
   /**
-   * get xla functions
+   * get xla functions, see `XlaLayout` for the padded layout of the states
+   * and actions
    */
   auto Xla() {
-    if (HasContainerType(EnvPool::spec.state_spec)) {
-      throw std::runtime_error(
-          "State of this env has dynamic shaped container, xla is disabled");
-    }
-    if (HasDynamicDim(EnvPool::spec.state_spec)) {
-      throw std::runtime_error(
-          "State of this env has dynamic (-1) shape, xla is disabled");
-    }
-    if (EnvPool::spec.config["max_num_players"_] != 1) {
-      throw std::runtime_error(
-          "Xla is not available for multiplayer environment.");
-    }
+    MakeXlaLayout(this).Check(EnvPool::spec.state_spec.AllValues());
     return std::make_tuple(
         std::make_tuple("recv",
                         CustomCall<EnvPool, XlaRecv<EnvPool>>::Xla(this)),
@@ -248,6 +256,19 @@ class PyEnvPool : public EnvPool {
     EnvPool::Send(arr);  // delegate to the c++ api
   }
 
+  /**
+   * py api
+   */
+  void PySendWithUserState(const std::vector<py::array>& action,
+                           const py::array& user_state) {
+    std::vector<Array> arr;
+    arr.reserve(action.size());
+    ToArray(action, py_spec.action_spec, &arr);
+    auto user_state_arr = NumpyToArrayCopy<float>(user_state);
+    py::gil_scoped_release release;
+    EnvPool::Send(arr, user_state_arr);
+  }
+
   /**
    * py api
    */
@@ -273,6 +294,89 @@ class PyEnvPool : public EnvPool {
     py::gil_scoped_release release;
     EnvPool::Reset(arr);
   }
+
+  /**
+   * py api
+   */
+  void PyResetWithSeed(const py::array& env_ids, const py::array& seeds) {
+    auto arr = NumpyToArrayIncRef<int>(env_ids);
+    auto seed_arr = NumpyToArrayIncRef<int>(seeds);
+    py::gil_scoped_release release;
+    EnvPool::Reset(arr, seed_arr);
+  }
+
+  /**
+   * py api
+   */
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> PyLaneStats() {
+    return EnvPool::LaneStats();
+  }
+
+  /**
+   * py api
+   */
+  void PySetNumThreads(std::size_t num_threads) {
+    py::gil_scoped_release release;
+    EnvPool::SetNumThreads(num_threads);
+  }
+
+  /**
+   * py api
+   */
+  std::size_t PyNumActiveThreads() { return EnvPool::NumActiveThreads(); }
+
+  /**
+   * py api
+   */
+  std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>
+  PyThrottleStats() {
+    return EnvPool::ThrottleStats();
+  }
+
+  /**
+   * py api
+   */
+  std::tuple<std::size_t, std::size_t, std::size_t, std::size_t> PyGauges() {
+    return EnvPool::Gauges();
+  }
+
+  /**
+   * py api
+   */
+  std::vector<bool> PyInFlight() { return EnvPool::InFlight(); }
+
+  /**
+   * py api
+   */
+  std::vector<py::array> PyBranch(int env_id, int horizon,
+                                  const std::vector<py::array>& action) {
+    std::vector<Array> arr;
+    arr.reserve(action.size());
+    ToArray(action, py_spec.action_spec, &arr);
+    {
+      py::gil_scoped_release release;
+      arr = EnvPool::Branch(env_id, horizon, arr);
+    }
+    std::vector<py::array> ret;
+    ret.reserve(EnvPool::State::kSize);
+    ToNumpy(arr, py_spec.state_spec, &ret);
+    return ret;
+  }
+
+  /**
+   * py api
+   */
+  std::tuple<py::array, py::array> PyJacobians(const py::array& env_ids,
+                                               double eps, bool centered) {
+    auto arr = NumpyToArrayIncRef<int>(env_ids);
+    std::pair<Array, Array> ret;
+    {
+      py::gil_scoped_release release;
+      ret = EnvPool::Jacobians(arr, eps, centered);
+    }
+    return {ArrayToNumpyHelper<double>::Convert(ret.first),
+            ArrayToNumpyHelper<double>::Convert(ret.second)};
+  }
 };
 
 template <typename EnvPool>
@@ -282,32 +386,48 @@ template <typename EnvPool>
 std::vector<std::string> PyEnvPool<EnvPool>::py_action_keys =
     PyEnvPool<EnvPool>::PySpec::py_action_keys;
 
-py::object abc_meta = py::module::import("abc").attr("ABCMeta");
+/**
+ * Imported on every registration instead of being cached in a global, which
+ * would outlive the interpreter and be shared by every module.
+ */
+inline py::object AbcMeta() {
+  return py::module_::import("abc").attr("ABCMeta");
+}
 
 /**
  * Call this macro in the translation unit of each envpool instance
  * It will register the envpool instance to the registry.
  * The static bool status is local to the translation unit.
  */
-#define REGISTER(MODULE, SPEC, ENVPOOL)                              \
-  py::class_<SPEC>(MODULE, "_" #SPEC, py::metaclass(abc_meta))       \
-      .def(py::init<const typename SPEC::ConfigValues&>())           \
-      .def_readonly("_config_values", &SPEC::py_config_values)       \
-      .def_readonly("_state_spec", &SPEC::py_state_spec)             \
-      .def_readonly("_action_spec", &SPEC::py_action_spec)           \
-      .def_readonly_static("_state_keys", &SPEC::py_state_keys)      \
-      .def_readonly_static("_action_keys", &SPEC::py_action_keys)    \
-      .def_readonly_static("_config_keys", &SPEC::py_config_keys)    \
-      .def_readonly_static("_default_config_values",                 \
-                           &SPEC::py_default_config_values);         \
-  py::class_<ENVPOOL>(MODULE, "_" #ENVPOOL, py::metaclass(abc_meta)) \
-      .def(py::init<const SPEC&>())                                  \
-      .def_readonly("_spec", &ENVPOOL::py_spec)                      \
-      .def("_recv", &ENVPOOL::PyRecv)                                \
-      .def("_send", &ENVPOOL::PySend)                                \
-      .def("_reset", &ENVPOOL::PyReset)                              \
-      .def_readonly_static("_state_keys", &ENVPOOL::py_state_keys)   \
-      .def_readonly_static("_action_keys", &ENVPOOL::py_action_keys) \
+#define REGISTER(MODULE, SPEC, ENVPOOL)                               \
+  py::class_<SPEC>(MODULE, "_" #SPEC, py::metaclass(AbcMeta()))       \
+      .def(py::init<const typename SPEC::ConfigValues&>())            \
+      .def_readonly("_config_values", &SPEC::py_config_values)        \
+      .def_readonly("_state_spec", &SPEC::py_state_spec)              \
+      .def_readonly("_action_spec", &SPEC::py_action_spec)            \
+      .def_readonly_static("_state_keys", &SPEC::py_state_keys)       \
+      .def_readonly_static("_action_keys", &SPEC::py_action_keys)     \
+      .def_readonly_static("_config_keys", &SPEC::py_config_keys)     \
+      .def_readonly_static("_default_config_values",                  \
+                           &SPEC::py_default_config_values);          \
+  py::class_<ENVPOOL>(MODULE, "_" #ENVPOOL, py::metaclass(AbcMeta())) \
+      .def(py::init<const SPEC&>())                                   \
+      .def_readonly("_spec", &ENVPOOL::py_spec)                       \
+      .def("_recv", &ENVPOOL::PyRecv)                                 \
+      .def("_send", &ENVPOOL::PySend)                                 \
+      .def("_send", &ENVPOOL::PySendWithUserState)                    \
+      .def("_reset", &ENVPOOL::PyReset)                               \
+      .def("_reset", &ENVPOOL::PyResetWithSeed)                       \
+      .def("_lane_stats", &ENVPOOL::PyLaneStats)                      \
+      .def("_set_num_threads", &ENVPOOL::PySetNumThreads)             \
+      .def("_num_active_threads", &ENVPOOL::PyNumActiveThreads)       \
+      .def("_throttle_stats", &ENVPOOL::PyThrottleStats)              \
+      .def("_gauges", &ENVPOOL::PyGauges)                             \
+      .def("_in_flight", &ENVPOOL::PyInFlight)                        \
+      .def("_branch", &ENVPOOL::PyBranch)                             \
+      .def("_jacobians", &ENVPOOL::PyJacobians)                       \
+      .def_readonly_static("_state_keys", &ENVPOOL::py_state_keys)    \
+      .def_readonly_static("_action_keys", &ENVPOOL::py_action_keys)  \
       .def("_xla", &ENVPOOL::Xla);
 
 #endif  // ENVPOOL_CORE_PY_ENVPOOL_H_
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CORE_RATE_LIMITER_H_
+#define ENVPOOL_CORE_RATE_LIMITER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Lock-free token bucket shared by several threads.
+ *
+ * Tokens are refilled at `rate` per second, and up to `burst` tokens can be
+ * taken at once after an idle period. Instead of keeping a token count, the
+ * bucket keeps the time at which it will be full again: each Acquire moves
+ * that time forward by cost / rate with a single CAS, and the caller sleeps
+ * until the bucket has refilled enough tokens, so nobody busy waits.
+ */
+class RateLimiter {
+ protected:
+  using Clock = std::chrono::steady_clock;
+  double ns_per_token_;
+  int64_t burst_ns_;
+  Clock::time_point origin_;
+  // time in ns since origin_ at which all acquired tokens are refilled
+  std::atomic<int64_t> full_time_{0};
+  std::atomic<uint64_t> acquired_{0}, throttled_ns_{0};
+  // sleepers wait on cv_ so that Cancel can wake them up
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool cancelled_{false};
+
+ public:
+  RateLimiter(double rate, double burst)
+      : ns_per_token_(1e9 / rate),
+        burst_ns_(static_cast<int64_t>(std::max(burst, 1.0) * ns_per_token_)),
+        origin_(Clock::now()) {}
+
+  /**
+   * Take cost tokens, block until they are available and return the time
+   * slept in ns.
+   */
+  int64_t Acquire(uint64_t cost) {
+    acquired_.fetch_add(cost);
+    int64_t now = Now();
+    auto cost_ns = static_cast<int64_t>(static_cast<double>(cost) *
+                                        ns_per_token_);
+    int64_t full_time = full_time_.load();
+    int64_t new_full_time;
+    do {
+      new_full_time = std::max(full_time, now) + cost_ns;
+    } while (!full_time_.compare_exchange_weak(full_time, new_full_time));
+    // the bucket holds burst tokens, so the caller only waits for the part
+    // which exceeds it
+    int64_t wake_time = new_full_time - burst_ns_;
+    if (wake_time <= now) {
+      return 0;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait_until(lock, origin_ + std::chrono::nanoseconds(wake_time),
+                     [this] { return cancelled_; });
+    }
+    int64_t slept = Now() - now;
+    throttled_ns_.fetch_add(slept);
+    return slept;
+  }
+
+  /**
+   * Wake up all the blocked callers, and stop limiting from now on.
+   */
+  void Cancel() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * Total number of tokens acquired so far.
+   */
+  [[nodiscard]] uint64_t Acquired() const { return acquired_; }
+
+  /**
+   * Total time in ns that callers of Acquire have been blocked.
+   */
+  [[nodiscard]] uint64_t ThrottledNs() const { return throttled_ns_; }
+
+ protected:
+  [[nodiscard]] int64_t Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                                origin_)
+        .count();
+  }
+};
+
+#endif  // ENVPOOL_CORE_RATE_LIMITER_H_
@@ -0,0 +1,73 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "envpool/core/rate_limiter.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+TEST(RateLimiterTest, Burst) {
+  RateLimiter limiter(100, 10);
+  auto start = Clock::now();
+  // a full bucket is taken without blocking
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(limiter.Acquire(1), 0);
+  }
+  EXPECT_LT(Clock::now() - start, std::chrono::milliseconds(50));
+  // the next token is refilled 10ms later
+  EXPECT_GT(limiter.Acquire(1), 0);
+  EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(9));
+  EXPECT_EQ(limiter.Acquired(), 11);
+  EXPECT_GT(limiter.ThrottledNs(), 0);
+}
+
+TEST(RateLimiterTest, Concurrent) {
+  int num_threads = 4;
+  int num_acquire = 50;
+  RateLimiter limiter(2000, 1);
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < num_acquire; ++i) {
+        limiter.Acquire(1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  // 200 tokens at 2000 per second, minus the initial bucket
+  EXPECT_GE(elapsed, 0.099);
+  EXPECT_LT(elapsed, 1.0);
+  EXPECT_EQ(limiter.Acquired(), num_threads * num_acquire);
+}
+
+TEST(RateLimiterTest, Cancel) {
+  RateLimiter limiter(1, 1);
+  limiter.Acquire(1);
+  std::thread blocked([&] { limiter.Acquire(100); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  auto start = Clock::now();
+  limiter.Cancel();
+  blocked.join();
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(1));
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CORE_RETURNS_H_
+#define ENVPOOL_CORE_RETURNS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Batched return computation over rollout buffers.
+ *
+ * All the inputs are time-major `[T + 1, B]` buffers that are stacked
+ * directly from `T + 1` consecutive `recv` calls, i.e. row `t` holds what
+ * envpool returns when arriving at state `s_t`:
+ *
+ *   value[t]    V(s_t), evaluated by the learner
+ *   reward[t]   reward received when arriving at s_t
+ *   discount[t] discount of s_t, 0 when the episode ends
+ *   done[t]     s_t is the last state of an episode (terminated or truncated)
+ *   trunc[t]    s_t is the last state because of max_episode_steps
+ *
+ * Following the auto-reset semantic, the action taken at a `done` state is
+ * discarded and the next state is the first state of a new episode, so the
+ * transition t -> t + 1 carries no learning signal: its advantage is 0 and its
+ * target equals value[t]. A truncated state is bootstrapped with its own
+ * value instead of the (zero) discount.
+ *
+ * The outputs are `[T, B]`. Each kernel scans time backwards and keeps the
+ * env axis as the contiguous inner loop, so that the per-row update is
+ * branch-free and vectorized by the compiler; envs are split into contiguous
+ * column blocks and processed by `num_threads` threads.
+ */
+namespace returns {
+
+/**
+ * Run fn(begin, end) over contiguous column blocks of [0, batch).
+ */
+template <typename Fn>
+void ParallelColumns(std::size_t batch, std::size_t num_threads, Fn&& fn) {
+  // below this size per thread, spawning threads costs more than the scan
+  constexpr std::size_t kMinColumnsPerThread = 64;
+  num_threads = std::max<std::size_t>(
+      1, std::min(num_threads, batch / kMinColumnsPerThread));
+  if (num_threads == 1) {
+    fn(0, batch);
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  std::size_t chunk = (batch + num_threads - 1) / num_threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    std::size_t begin = std::min(batch, i * chunk);
+    std::size_t end = std::min(batch, begin + chunk);
+    workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+  }
+  fn(0, std::min(batch, chunk));
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+/**
+ * Bootstrap factor of the transition arriving at row t: the env discount,
+ * except that a truncated state is still bootstrapped.
+ */
+inline float NextDiscount(const float* discount, const bool* trunc,
+                          std::size_t i) {
+  return trunc[i] ? 1.0F : discount[i];
+}
+
+/**
+ * Generalized advantage estimation, GAE(lambda).
+ *
+ * advantage[t] = delta[t] + gamma * lambda * (1 - done[t + 1]) * advantage[t+1]
+ * delta[t] = reward[t + 1] + gamma * d[t + 1] * value[t + 1] - value[t]
+ * target[t] = advantage[t] + value[t]
+ */
+inline void ComputeGae(std::size_t num_steps, std::size_t batch,
+                       const float* value, const float* reward,
+                       const float* discount, const bool* done,
+                       const bool* trunc, float gamma, float gae_lambda,
+                       float* advantage, float* target,
+                       std::size_t num_threads = 1) {
+  ParallelColumns(batch, num_threads, [&](std::size_t begin, std::size_t end) {
+    std::vector<float> last(end - begin, 0.0F);
+    for (std::size_t t = num_steps; t-- > 0;) {
+      std::size_t row = t * batch;
+      std::size_t next = row + batch;
+      for (std::size_t b = begin; b < end; ++b) {
+        float valid = done[row + b] ? 0.0F : 1.0F;
+        float cont = done[next + b] ? 0.0F : 1.0F;
+        float delta = reward[next + b] +
+                      gamma * NextDiscount(discount, trunc, next + b) *
+                          value[next + b] -
+                      value[row + b];
+        float adv =
+            valid * (delta + gamma * gae_lambda * cont * last[b - begin]);
+        last[b - begin] = adv;
+        advantage[row + b] = adv;
+        target[row + b] = adv + value[row + b];
+      }
+    }
+  });
+}
+
+/**
+ * n-step bootstrapped return.
+ *
+ * target[t] = sum_{k < m} gamma^k reward[t + k + 1]
+ *             + gamma^m d[t + m] value[t + m]
+ * where m = min(n, T - t, steps until the end of the episode).
+ */
+inline void ComputeNStepReturn(std::size_t num_steps, std::size_t batch,
+                               const float* value, const float* reward,
+                               const float* discount, const bool* done,
+                               const bool* trunc, float gamma,
+                               std::size_t n_step, float* target,
+                               std::size_t num_threads = 1) {
+  ParallelColumns(batch, num_threads, [&](std::size_t begin, std::size_t end) {
+    std::size_t width = end - begin;
+    // acc: running return, scale: gamma^m, alive: episode not ended yet
+    std::vector<float> acc(width);
+    std::vector<float> scale(width);
+    std::vector<float> alive(width);
+    for (std::size_t t = 0; t < num_steps; ++t) {
+      std::size_t row = t * batch;
+      std::size_t horizon = std::min(n_step, num_steps - t);
+      for (std::size_t b = begin; b < end; ++b) {
+        acc[b - begin] = 0.0F;
+        scale[b - begin] = 1.0F;
+        alive[b - begin] = done[row + b] ? 0.0F : 1.0F;
+      }
+      for (std::size_t k = 1; k <= horizon; ++k) {
+        std::size_t cur = row + k * batch;
+        bool last = k == horizon;
+        for (std::size_t b = begin; b < end; ++b) {
+          float a = alive[b - begin];
+          float s = scale[b - begin];
+          float ended = done[cur + b] ? 1.0F : 0.0F;
+          float bootstrap = last ? 1.0F : ended;
+          acc[b - begin] += a * s *
+                            (reward[cur + b] +
+                             bootstrap * gamma *
+                                 NextDiscount(discount, trunc, cur + b) *
+                                 value[cur + b]);
+          scale[b - begin] = s * gamma;
+          alive[b - begin] = a * (1.0F - ended);
+        }
+      }
+      for (std::size_t b = begin; b < end; ++b) {
+        target[row + b] = done[row + b] ? value[row + b] : acc[b - begin];
+      }
+    }
+  });
+}
+
+/**
+ * V-trace targets (IMPALA, Espeholt et al. 2018).
+ *
+ * rho[t] is the importance ratio pi(a_t|s_t) / mu(a_t|s_t) of the action
+ * taken at s_t, with shape [T, B].
+ *
+ * vs[t] = value[t] + min(rho_bar, rho[t]) * delta[t]
+ *         + gamma * (1 - done[t + 1]) * min(c_bar, rho[t]) * (vs[t+1] - v[t+1])
+ * pg_advantage[t] = min(pg_rho_bar, rho[t])
+ *                   * (reward[t + 1] + gamma * d[t + 1] * vs'[t+1] - value[t])
+ * where vs'[t + 1] is vs[t + 1] inside the episode and value[t + 1] at its end
+ * or at the end of the rollout.
+ */
+inline void ComputeVtrace(std::size_t num_steps, std::size_t batch,
+                          const float* value, const float* reward,
+                          const float* discount, const bool* done,
+                          const bool* trunc, const float* rho, float gamma,
+                          float rho_bar, float c_bar, float pg_rho_bar,
+                          float* vs, float* pg_advantage,
+                          std::size_t num_threads = 1) {
+  ParallelColumns(batch, num_threads, [&](std::size_t begin, std::size_t end) {
+    // acc = vs[t + 1] - value[t + 1] of the current episode
+    std::vector<float> acc(end - begin, 0.0F);
+    for (std::size_t t = num_steps; t-- > 0;) {
+      std::size_t row = t * batch;
+      std::size_t next = row + batch;
+      for (std::size_t b = begin; b < end; ++b) {
+        float valid = done[row + b] ? 0.0F : 1.0F;
+        float cont = done[next + b] ? 0.0F : 1.0F;
+        float r = rho[row + b];
+        float gd = gamma * NextDiscount(discount, trunc, next + b);
+        float next_vs = value[next + b] + cont * acc[b - begin];
+        float delta = reward[next + b] + gd * value[next + b] - value[row + b];
+        float a = valid * (std::min(rho_bar, r) * delta +
+                           gamma * cont * std::min(c_bar, r) * acc[b - begin]);
+        acc[b - begin] = a;
+        vs[row + b] = value[row + b] + a;
+        pg_advantage[row + b] =
+            valid * std::min(pg_rho_bar, r) *
+            (reward[next + b] + gd * next_vs - value[row + b]);
+      }
+    }
+  });
+}
+
+}  // namespace returns
+
+#endif  // ENVPOOL_CORE_RETURNS_H_
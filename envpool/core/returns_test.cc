@@ -0,0 +1,227 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/core/returns.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+struct Rollout {
+  std::size_t num_steps, batch;
+  std::vector<float> value, reward, discount, rho;
+  std::unique_ptr<bool[]> done, trunc;  // NOLINT
+
+  Rollout(std::size_t num_steps, std::size_t batch, int seed)
+      : num_steps(num_steps),
+        batch(batch),
+        value((num_steps + 1) * batch),
+        reward((num_steps + 1) * batch),
+        discount((num_steps + 1) * batch),
+        rho(num_steps * batch),
+        done(new bool[(num_steps + 1) * batch]),    // NOLINT
+        trunc(new bool[(num_steps + 1) * batch]) {  // NOLINT
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.0, 1.0);
+    std::uniform_real_distribution<float> ratio(0.0, 2.0);
+    std::uniform_int_distribution<int> coin(0, 9);
+    for (std::size_t i = 0; i < (num_steps + 1) * batch; ++i) {
+      value[i] = dist(gen);
+      reward[i] = dist(gen);
+      done[i] = coin(gen) == 0;
+      trunc[i] = done[i] && coin(gen) < 3;
+      discount[i] = done[i] ? 0.0F : 1.0F;
+    }
+    for (auto& r : rho) {
+      r = ratio(gen);
+    }
+  }
+
+  [[nodiscard]] float Boot(std::size_t i) const {
+    return trunc[i] ? 1.0F : discount[i];
+  }
+};
+
+// straightforward per-env reference implementations
+void RefGae(const Rollout& r, float gamma, float lambda,
+            std::vector<float>* adv) {
+  for (std::size_t b = 0; b < r.batch; ++b) {
+    float last = 0;
+    for (int t = static_cast<int>(r.num_steps) - 1; t >= 0; --t) {
+      std::size_t i = t * r.batch + b;
+      std::size_t j = i + r.batch;
+      if (r.done[i]) {
+        last = 0;
+      } else {
+        float delta =
+            r.reward[j] + gamma * r.Boot(j) * r.value[j] - r.value[i];
+        last = delta + (r.done[j] ? 0.0F : gamma * lambda * last);
+      }
+      (*adv)[i] = last;
+    }
+  }
+}
+
+void RefNStep(const Rollout& r, float gamma, std::size_t n,
+              std::vector<float>* target) {
+  for (std::size_t b = 0; b < r.batch; ++b) {
+    for (std::size_t t = 0; t < r.num_steps; ++t) {
+      std::size_t i = t * r.batch + b;
+      if (r.done[i]) {
+        (*target)[i] = r.value[i];
+        continue;
+      }
+      float ret = 0;
+      float scale = 1;
+      for (std::size_t k = 1; k <= n && t + k <= r.num_steps; ++k) {
+        std::size_t j = i + k * r.batch;
+        ret += scale * r.reward[j];
+        scale *= gamma;
+        if (r.done[j] || k == n || t + k == r.num_steps) {
+          ret += scale * r.Boot(j) * r.value[j];
+          break;
+        }
+      }
+      (*target)[i] = ret;
+    }
+  }
+}
+
+void RefVtrace(const Rollout& r, float gamma, float rho_bar, float c_bar,
+               std::vector<float>* vs) {
+  for (std::size_t b = 0; b < r.batch; ++b) {
+    std::vector<float> v(r.num_steps + 1);
+    v[r.num_steps] = r.value[r.num_steps * r.batch + b];
+    for (int t = static_cast<int>(r.num_steps) - 1; t >= 0; --t) {
+      std::size_t i = t * r.batch + b;
+      std::size_t j = i + r.batch;
+      if (r.done[i]) {
+        v[t] = r.value[i];
+        continue;
+      }
+      float delta = r.reward[j] + gamma * r.Boot(j) * r.value[j] - r.value[i];
+      float carry = r.done[j] ? 0.0F : v[t + 1] - r.value[j];
+      v[t] = r.value[i] + std::min(rho_bar, r.rho[i]) * delta +
+             gamma * std::min(c_bar, r.rho[i]) * carry;
+    }
+    for (std::size_t t = 0; t < r.num_steps; ++t) {
+      (*vs)[t * r.batch + b] = v[t];
+    }
+  }
+}
+
+TEST(ReturnsTest, Gae) {
+  for (std::size_t num_threads : {1, 4}) {
+    Rollout r(37, 300, 0);
+    std::vector<float> adv(r.num_steps * r.batch);
+    std::vector<float> target(r.num_steps * r.batch);
+    std::vector<float> ref(r.num_steps * r.batch);
+    returns::ComputeGae(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                        r.discount.data(), r.done.get(), r.trunc.get(), 0.99,
+                        0.95, adv.data(), target.data(), num_threads);
+    RefGae(r, 0.99, 0.95, &ref);
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+      EXPECT_NEAR(adv[i], ref[i], 1e-4);
+      EXPECT_NEAR(target[i], ref[i] + r.value[i], 1e-4);
+    }
+  }
+}
+
+TEST(ReturnsTest, GaeLambdaOneIsMonteCarlo) {
+  // single env, episode ends by termination at t = 3
+  std::size_t num_steps = 3;
+  std::vector<float> value{0.5, 0.2, 0.1, 7.0};
+  std::vector<float> reward{0.0, 1.0, 2.0, 3.0};
+  std::vector<float> discount{1.0, 1.0, 1.0, 0.0};
+  bool done[] = {false, false, false, true};
+  bool trunc[] = {false, false, false, false};
+  std::vector<float> adv(num_steps);
+  std::vector<float> target(num_steps);
+  returns::ComputeGae(num_steps, 1, value.data(), reward.data(),
+                      discount.data(), done, trunc, 0.5, 1.0, adv.data(),
+                      target.data());
+  EXPECT_FLOAT_EQ(target[2], 3.0);
+  EXPECT_FLOAT_EQ(target[1], 2.0 + 0.5 * 3.0);
+  EXPECT_FLOAT_EQ(target[0], 1.0 + 0.5 * 2.0 + 0.25 * 3.0);
+  // truncation bootstraps from the value of the last state
+  trunc[3] = true;
+  returns::ComputeGae(num_steps, 1, value.data(), reward.data(),
+                      discount.data(), done, trunc, 0.5, 1.0, adv.data(),
+                      target.data());
+  EXPECT_FLOAT_EQ(target[2], 3.0 + 0.5 * 7.0);
+}
+
+TEST(ReturnsTest, NStep) {
+  for (std::size_t n : {1, 3, 100}) {
+    Rollout r(29, 200, 1);
+    std::vector<float> target(r.num_steps * r.batch);
+    std::vector<float> ref(r.num_steps * r.batch);
+    returns::ComputeNStepReturn(r.num_steps, r.batch, r.value.data(),
+                                r.reward.data(), r.discount.data(),
+                                r.done.get(), r.trunc.get(), 0.9, n,
+                                target.data(), 3);
+    RefNStep(r, 0.9, n, &ref);
+    for (std::size_t i = 0; i < ref.size(); ++i) {
+      EXPECT_NEAR(target[i], ref[i], 1e-4);
+    }
+  }
+}
+
+TEST(ReturnsTest, NStepMatchesGaeLambdaOne) {
+  Rollout r(16, 128, 2);
+  std::vector<float> adv(r.num_steps * r.batch);
+  std::vector<float> gae_target(r.num_steps * r.batch);
+  std::vector<float> target(r.num_steps * r.batch);
+  returns::ComputeGae(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                      r.discount.data(), r.done.get(), r.trunc.get(), 0.9, 1.0,
+                      adv.data(), gae_target.data());
+  returns::ComputeNStepReturn(r.num_steps, r.batch, r.value.data(),
+                              r.reward.data(), r.discount.data(), r.done.get(),
+                              r.trunc.get(), 0.9, r.num_steps, target.data());
+  for (std::size_t i = 0; i < target.size(); ++i) {
+    EXPECT_NEAR(target[i], gae_target[i], 1e-4);
+  }
+}
+
+TEST(ReturnsTest, Vtrace) {
+  Rollout r(41, 256, 3);
+  std::vector<float> vs(r.num_steps * r.batch);
+  std::vector<float> pg_adv(r.num_steps * r.batch);
+  std::vector<float> ref(r.num_steps * r.batch);
+  returns::ComputeVtrace(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                         r.discount.data(), r.done.get(), r.trunc.get(),
+                         r.rho.data(), 0.99, 1.0, 1.0, 1.0, vs.data(),
+                         pg_adv.data(), 2);
+  RefVtrace(r, 0.99, 1.0, 1.0, &ref);
+  for (std::size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_NEAR(vs[i], ref[i], 1e-4);
+  }
+  // on-policy v-trace reduces to GAE(lambda=1)
+  std::fill(r.rho.begin(), r.rho.end(), 1.0F);
+  std::vector<float> adv(r.num_steps * r.batch);
+  std::vector<float> target(r.num_steps * r.batch);
+  returns::ComputeVtrace(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                         r.discount.data(), r.done.get(), r.trunc.get(),
+                         r.rho.data(), 0.99, 1.0, 1.0, 1.0, vs.data(),
+                         pg_adv.data());
+  returns::ComputeGae(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                      r.discount.data(), r.done.get(), r.trunc.get(), 0.99, 1.0,
+                      adv.data(), target.data());
+  for (std::size_t i = 0; i < target.size(); ++i) {
+    EXPECT_NEAR(vs[i], target[i], 1e-4);
+  }
+}
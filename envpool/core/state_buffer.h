@@ -49,6 +49,8 @@ class StateBuffer {
   std::atomic<std::size_t> alloc_count_{0};
   std::atomic<std::size_t> done_count_{0};
   moodycamel::LightweightSemaphore sem_;
+  // counts the buffers which are complete but not yet consumed, if not null
+  std::atomic<std::size_t>* num_ready_;
 
  public:
   /**
@@ -63,15 +65,17 @@ class StateBuffer {
 
   /**
    * Create a StateBuffer instance with the player_specs and shared_specs
-   * provided.
+   * provided. num_ready is incremented once this buffer is complete.
    */
   StateBuffer(std::size_t batch, std::size_t max_num_players,
               const std::vector<ShapeSpec>& specs,
-              std::vector<bool> is_player_state)
+              std::vector<bool> is_player_state,
+              std::atomic<std::size_t>* num_ready = nullptr)
       : batch_(batch),
         max_num_players_(max_num_players),
         arrays_(MakeArray(specs)),
-        is_player_state_(std::move(is_player_state)) {}
+        is_player_state_(std::move(is_player_state)),
+        num_ready_(num_ready) {}
 
   /**
    * Tries to allocate a piece of memory without lock.
@@ -126,6 +130,9 @@ class StateBuffer {
   void Done(std::size_t num = 1) {
     std::size_t done_count = done_count_.fetch_add(num);
     if (done_count + num == batch_) {
+      if (num_ready_ != nullptr) {
+        num_ready_->fetch_add(1);
+      }
       sem_.signal();
     }
   }
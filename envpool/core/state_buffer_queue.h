@@ -40,6 +40,7 @@ class StateBufferQueue {
   std::size_t queue_size_;
   std::vector<std::unique_ptr<StateBuffer>> queue_;
   std::atomic<uint64_t> alloc_count_, done_ptr_, alloc_tail_;
+  std::atomic<std::size_t> num_ready_{0};
 
   // Create stock statebuffers in a background thread
   CircularBuffer<std::unique_ptr<StateBuffer>> stock_buffer_;
@@ -79,7 +80,7 @@ class StateBufferQueue {
     // alloc_tail_ = num_envs / batch_env + 2;
     for (auto& q : queue_) {
       q = std::make_unique<StateBuffer>(batch_, max_num_players_, specs_,
-                                        is_player_state_);
+                                        is_player_state_, &num_ready_);
     }
     std::size_t processor_count = std::thread::hardware_concurrency();
     // hardcode here :(
@@ -88,7 +89,8 @@ class StateBufferQueue {
       create_buffer_thread_.emplace_back(std::thread([&]() {
         while (true) {
           stock_buffer_.Put(std::make_unique<StateBuffer>(
-              batch_, max_num_players_, specs_, is_player_state_));
+              batch_, max_num_players_, specs_, is_player_state_,
+              &num_ready_));
           if (quit_) {
             break;
           }
@@ -143,6 +145,7 @@ class StateBufferQueue {
     std::size_t pos = done_ptr_.fetch_add(1);
     std::size_t offset = pos % queue_size_;
     auto arr = queue_[offset]->Wait(additional_done_count);
+    num_ready_.fetch_sub(1);
     if (additional_done_count > 0) {
       // move pointer to the next block
       alloc_count_.fetch_add(additional_done_count);
@@ -150,6 +153,28 @@ class StateBufferQueue {
     std::swap(queue_[offset], newbuf);
     return arr;
   }
+
+  /**
+   * Gauges of the buffers which have been written to but not yet consumed,
+   * as (num_partial, num_ready): the number of buffers partially filled, and
+   * the number of complete buffers waiting for Wait. Both are read from
+   * atomic counters without locking, so they are approximate under
+   * concurrent writes.
+   */
+  [[nodiscard]] std::pair<std::size_t, std::size_t> Occupancy() const {
+    uint64_t consumed = done_ptr_;
+    uint64_t touched = (alloc_count_ + batch_ - 1) / batch_;
+    std::size_t in_use = touched > consumed ? touched - consumed : 0;
+    std::size_t num_ready = std::min<std::size_t>(num_ready_, in_use);
+    return {in_use - num_ready, num_ready};
+  }
+
+  /**
+   * Number of empty buffers that the background threads have prepared.
+   */
+  [[nodiscard]] std::size_t NumStock() const {
+    return stock_buffer_.SizeApprox();
+  }
 };
 
 #endif  // ENVPOOL_CORE_STATE_BUFFER_QUEUE_H_
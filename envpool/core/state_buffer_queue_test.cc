@@ -17,7 +17,11 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "ThreadPool.h"
 
@@ -202,3 +206,35 @@ TEST(StateBufferQueueTest, ConcurrentMultiPlayer) {
     }
   }
 }
+
+TEST(StateBufferQueueTest, Occupancy) {
+  std::vector<ShapeSpec> specs{ShapeSpec(4, {-1}), ShapeSpec(4, {1, 2, 2})};
+  std::size_t batch = 4;
+  std::size_t num_envs = 12;
+  StateBufferQueue queue(batch, num_envs, 1, specs);
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(0UL, 0UL));
+  std::vector<StateBuffer::WritableSlice> slices;
+  for (std::size_t i = 0; i < 6; ++i) {
+    slices.push_back(queue.Allocate(1));
+  }
+  // two buffers are touched, none of them is complete
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(2UL, 0UL));
+  for (std::size_t i = 0; i < 4; ++i) {
+    slices[i].done_write();
+  }
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(1UL, 1UL));
+  queue.Wait();
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(1UL, 0UL));
+  for (std::size_t i = 4; i < 6; ++i) {
+    slices[i].done_write();
+  }
+  for (std::size_t i = 0; i < 2; ++i) {
+    queue.Allocate(1).done_write();
+  }
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(0UL, 1UL));
+  queue.Wait();
+  EXPECT_EQ(queue.Occupancy(), std::make_pair(0UL, 0UL));
+  // the background thread keeps preparing empty buffers
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_GT(queue.NumStock(), 0);
+}
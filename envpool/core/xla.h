@@ -24,40 +24,23 @@
 #include <numeric>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "envpool/core/array.h"
+#include "envpool/core/xla_layout.h"
 #include "envpool/core/xla_template.h"
 
-template <typename D>
-constexpr bool is_container_v = false;  // NOLINT
-template <typename D>
-constexpr bool is_container_v<Container<D>> = true;  // NOLINT
-template <typename... T>
-constexpr bool HasContainerType(std::tuple<T...> /*unused*/) {
-  return (is_container_v<typename T::dtype> || ...);
-}
-bool HasDynamicDim(const std::vector<int>& shape) {
-  return std::any_of(shape.begin() + 1, shape.end(),
-                     [](int s) { return s == -1; });
-}
-template <typename... T>
-bool HasDynamicDim(const std::tuple<T...>& state_spec) {
-  bool dyn = false;
-  std::apply([&](auto&&... spec) { dyn = (HasDynamicDim(spec.shape) || ...); },
-             state_spec);
-  return dyn;
+template <typename EnvPool>
+XlaLayout MakeXlaLayout(EnvPool* envpool) {
+  return XlaLayout{envpool->spec.config["batch_size"_],
+                   envpool->spec.config["max_num_players"_],
+                   envpool->spec.config["xla_container_size"_]};
 }
 
 template <typename Dtype>
-Array CpuBufferToArray(const void* buffer, ::Spec<Dtype> spec, int batch_size,
-                       int max_num_players) {
-  if (!spec.shape.empty() &&
-      spec.shape[0] == -1) {  // If first dim is max_num_players
-    spec.shape[0] = max_num_players * batch_size;
-  } else {
-    spec = spec.Batch(batch_size);
-  }
+Array CpuBufferToArray(const void* buffer, const ::Spec<Dtype>& spec) {
   Array ret(spec);
   ret.Assign(reinterpret_cast<const Dtype*>(buffer), ret.size);
   return ret;
@@ -65,51 +48,13 @@ Array CpuBufferToArray(const void* buffer, ::Spec<Dtype> spec, int batch_size,
 
 template <typename Dtype>
 Array GpuBufferToArray(cudaStream_t stream, const void* buffer,
-                       ::Spec<Dtype> spec, int batch_size,
-                       int max_num_players) {
-  if (!spec.shape.empty() &&
-      spec.shape[0] == -1) {  // If first dim is max_num_players
-    spec.shape[0] = max_num_players * batch_size;
-  } else {
-    spec = spec.Batch(batch_size);
-  }
+                       const ::Spec<Dtype>& spec) {
   Array ret(spec);
   cudaMemcpy(ret.Data(), buffer, ret.size * ret.element_size,
              cudaMemcpyDeviceToHost);
   return ret;
 }
 
-template <typename Dtype>
-::Spec<Dtype> NormalizeSpec(const ::Spec<Dtype>& spec, int batch_size,
-                            int max_num_players) {
-  std::vector<int> shape({0});
-  if (!spec.shape.empty() && spec.shape[0] == -1) {
-    shape[0] = batch_size * max_num_players;
-    shape.insert(shape.end(), spec.shape.begin() + 1, spec.shape.end());
-  } else {
-    shape[0] = batch_size;
-    shape.insert(shape.end(), spec.shape.begin(), spec.shape.end());
-  }
-  return ::Spec<Dtype>(shape);
-}
-
-/**
- * If Spec is a container, the xla interface should be disabled.
- */
-template <typename D>
-::Spec<D> NormalizeSpec(const ::Spec<Container<D>>& spec, int batch_size,
-                        int max_num_players) {
-  std::vector<int> shape({0});
-  if (!spec.shape.empty() && spec.shape[0] == -1) {
-    shape[0] = batch_size * max_num_players;
-    shape.insert(shape.end(), spec.shape.begin() + 1, spec.shape.end());
-  } else {
-    shape[0] = batch_size;
-    shape.insert(shape.end(), spec.shape.begin(), spec.shape.end());
-  }
-  return ::Spec<D>(shape);
-}
-
 template <typename EnvPool>
 struct XlaSend {
   using In =
@@ -117,92 +62,132 @@ struct XlaSend {
   using Out = std::array<void*, 0>;
 
   static decltype(auto) InSpecs(EnvPool* envpool) {
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
+    auto layout = MakeXlaLayout(envpool);
     return std::apply(
-        [&](auto&&... s) {
-          return std::make_tuple(
-              NormalizeSpec(s, batch_size, max_num_players)...);
-        },
+        [&](auto&&... s) { return std::make_tuple(layout.Normalize(s)...); },
         envpool->spec.action_spec.AllValues());
   }
 
   static decltype(auto) OutSpecs(EnvPool* envpool) { return std::tuple<>(); }
 
+  static std::vector<bool> IsPlayer(EnvPool* envpool) {
+    std::vector<bool> is_player;
+    std::apply(
+        [&](auto&&... spec) {
+          (is_player.push_back(XlaLayout::IsPlayer(spec.shape)), ...);
+        },
+        envpool->spec.action_spec.AllValues());
+    return is_player;
+  }
+
   static void Cpu(EnvPool* envpool, const In& in, const Out& out) {
     std::vector<Array> action;
     action.reserve(std::tuple_size_v<typename EnvPool::Action::Keys>);
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
-    auto action_spec = envpool->spec.action_spec.AllValues();
+    auto layout = MakeXlaLayout(envpool);
     std::size_t index = 0;
     std::apply(
         [&](auto&&... spec) {
-          ((action.emplace_back(CpuBufferToArray(in[index++], spec, batch_size,
-                                                 max_num_players))),
+          ((action.emplace_back(
+               CpuBufferToArray(in[index++], layout.Normalize(spec)))),
            ...);
         },
-        action_spec);
-    envpool->Send(action);
+        envpool->spec.action_spec.AllValues());
+    envpool->Send(layout.Unpad(std::move(action), IsPlayer(envpool)));
   }
 
   static void Gpu(EnvPool* envpool, cudaStream_t stream, const In& in,
                   const Out& out) {
     std::vector<Array> action;
     action.reserve(std::tuple_size_v<typename EnvPool::Action::Keys>);
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
-    auto action_spec = envpool->spec.action_spec.AllValues();
+    auto layout = MakeXlaLayout(envpool);
     std::size_t index = 0;
     std::apply(
         [&](auto&&... spec) {
-          ((action.emplace_back(GpuBufferToArray(stream, in[index++], spec,
-                                                 batch_size, max_num_players))),
+          ((action.emplace_back(GpuBufferToArray(stream, in[index++],
+                                                 layout.Normalize(spec)))),
            ...);
         },
-        action_spec);
-    envpool->Send(action);
+        envpool->spec.action_spec.AllValues());
+    envpool->Send(layout.Unpad(std::move(action), IsPlayer(envpool)));
   }
 };
 
+/**
+ * Outputs of XlaRecv: the padded states in the order of the state spec, the
+ * lengths of the Container states, then the env mask and the player mask.
+ */
+template <typename EnvPool>
+decltype(auto) XlaRecvSpecs(EnvPool* envpool) {
+  auto layout = MakeXlaLayout(envpool);
+  auto specs = envpool->spec.state_spec.AllValues();
+  return std::tuple_cat(
+      std::apply(
+          [&](auto&&... s) { return std::make_tuple(layout.Normalize(s)...); },
+          specs),
+      std::apply(
+          [&](auto&&... s) { return std::tuple_cat(layout.LengthSpec(s)...); },
+          specs),
+      layout.MaskSpecs());
+}
+
 template <typename EnvPool>
 struct XlaRecv {
   using In = std::array<void*, 0>;
-  using Out =
-      std::array<void*, std::tuple_size_v<typename EnvPool::State::Keys>>;
+  using Out = std::array<
+      void*, std::tuple_size_v<decltype(XlaRecvSpecs(
+                 std::declval<EnvPool*>()))>>;
 
   static decltype(auto) InSpecs(EnvPool* envpool) { return std::tuple<>(); }
 
   static decltype(auto) OutSpecs(EnvPool* envpool) {
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
-    return std::apply(
-        [&](auto&&... s) {
-          return std::make_tuple(
-              NormalizeSpec(s, batch_size, max_num_players)...);
-        },
-        envpool->spec.state_spec.AllValues());
+    return XlaRecvSpecs(envpool);
+  }
+
+  static void Pad(EnvPool* envpool, const std::vector<Array>& recv,
+                  void* const* out) {
+    auto layout = MakeXlaLayout(envpool);
+    std::size_t rows = recv[0].Shape(0);
+    std::size_t player_rows = recv[1].Shape(0);
+    CHECK_LE(rows, static_cast<std::size_t>(layout.batch_size));
+    CHECK_LE(player_rows, static_cast<std::size_t>(layout.batch_size *
+                                                   layout.max_num_players));
+    std::size_t index = 0;
+    void* const* length = out + recv.size();
+    auto keys = envpool->spec.state_spec.AllKeys();
+    auto pad = [&](const auto& spec) {
+      using Dtype = typename std::decay_t<decltype(spec)>::dtype;
+      if constexpr (is_container_v<Dtype>) {
+        layout.Pad(keys[index], spec, recv[index], out[index],
+                   static_cast<int*>(*length++));
+      } else {
+        // env_id and players.env_id are padded with -1
+        layout.Pad(spec, recv[index], out[index],
+                   static_cast<Dtype>(index < 2 ? -1 : 0));
+      }
+      ++index;
+    };
+    std::apply([&](auto&&... spec) { (pad(spec), ...); },
+               envpool->spec.state_spec.AllValues());
+    layout.Mask(rows, player_rows, length[0], length[1]);
   }
 
   static void Cpu(EnvPool* envpool, const In& in, const Out& out) {
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
-    std::vector<Array> recv = envpool->Recv();
-    for (std::size_t i = 0; i < recv.size(); ++i) {
-      CHECK_LE(recv[i].Shape(0), batch_size * max_num_players);
-      std::memcpy(out[i], recv[i].Data(), recv[i].size * recv[i].element_size);
-    }
+    Pad(envpool, envpool->Recv(), out.data());
   }
 
   static void Gpu(EnvPool* envpool, cudaStream_t stream, const In& in,
                   const Out& out) {
-    int batch_size = envpool->spec.config["batch_size"_];
-    int max_num_players = envpool->spec.config["max_num_players"_];
-    std::vector<Array> recv = envpool->Recv();
-    for (std::size_t i = 0; i < recv.size(); ++i) {
-      CHECK_LE(recv[i].Shape(0), batch_size * max_num_players);
-      cudaMemcpyAsync(out[i], recv[i].Data(),
-                      recv[i].size * recv[i].element_size,
+    std::vector<Array> host;
+    std::apply([&](auto&&... spec) { (host.emplace_back(spec), ...); },
+               XlaRecvSpecs(envpool));
+    std::vector<void*> buffers;
+    for (auto& arr : host) {
+      buffers.push_back(arr.Data());
+    }
+    Pad(envpool, envpool->Recv(), buffers.data());
+    for (std::size_t i = 0; i < host.size(); ++i) {
+      cudaMemcpyAsync(out[i], host[i].Data(),
+                      host[i].size * host[i].element_size,
                       cudaMemcpyHostToDevice, stream);
     }
   }
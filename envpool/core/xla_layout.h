@@ -0,0 +1,239 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_CORE_XLA_LAYOUT_H_
+#define ENVPOOL_CORE_XLA_LAYOUT_H_
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "envpool/core/array.h"
+
+template <typename D>
+constexpr bool is_container_v = false;  // NOLINT
+template <typename D>
+constexpr bool is_container_v<Container<D>> = true;  // NOLINT
+
+/**
+ * Static layout of the states and actions exchanged with XLA, which only
+ * knows static shapes. A batch is padded to its largest size:
+ *
+ * 1. player dims (a leading -1) to batch_size * max_num_players rows, the
+ *    others to batch_size rows;
+ * 2. a Container state along the leading dynamic dim of its elements to
+ *    container_size, the actual length goes to an extra int state;
+ * 3. two extra bool states, the env mask and the player mask, tell which
+ *    rows are valid.
+ *
+ * Padded rows of "env_id" and "players.env_id" hold -1, which is how the
+ * padded rows of an action are told apart; all other padding is zero.
+ */
+struct XlaLayout {
+  int batch_size;
+  int max_num_players;
+  int container_size;
+
+  static bool IsPlayer(const std::vector<int>& shape) {
+    return !shape.empty() && shape[0] == -1;
+  }
+
+  static std::size_t Prod(const std::vector<int>& shape) {
+    return std::accumulate(shape.begin(), shape.end(), std::size_t(1),
+                           std::multiplies<>());
+  }
+
+  [[nodiscard]] int Rows(const std::vector<int>& shape) const {
+    return IsPlayer(shape) ? batch_size * max_num_players : batch_size;
+  }
+
+  template <typename D>
+  [[nodiscard]] Spec<D> Normalize(const Spec<D>& spec) const {
+    std::vector<int> shape({Rows(spec.shape)});
+    shape.insert(shape.end(), spec.shape.begin() + (IsPlayer(spec.shape)),
+                 spec.shape.end());
+    return Spec<D>(shape);
+  }
+
+  template <typename D>
+  [[nodiscard]] Spec<D> Normalize(const Spec<Container<D>>& spec) const {
+    Spec<D> ret = Normalize(Spec<D>(spec.shape));
+    std::vector<int> inner = spec.inner_spec.shape;
+    if (!inner.empty() && inner[0] == -1) {
+      inner[0] = container_size;
+    }
+    ret.shape.insert(ret.shape.end(), inner.begin(), inner.end());
+    return ret;
+  }
+
+  /**
+   * Spec of the lengths of a Container state, one per element; nothing for
+   * the other states.
+   */
+  template <typename D>
+  [[nodiscard]] std::tuple<> LengthSpec(const Spec<D>& /*spec*/) const {
+    return {};
+  }
+
+  template <typename D>
+  [[nodiscard]] std::tuple<Spec<int>> LengthSpec(
+      const Spec<Container<D>>& spec) const {
+    return std::make_tuple(Normalize(Spec<int>(spec.shape)));
+  }
+
+  [[nodiscard]] std::tuple<Spec<bool>, Spec<bool>> MaskSpecs() const {
+    return std::make_tuple(Spec<bool>({batch_size}),
+                           Spec<bool>({batch_size * max_num_players}));
+  }
+
+  /**
+   * Throw if a state cannot be given a static shape.
+   */
+  template <typename... T>
+  void Check(const std::tuple<T...>& state_spec) const {
+    std::apply([&](auto&&... spec) { (CheckSpec(spec), ...); }, state_spec);
+  }
+
+  template <typename D>
+  void CheckSpec(const Spec<D>& spec) const {
+    if (std::any_of(spec.shape.begin() + (IsPlayer(spec.shape)),
+                    spec.shape.end(), [](int s) { return s == -1; })) {
+      throw std::runtime_error(
+          "State of this env has dynamic (-1) shape, xla is disabled");
+    }
+  }
+
+  template <typename D>
+  void CheckSpec(const Spec<Container<D>>& spec) const {
+    CheckSpec(Spec<D>(spec.shape));
+    const auto& inner = spec.inner_spec.shape;
+    if (std::any_of(inner.begin() + (!inner.empty()), inner.end(),
+                    [](int s) { return s == -1; })) {
+      throw std::runtime_error(
+          "State of this env has a container with dynamic (-1) shape other "
+          "than the leading dim, xla is disabled");
+    }
+    if (!inner.empty() && inner[0] == -1 && container_size <= 0) {
+      throw std::runtime_error(
+          "State of this env has dynamic shaped container, set "
+          "xla_container_size to enable xla");
+    }
+  }
+
+  /**
+   * Copy a batch `src` of a state returned by Recv to the padded buffer
+   * `dst`, filling the rest with `fill`.
+   */
+  template <typename D>
+  void Pad(const Spec<D>& spec, const Array& src, void* dst, D fill) const {
+    auto* out = static_cast<D*>(dst);
+    std::size_t total = Prod(Normalize(spec).shape);
+    CHECK_LE(src.size, total);
+    std::memcpy(out, src.Data(), src.size * sizeof(D));
+    std::fill(out + src.size, out + total, fill);
+  }
+
+  /**
+   * Copy a batch `src` of the Container state `key` returned by Recv to the
+   * padded buffer `dst` and the leading dim of each element to `length`.
+   * Throw if an element does not fit in xla_container_size.
+   */
+  template <typename D>
+  void Pad(const std::string& key, const Spec<Container<D>>& spec,
+           const Array& src, void* dst, int* length) const {
+    auto* out = static_cast<D*>(dst);
+    auto padded = Normalize(spec);
+    std::size_t num = Prod(Normalize(Spec<int>(spec.shape)).shape);
+    std::size_t cap = Prod(padded.shape) / num;
+    std::fill(out, out + num * cap, D());
+    std::fill(length, length + num, 0);
+    const auto* elems = static_cast<const Container<D>*>(src.Data());
+    for (std::size_t i = 0; i < src.size; ++i) {
+      if (elems[i] == nullptr) {
+        continue;
+      }
+      const Array& elem = *elems[i];
+      if (elem.size > cap) {
+        throw std::runtime_error(
+            "Container state \"" + key + "\" has an element of " +
+            std::to_string(elem.size) + " values, more than the " +
+            std::to_string(cap) + " which fit in xla_container_size = " +
+            std::to_string(container_size));
+      }
+      std::memcpy(out + i * cap, elem.Data(), elem.size * sizeof(D));
+      length[i] = elem.ndim > 0 ? static_cast<int>(elem.Shape(0)) : 1;
+    }
+  }
+
+  /**
+   * Mark the first `rows` envs and the first `player_rows` players valid.
+   */
+  void Mask(std::size_t rows, std::size_t player_rows, void* mask,
+            void* players_mask) const {
+    auto* m = static_cast<bool*>(mask);
+    auto* pm = static_cast<bool*>(players_mask);
+    std::fill(m, m + batch_size, false);
+    std::fill(m, m + rows, true);
+    std::fill(pm, pm + batch_size * max_num_players, false);
+    std::fill(pm, pm + player_rows, true);
+  }
+
+  /**
+   * Drop the padded rows of an action, i.e. the envs whose env_id and the
+   * players whose players.env_id is negative. With a single player per env,
+   * the players follow the envs.
+   */
+  [[nodiscard]] std::vector<Array> Unpad(
+      std::vector<Array> action, const std::vector<bool>& is_player) const {
+    auto valid = [](const Array& ids) {
+      std::vector<std::size_t> rows;
+      const int* id = static_cast<const int*>(ids.Data());
+      for (std::size_t i = 0; i < ids.Shape(0); ++i) {
+        if (id[i] >= 0) {
+          rows.push_back(i);
+        }
+      }
+      return rows;
+    };
+    auto env_rows = valid(action[0]);
+    auto player_rows = max_num_players == 1 ? env_rows : valid(action[1]);
+    for (std::size_t i = 0; i < action.size(); ++i) {
+      const auto& rows = is_player[i] ? player_rows : env_rows;
+      if (rows.size() == action[i].Shape(0)) {
+        continue;
+      }
+      std::vector<int> shape(action[i].Shape().begin(),
+                             action[i].Shape().end());
+      shape[0] = static_cast<int>(rows.size());
+      Array arr(ShapeSpec(static_cast<int>(action[i].element_size), shape));
+      for (std::size_t j = 0; j < rows.size(); ++j) {
+        arr[j].Assign(action[i][rows[j]]);
+      }
+      action[i] = std::move(arr);
+    }
+    return action;
+  }
+};
+
+#endif  // ENVPOOL_CORE_XLA_LAYOUT_H_
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "envpool/core/xla_layout.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+TEST(XlaLayoutTest, Normalize) {
+  XlaLayout layout{4, 3, 5};
+  EXPECT_EQ(layout.Normalize(Spec<float>({2, 3})).shape,
+            std::vector<int>({4, 2, 3}));
+  EXPECT_EQ(layout.Normalize(Spec<int>({})).shape, std::vector<int>({4}));
+  EXPECT_EQ(layout.Normalize(Spec<int>({-1, 7})).shape,
+            std::vector<int>({12, 7}));
+  Spec<Container<int>> dyn({-1}, Spec<int>({-1, 2}));
+  EXPECT_EQ(layout.Normalize(dyn).shape, std::vector<int>({12, 5, 2}));
+  EXPECT_EQ(std::get<0>(layout.LengthSpec(dyn)).shape,
+            std::vector<int>({12}));
+  EXPECT_EQ(std::tuple_size_v<decltype(layout.LengthSpec(Spec<int>({})))>,
+            0);
+}
+
+TEST(XlaLayoutTest, Check) {
+  auto spec = std::make_tuple(Spec<int>({-1, 2}),
+                              Spec<Container<int>>({-1}, Spec<int>({-1, 2})));
+  EXPECT_NO_THROW((XlaLayout{4, 3, 5}.Check(spec)));
+  EXPECT_THROW((XlaLayout{4, 3, 0}.Check(spec)), std::runtime_error);
+  EXPECT_THROW((XlaLayout{4, 3, 5}.Check(std::make_tuple(Spec<int>({2, -1})))),
+               std::runtime_error);
+  EXPECT_THROW((XlaLayout{4, 3, 5}.Check(std::make_tuple(
+                   Spec<Container<int>>({}, Spec<int>({2, -1}))))),
+               std::runtime_error);
+}
+
+TEST(XlaLayoutTest, PadState) {
+  XlaLayout layout{4, 3, 5};
+  Spec<int> player_spec({-1, 2});
+  Array src(Spec<int>({3, 2}));
+  for (int i = 0; i < 6; ++i) {
+    static_cast<int*>(src.Data())[i] = i + 1;
+  }
+  std::vector<int> out(24, 7);
+  layout.Pad(player_spec, src, out.data(), -1);
+  for (int i = 0; i < 24; ++i) {
+    EXPECT_EQ(out[i], i < 6 ? i + 1 : -1);
+  }
+  bool mask[4];
+  bool players_mask[12];
+  layout.Mask(2, 3, mask, players_mask);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(mask[i], i < 2);
+  }
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_EQ(players_mask[i], i < 3);
+  }
+}
+
+TEST(XlaLayoutTest, PadContainer) {
+  XlaLayout layout{2, 2, 3};
+  Spec<Container<int>> spec({-1}, Spec<int>({-1, 2}));
+  Array src(Spec<Container<int>>({3}, spec.inner_spec));
+  auto* elems = static_cast<Container<int>*>(src.Data());
+  for (int i = 0; i < 3; ++i) {
+    new (elems + i) Container<int>(nullptr);
+  }
+  for (int i = 0; i < 2; ++i) {
+    elems[i].reset(new TArray<int>(Spec<int>({i + 1, 2})));
+    elems[i]->Fill(i + 1);
+  }
+  std::vector<int> out(4 * 3 * 2, 9);
+  std::vector<int> length(4, 9);
+  layout.Pad("obs:dyn", spec, src, out.data(), length.data());
+  EXPECT_EQ(length, std::vector<int>({1, 2, 0, 0}));
+  EXPECT_EQ(out, std::vector<int>({1, 1, 0, 0, 0, 0, 2, 2, 2, 2, 0, 0,
+                                   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}));
+  // an element longer than xla_container_size
+  elems[2].reset(new TArray<int>(Spec<int>({4, 2})));
+  try {
+    layout.Pad("obs:dyn", spec, src, out.data(), length.data());
+    ADD_FAILURE() << "Pad did not throw";
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ(std::string(e.what()),
+              "Container state \"obs:dyn\" has an element of 8 values, more "
+              "than the 6 which fit in xla_container_size = 3");
+  }
+  for (int i = 0; i < 3; ++i) {
+    elems[i].~Container<int>();
+  }
+}
+
+TEST(XlaLayoutTest, Unpad) {
+  XlaLayout layout{3, 2, 0};
+  std::vector<Array> action;
+  action.emplace_back(Spec<int>({3}));
+  action.emplace_back(Spec<int>({6}));
+  action.emplace_back(Spec<float>({3, 2}));
+  action.emplace_back(Spec<int>({6}));
+  std::vector<int> env_id({4, -1, 1});
+  std::vector<int> player_env_id({4, 4, 1, -1, -1, -1});
+  action[0].Assign(env_id.data(), env_id.size());
+  action[1].Assign(player_env_id.data(), player_env_id.size());
+  for (int i = 0; i < 6; ++i) {
+    static_cast<float*>(action[2].Data())[i] = static_cast<float>(i);
+    static_cast<int*>(action[3].Data())[i] = 10 + i;
+  }
+  auto ret = layout.Unpad(action, {false, true, false, true});
+  ASSERT_EQ(ret[0].Shape(0), 2);
+  EXPECT_EQ(static_cast<int>(ret[0][0]), 4);
+  EXPECT_EQ(static_cast<int>(ret[0][1]), 1);
+  ASSERT_EQ(ret[1].Shape(0), 3);
+  EXPECT_EQ(static_cast<int>(ret[1][2]), 1);
+  ASSERT_EQ(ret[2].Shape(), std::vector<std::size_t>({2, 2}));
+  EXPECT_EQ(static_cast<float>(ret[2](1, 0)), 4.0F);
+  EXPECT_EQ(static_cast<float>(ret[2](1, 1)), 5.0F);
+  ASSERT_EQ(ret[3].Shape(0), 3);
+  EXPECT_EQ(static_cast<int>(ret[3][2]), 12);
+  // a full batch is passed through
+  env_id = {0, 1, 2};
+  action[0].Assign(env_id.data(), env_id.size());
+  player_env_id = {0, 1, 1, 2, 2, 2};
+  action[1].Assign(player_env_id.data(), player_env_id.size());
+  ret = layout.Unpad(action, {false, true, false, true});
+  EXPECT_EQ(ret[2].Data(), action[2].Data());
+}
@@ -15,6 +15,7 @@
 #ifndef ENVPOOL_DUMMY_DUMMY_ENVPOOL_H_
 #define ENVPOOL_DUMMY_DUMMY_ENVPOOL_H_
 
+#include <algorithm>
 #include <memory>
 
 #include "envpool/core/async_envpool.h"
@@ -123,11 +124,7 @@ class DummyEnv : public Env<DummyEnvSpec> {
    * rom etc.
    */
   DummyEnv(const Spec& spec, int env_id)
-      : Env<DummyEnvSpec>(spec, env_id), state_(0) {
-    if (seed_ < 1) {
-      seed_ = 1;
-    }
-  }
+      : Env<DummyEnvSpec>(spec, env_id), state_(0) {}
 
   /**
    * Reset this single env, this has the same meaning as the openai gym's reset
@@ -210,10 +207,17 @@ class DummyEnv : public Env<DummyEnvSpec> {
     }
   }
 
+  /**
+   * Continue the episode of another env, which enables `Branch`. Here the
+   * state is only the step counter.
+   */
+  void CopyStateFrom(const DummyEnv& other) { state_ = other.state_; }
+
   /**
    * Whether the single env has ended the current episode.
    */
-  bool IsDone() override { return state_ >= seed_; }
+  // the episode length is the seed, at least 1
+  bool IsDone() override { return state_ >= std::max(seed_, 1); }
 };
 
 /**
@@ -17,7 +17,11 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <random>
+#include <thread>
+#include <tuple>
 #include <vector>
 
 using DummyAction = typename dummy::DummyEnv::Action;
@@ -111,6 +115,487 @@ TEST(DummyEnvPoolTest, SplitZeroAction) {
   }
 }
 
+TEST(DummyEnvPoolTest, ResetWithSeed) {
+  // the seed of dummy env is its episode length
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 3;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = num_envs;
+  config["num_threads"_] = 2;
+  config["seed"_] = 40;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  Array seeds(Spec<int>({num_envs}));
+  std::vector<int> length({3, 5, 4});
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+    seeds[i] = length[i];
+  }
+  EXPECT_THROW(envpool.Reset(env_ids, seeds.Slice(0, 1)),
+               std::invalid_argument);
+  envpool.Reset(env_ids, seeds);
+  auto list_action = Array(Spec<double>({num_envs, 6}));
+  std::vector<int> counter(num_envs, -1);
+  // the new seeds are kept by the following auto-resets
+  for (int iter = 0; iter < 30; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    for (int i = 0; i < num_envs; ++i) {
+      ++counter[i];
+      EXPECT_EQ(static_cast<int>(state["elapsed_step"_][i]), counter[i]);
+      EXPECT_EQ(static_cast<bool>(state["done"_][i]), counter[i] == length[i]);
+      if (counter[i] == length[i]) {
+        counter[i] = -1;
+      }
+    }
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:players.env_id"_];
+    action["list_action"_] = list_action;
+    action["players.action"_] = state["info:players.id"_];
+    action["players.id"_] = state["info:players.id"_];
+    envpool.Send(action);
+  }
+}
+
+TEST(DummyEnvPoolTest, Branch) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 3;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = num_envs;
+  config["num_threads"_] = 2;
+  config["seed"_] = 40;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  auto make_action = [](const Array& env_id) {
+    int n = env_id.Shape(0);
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = env_id;
+    action["players.env_id"_] = env_id;
+    action["list_action"_] = Array(Spec<double>({n, 6}));
+    action["players.action"_] = Array(Spec<int>({n}));
+    action["players.id"_] = Array(Spec<int>({n}));
+    return raw_action;
+  };
+  envpool.Recv();
+  envpool.Send(make_action(env_ids));
+  envpool.Recv();
+  int num_branches = 5;
+  int horizon = 4;
+  Array branch_ids(Spec<int>({num_branches * horizon}));
+  branch_ids.Fill(1);
+  EXPECT_THROW(envpool.Branch(1, 3, make_action(branch_ids)),
+               std::invalid_argument);
+  for (int iter = 0; iter < 2; ++iter) {
+    auto state_vec = envpool.Branch(1, horizon, make_action(branch_ids));
+    DummyState state(&state_vec);
+    ASSERT_EQ(state["info:env_id"_].Shape(0), num_branches * horizon);
+    for (int k = 0; k < num_branches; ++k) {
+      for (int h = 0; h < horizon; ++h) {
+        int row = k * horizon + h;
+        EXPECT_EQ(static_cast<int>(state["info:env_id"_][row]), 1);
+        EXPECT_EQ(static_cast<int>(state["elapsed_step"_][row]), h + 2);
+        EXPECT_EQ(static_cast<int>(state["obs:raw"_](row, 0)), h + 2);
+      }
+    }
+  }
+  // the branched env itself is untouched
+  envpool.Send(make_action(env_ids));
+  auto state_vec = envpool.Recv();
+  DummyState state(&state_vec);
+  for (int i = 0; i < num_envs; ++i) {
+    EXPECT_EQ(static_cast<int>(state["elapsed_step"_][i]), 2);
+  }
+}
+
+TEST(DummyEnvPoolTest, BranchAfterRecv) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 8;
+  int batch = 3;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = batch;
+  config["num_threads"_] = 4;
+  config["seed"_] = 40;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  auto make_action = [](const Array& env_id) {
+    int n = env_id.Shape(0);
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = env_id;
+    action["players.env_id"_] = env_id;
+    action["list_action"_] = Array(Spec<double>({n, 6}));
+    action["players.action"_] = Array(Spec<int>({n}));
+    action["players.id"_] = Array(Spec<int>({n}));
+    return raw_action;
+  };
+  envpool.Reset(env_ids);
+  Array branch_ids(Spec<int>({1}));
+  for (int iter = 0; iter < 2000; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    // an env is never in flight once received
+    auto in_flight = envpool.InFlight();
+    for (int i = 0; i < batch; ++i) {
+      int env_id = state["info:env_id"_][i];
+      ASSERT_FALSE(in_flight[env_id]);
+      branch_ids.Fill(env_id);
+      EXPECT_NO_THROW(envpool.Branch(env_id, 1, make_action(branch_ids)));
+    }
+    envpool.Send(make_action(state["info:env_id"_]));
+  }
+}
+
+TEST(DummyEnvPoolTest, SetNumThreads) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["num_threads"_] = 2;
+  config["elastic_threads"_] = true;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  EXPECT_EQ(envpool.NumActiveThreads(), 2);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  auto list_action = Array(Spec<double>({num_envs, 6}));
+  auto run = [&](int num_iter, std::chrono::milliseconds pause) {
+    for (int iter = 0; iter < num_iter; ++iter) {
+      auto state_vec = envpool.Recv();
+      DummyState state(&state_vec);
+      ASSERT_EQ(state["info:env_id"_].Shape(0), num_envs);
+      std::this_thread::sleep_for(pause);
+      if (pause.count() > 0) {
+        // a full batch is sent after every pause, which needs all workers
+        EXPECT_EQ(envpool.NumActiveThreads(), 4);
+      }
+      std::vector<Array> raw_action(5);
+      DummyAction action(&raw_action);
+      action["env_id"_] = state["info:env_id"_];
+      action["players.env_id"_] = state["info:players.env_id"_];
+      action["list_action"_] = list_action;
+      action["players.action"_] = state["info:players.id"_];
+      action["players.id"_] = state["info:players.id"_];
+      envpool.Send(action);
+    }
+  };
+  run(100, std::chrono::milliseconds(0));
+  EXPECT_THROW(envpool.SetNumThreads(0), std::invalid_argument);
+  envpool.SetNumThreads(1);
+  EXPECT_EQ(envpool.NumActiveThreads(), 1);
+  run(100, std::chrono::milliseconds(0));
+  envpool.SetNumThreads(4);
+  EXPECT_EQ(envpool.NumActiveThreads(), 4);
+  run(100, std::chrono::milliseconds(0));
+  // a slow learner does not shrink the pool
+  run(10, std::chrono::milliseconds(50));
+  EXPECT_EQ(envpool.NumActiveThreads(), 4);
+  run(100, std::chrono::milliseconds(0));
+  envpool.Recv();
+}
+
+class ChunkSizeProbe : public dummy::DummyEnvPool {
+ public:
+  explicit ChunkSizeProbe(const dummy::DummyEnvSpec& spec)
+      : dummy::DummyEnvPool(spec) {}
+  [[nodiscard]] std::size_t MaxChunkSize() const { return max_chunk_size_; }
+};
+
+TEST(DummyEnvPoolTest, SetNumThreadsChunkSize) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  config["num_envs"_] = 64;
+  config["num_threads"_] = 2;
+  dummy::DummyEnvSpec spec(config);
+  ChunkSizeProbe envpool(spec);
+  EXPECT_EQ(envpool.MaxChunkSize(), 32);
+  envpool.SetNumThreads(8);
+  EXPECT_EQ(envpool.MaxChunkSize(), 8);
+  // an explicit max_chunk_size is kept
+  config["max_chunk_size"_] = 3;
+  dummy::DummyEnvSpec fixed_spec(config);
+  ChunkSizeProbe fixed(fixed_spec);
+  fixed.SetNumThreads(8);
+  EXPECT_EQ(fixed.MaxChunkSize(), 3);
+}
+
+TEST(DummyEnvPoolTest, ElasticThreads) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = 1;
+  config["num_threads"_] = 4;
+  config["elastic_threads"_] = true;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  auto list_action = Array(Spec<double>({1, 6}));
+  // one action at a time keeps a single worker busy, the others are parked
+  // one by one
+  for (int iter = 0; iter < 20; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    ASSERT_EQ(state["info:env_id"_].Shape(0), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:players.env_id"_];
+    action["list_action"_] = list_action;
+    action["players.action"_] = state["info:players.id"_];
+    action["players.id"_] = state["info:players.id"_];
+    envpool.Send(action);
+  }
+  EXPECT_LE(envpool.NumActiveThreads(), 2);
+  EXPECT_GE(envpool.NumActiveThreads(), 1);
+  // a reset of every env wakes up enough workers at once
+  for (int i = 0; i < num_envs; ++i) {
+    envpool.Recv();
+  }
+  envpool.Reset(env_ids);
+  EXPECT_EQ(envpool.NumActiveThreads(), 4);
+  for (int i = 0; i < num_envs; ++i) {
+    envpool.Recv();
+  }
+}
+
+TEST(DummyEnvPoolTest, Throttle) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["max_fps"_] = 2000.0;
+  config["cpu_quota"_] = 1.5;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  // num_threads defaults to the cores allowed by cpu_quota
+  EXPECT_EQ(envpool.NumActiveThreads(),
+            std::min(2U, std::thread::hardware_concurrency()));
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  auto start = std::chrono::steady_clock::now();
+  envpool.Reset(env_ids);
+  auto list_action = Array(Spec<double>({num_envs, 6}));
+  int num_iter = 100;
+  for (int iter = 0; iter < num_iter; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:players.env_id"_];
+    action["list_action"_] = list_action;
+    action["players.action"_] = state["info:players.id"_];
+    action["players.id"_] = state["info:players.id"_];
+    envpool.Send(action);
+  }
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  // 400 steps at 2000 fps, minus the 20 steps of burst
+  EXPECT_GE(elapsed, 0.18);
+  auto [elapsed_ns, num_steps, step_throttled_ns, busy_ns, cpu_throttled_ns] =
+      envpool.ThrottleStats();
+  EXPECT_GE(elapsed_ns, elapsed * 1e9);
+  EXPECT_GE(num_steps, num_envs * num_iter);
+  EXPECT_GT(step_throttled_ns, 0);
+  EXPECT_GT(busy_ns, 0);
+  EXPECT_LT(busy_ns, elapsed_ns * 1.5);
+}
+
+TEST(DummyEnvPoolTest, Gauges) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = 2;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  envpool.Recv();
+  // the second batch is written while the consumer is away
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto [action_queue, num_partial, num_ready, num_stock] = envpool.Gauges();
+  EXPECT_EQ(action_queue, 0);
+  EXPECT_EQ(num_partial, 0);
+  EXPECT_EQ(num_ready, 1);
+  EXPECT_GT(num_stock, 0);
+  EXPECT_EQ(envpool.InFlight(), std::vector<bool>(num_envs, false));
+  envpool.Recv();
+  EXPECT_EQ(std::get<2>(envpool.Gauges()), 0);
+}
+
+TEST(DummyEnvPoolTest, UserState) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  int batch = 2;
+  int size = 3;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = batch;
+  config["num_threads"_] = 2;
+  config["seed"_] = 2;
+  config["user_state_size"_] = size;
+  dummy::DummyEnvSpec spec(config);
+  EXPECT_EQ(spec.state_spec["info:user_state"_].shape, std::vector<int>{size});
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  auto list_action = Array(Spec<double>({batch, 6}));
+  // the payload last sent to each env
+  std::vector<float> sent(num_envs, 0);
+  int num_reset = 0;
+  for (int iter = 0; iter < 100; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    Array user_state(Spec<float>({batch, size}));
+    for (int i = 0; i < batch; ++i) {
+      int env_id = state["info:env_id"_][i];
+      bool first = static_cast<int>(state["elapsed_step"_][i]) == 0;
+      num_reset += first;
+      for (int j = 0; j < size; ++j) {
+        // zeroed when an episode starts, or the payload sent with the step
+        EXPECT_EQ(static_cast<float>(state["info:user_state"_](i, j)),
+                  first ? 0 : sent[env_id] + j);
+        user_state(i, j) = static_cast<float>(iter * 10 + j);
+      }
+      sent[env_id] = static_cast<float>(iter * 10);
+    }
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:players.env_id"_];
+    action["list_action"_] = list_action;
+    action["players.action"_] = state["info:players.id"_];
+    action["players.id"_] = state["info:players.id"_];
+    envpool.Send(action, user_state);
+  }
+  EXPECT_GT(num_reset, num_envs);
+  Array wrong(Spec<float>({batch, size + 1}));
+  auto state_vec = envpool.Recv();
+  DummyState state(&state_vec);
+  std::vector<Array> raw_action(5);
+  DummyAction action(&raw_action);
+  action["env_id"_] = state["info:env_id"_];
+  action["players.env_id"_] = state["info:players.env_id"_];
+  action["list_action"_] = list_action;
+  action["players.action"_] = state["info:players.id"_];
+  action["players.id"_] = state["info:players.id"_];
+  EXPECT_THROW(envpool.Send(action, wrong), std::invalid_argument);
+}
+
+TEST(DummyEnvPoolTest, ShrinkingBatch) {
+  for (bool deterministic : {false, true}) {
+    auto config = dummy::DummyEnvSpec::kDefaultConfig;
+    int num_envs = 5;
+    config["num_envs"_] = num_envs;
+    config["batch_size"_] = 3;
+    config["num_threads"_] = 2;
+    config["deterministic_async"_] = deterministic;
+    dummy::DummyEnvSpec spec(config);
+    dummy::DummyEnvPool envpool(spec);
+    Array env_ids(Spec<int>({num_envs}));
+    for (int i = 0; i < num_envs; ++i) {
+      env_ids[i] = i;
+    }
+    envpool.Reset(env_ids);
+    // only the first env of each batch keeps being stepped, so the number of
+    // envs in flight drops below batch_size: 5 -> 2 + 1 -> 1
+    std::vector<int> batch_sizes;
+    for (int iter = 0; iter < 4; ++iter) {
+      auto state_vec = envpool.Recv();
+      DummyState state(&state_vec);
+      int batch = state["info:env_id"_].Shape(0);
+      batch_sizes.push_back(batch);
+      std::vector<Array> raw_action(5);
+      DummyAction action(&raw_action);
+      action["env_id"_] = state["info:env_id"_].Slice(0, 1);
+      action["players.env_id"_] = state["info:players.env_id"_].Slice(0, 1);
+      action["list_action"_] = Array(Spec<double>({1, 6}));
+      action["players.action"_] = state["info:players.id"_].Slice(0, 1);
+      action["players.id"_] = state["info:players.id"_].Slice(0, 1);
+      envpool.Send(action);
+    }
+    EXPECT_EQ(batch_sizes, std::vector<int>({3, 3, 1, 1}));
+  }
+}
+
+std::vector<std::vector<int>> DeterministicRun(int num_threads) {
+  auto config = dummy::DummyEnvSpec::kDefaultConfig;
+  int num_envs = 9;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = 4;
+  config["num_threads"_] = num_threads;
+  config["max_num_players"_] = 3;
+  config["deterministic_async"_] = true;
+  dummy::DummyEnvSpec spec(config);
+  dummy::DummyEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  auto list_action = Array(Spec<double>({num_envs, 6}));
+  std::vector<std::vector<int>> batches;
+  for (int iter = 0; iter < 200; ++iter) {
+    auto state_vec = envpool.Recv();
+    DummyState state(&state_vec);
+    std::vector<int> batch;
+    for (std::size_t i = 0; i < state["info:env_id"_].Shape(0); ++i) {
+      batch.push_back(state["info:env_id"_][i]);
+      batch.push_back(state["elapsed_step"_][i]);
+      batch.push_back(static_cast<bool>(state["done"_][i]));
+    }
+    for (std::size_t i = 0; i < state["info:players.env_id"_].Shape(0); ++i) {
+      batch.push_back(state["info:players.env_id"_][i]);
+    }
+    batches.push_back(batch);
+    std::vector<Array> raw_action(5);
+    DummyAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:players.env_id"_];
+    action["list_action"_] = list_action;
+    action["players.action"_] = state["info:players.id"_];
+    action["players.id"_] = state["info:players.id"_];
+    envpool.Send(action);
+  }
+  return batches;
+}
+
+TEST(DummyEnvPoolTest, DeterministicAsync) {
+  auto batches = DeterministicRun(1);
+  EXPECT_EQ(batches, DeterministicRun(4));
+  EXPECT_EQ(batches, DeterministicRun(9));
+  // the first batch holds the envs 0 to 3 of the initial reset
+  ASSERT_GE(batches[0].size(), 12);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(batches[0][i * 3], i);
+  }
+}
+
 void Runner(int num_envs, int batch, int seed, int total_iter, int num_threads,
             int max_num_players) {
   LOG(INFO) << num_envs << " " << batch << " " << seed << " " << total_iter
@@ -38,6 +38,15 @@ class _DummyEnvPoolTest(absltest.TestCase):
       "state_num",
       "action_num",
       "max_episode_steps",
+      "frame_stack",
+      "env_priority",
+      "max_chunk_size",
+      "elastic_threads",
+      "max_fps",
+      "cpu_quota",
+      "deterministic_async",
+      "user_state_size",
+      "xla_container_size",
     ]
     default_conf = _DummyEnvSpec._default_config_values
     self.assertTrue(isinstance(default_conf, tuple))
@@ -102,6 +111,7 @@ class _DummyEnvPoolTest(absltest.TestCase):
     conf["num_envs"] = 100
     conf["batch_size"] = 31
     conf["num_threads"] = os.cpu_count()
+    conf["max_num_players"] = 4
     env_spec = _DummyEnvSpec(tuple(conf.values()))
     env = _DummyEnvPool(env_spec)
     xla_failed = False
@@ -109,11 +119,27 @@ class _DummyEnvPoolTest(absltest.TestCase):
       _ = env._xla()
     except RuntimeError:
       logging.info(
-        "XLA on Dummy failed because dummy has Container typed state."
+        "XLA on Dummy failed because its container has no declared size."
       )
       xla_failed = True
     self.assertTrue(xla_failed)
-
+    # with a declared container size, states are padded to a static layout
+    conf["xla_container_size"] = 100
+    env_spec = _DummyEnvSpec(tuple(conf.values()))
+    env = _DummyEnvPool(env_spec)
+    (_, (_, (_, out_specs), _)), _ = env._xla()
+    state_keys = env._state_keys
+    # handle, states, the length of obs:dyn, env mask and player mask
+    self.assertEqual(len(out_specs), 1 + len(state_keys) + 3)
+    shapes = dict(zip(state_keys, [s[1] for s in out_specs[1:]]))
+    self.assertEqual(shapes["info:env_id"], [31])
+    self.assertEqual(shapes["info:players.env_id"], [124])
+    self.assertEqual(shapes["obs:raw"], [124, conf["state_num"]])
+    self.assertEqual(shapes["obs:dyn"], [124, 100, conf["state_num"]])
+    self.assertEqual(out_specs[-3][1], [124])
+    self.assertEqual(out_specs[-2][0], np.bool_)
+    self.assertEqual(out_specs[-2][1], [31])
+    self.assertEqual(out_specs[-1][1], [124])
 
 if __name__ == "__main__":
   absltest.main()
@@ -16,131 +16,281 @@
 from envpool.mujoco.mujoco_dmc_envpool import (
   _DmcAcrobotEnvPool,
   _DmcAcrobotEnvSpec,
+  _DmcAcrobotPixelEnvPool,
+  _DmcAcrobotPixelEnvSpec,
   _DmcBallInCupEnvPool,
   _DmcBallInCupEnvSpec,
+  _DmcBallInCupPixelEnvPool,
+  _DmcBallInCupPixelEnvSpec,
   _DmcCartpoleEnvPool,
   _DmcCartpoleEnvSpec,
+  _DmcCartpolePixelEnvPool,
+  _DmcCartpolePixelEnvSpec,
   _DmcCheetahEnvPool,
   _DmcCheetahEnvSpec,
+  _DmcCheetahPixelEnvPool,
+  _DmcCheetahPixelEnvSpec,
   _DmcFingerEnvPool,
   _DmcFingerEnvSpec,
+  _DmcFingerPixelEnvPool,
+  _DmcFingerPixelEnvSpec,
   _DmcFishEnvPool,
   _DmcFishEnvSpec,
+  _DmcFishPixelEnvPool,
+  _DmcFishPixelEnvSpec,
   _DmcHopperEnvPool,
   _DmcHopperEnvSpec,
+  _DmcHopperPixelEnvPool,
+  _DmcHopperPixelEnvSpec,
   _DmcHumanoidCMUEnvPool,
   _DmcHumanoidCMUEnvSpec,
+  _DmcHumanoidCMUPixelEnvPool,
+  _DmcHumanoidCMUPixelEnvSpec,
   _DmcHumanoidEnvPool,
   _DmcHumanoidEnvSpec,
+  _DmcHumanoidPixelEnvPool,
+  _DmcHumanoidPixelEnvSpec,
   _DmcManipulatorEnvPool,
   _DmcManipulatorEnvSpec,
+  _DmcManipulatorPixelEnvPool,
+  _DmcManipulatorPixelEnvSpec,
   _DmcPendulumEnvPool,
   _DmcPendulumEnvSpec,
+  _DmcPendulumPixelEnvPool,
+  _DmcPendulumPixelEnvSpec,
   _DmcPointMassEnvPool,
   _DmcPointMassEnvSpec,
+  _DmcPointMassPixelEnvPool,
+  _DmcPointMassPixelEnvSpec,
   _DmcReacherEnvPool,
   _DmcReacherEnvSpec,
+  _DmcReacherPixelEnvPool,
+  _DmcReacherPixelEnvSpec,
   _DmcSwimmerEnvPool,
   _DmcSwimmerEnvSpec,
+  _DmcSwimmerPixelEnvPool,
+  _DmcSwimmerPixelEnvSpec,
   _DmcWalkerEnvPool,
   _DmcWalkerEnvSpec,
+  _DmcWalkerPixelEnvPool,
+  _DmcWalkerPixelEnvSpec,
 )
 from envpool.python.api import py_env
 
 DmcAcrobotEnvSpec, DmcAcrobotDMEnvPool, DmcAcrobotGymEnvPool = py_env(
   _DmcAcrobotEnvSpec, _DmcAcrobotEnvPool
 )
+(
+  DmcAcrobotPixelEnvSpec,
+  DmcAcrobotPixelDMEnvPool,
+  DmcAcrobotPixelGymEnvPool,
+) = py_env(_DmcAcrobotPixelEnvSpec, _DmcAcrobotPixelEnvPool)
 DmcBallInCupEnvSpec, DmcBallInCupDMEnvPool, DmcBallInCupGymEnvPool = py_env(
   _DmcBallInCupEnvSpec, _DmcBallInCupEnvPool
 )
+(
+  DmcBallInCupPixelEnvSpec,
+  DmcBallInCupPixelDMEnvPool,
+  DmcBallInCupPixelGymEnvPool,
+) = py_env(_DmcBallInCupPixelEnvSpec, _DmcBallInCupPixelEnvPool)
 DmcCartpoleEnvSpec, DmcCartpoleDMEnvPool, DmcCartpoleGymEnvPool = py_env(
   _DmcCartpoleEnvSpec, _DmcCartpoleEnvPool
 )
+(
+  DmcCartpolePixelEnvSpec,
+  DmcCartpolePixelDMEnvPool,
+  DmcCartpolePixelGymEnvPool,
+) = py_env(_DmcCartpolePixelEnvSpec, _DmcCartpolePixelEnvPool)
 DmcCheetahEnvSpec, DmcCheetahDMEnvPool, DmcCheetahGymEnvPool = py_env(
   _DmcCheetahEnvSpec, _DmcCheetahEnvPool
 )
+(
+  DmcCheetahPixelEnvSpec,
+  DmcCheetahPixelDMEnvPool,
+  DmcCheetahPixelGymEnvPool,
+) = py_env(_DmcCheetahPixelEnvSpec, _DmcCheetahPixelEnvPool)
 DmcFingerEnvSpec, DmcFingerDMEnvPool, DmcFingerGymEnvPool = py_env(
   _DmcFingerEnvSpec, _DmcFingerEnvPool
 )
+(
+  DmcFingerPixelEnvSpec,
+  DmcFingerPixelDMEnvPool,
+  DmcFingerPixelGymEnvPool,
+) = py_env(_DmcFingerPixelEnvSpec, _DmcFingerPixelEnvPool)
 DmcFishEnvSpec, DmcFishDMEnvPool, DmcFishGymEnvPool = py_env(
   _DmcFishEnvSpec, _DmcFishEnvPool
 )
+(
+  DmcFishPixelEnvSpec,
+  DmcFishPixelDMEnvPool,
+  DmcFishPixelGymEnvPool,
+) = py_env(_DmcFishPixelEnvSpec, _DmcFishPixelEnvPool)
 DmcHopperEnvSpec, DmcHopperDMEnvPool, DmcHopperGymEnvPool = py_env(
   _DmcHopperEnvSpec, _DmcHopperEnvPool
 )
+(
+  DmcHopperPixelEnvSpec,
+  DmcHopperPixelDMEnvPool,
+  DmcHopperPixelGymEnvPool,
+) = py_env(_DmcHopperPixelEnvSpec, _DmcHopperPixelEnvPool)
 DmcHumanoidEnvSpec, DmcHumanoidDMEnvPool, DmcHumanoidGymEnvPool = py_env(
   _DmcHumanoidEnvSpec, _DmcHumanoidEnvPool
 )
+(
+  DmcHumanoidPixelEnvSpec,
+  DmcHumanoidPixelDMEnvPool,
+  DmcHumanoidPixelGymEnvPool,
+) = py_env(_DmcHumanoidPixelEnvSpec, _DmcHumanoidPixelEnvPool)
 (
   DmcHumanoidCMUEnvSpec,
   DmcHumanoidCMUDMEnvPool,
   DmcHumanoidCMUGymEnvPool,
 ) = py_env(_DmcHumanoidCMUEnvSpec, _DmcHumanoidCMUEnvPool)
+(
+  DmcHumanoidCMUPixelEnvSpec,
+  DmcHumanoidCMUPixelDMEnvPool,
+  DmcHumanoidCMUPixelGymEnvPool,
+) = py_env(_DmcHumanoidCMUPixelEnvSpec, _DmcHumanoidCMUPixelEnvPool)
 (
   DmcManipulatorEnvSpec,
   DmcManipulatorDMEnvPool,
   DmcManipulatorGymEnvPool,
 ) = py_env(_DmcManipulatorEnvSpec, _DmcManipulatorEnvPool)
+(
+  DmcManipulatorPixelEnvSpec,
+  DmcManipulatorPixelDMEnvPool,
+  DmcManipulatorPixelGymEnvPool,
+) = py_env(_DmcManipulatorPixelEnvSpec, _DmcManipulatorPixelEnvPool)
 DmcPendulumEnvSpec, DmcPendulumDMEnvPool, DmcPendulumGymEnvPool = py_env(
   _DmcPendulumEnvSpec, _DmcPendulumEnvPool
 )
+(
+  DmcPendulumPixelEnvSpec,
+  DmcPendulumPixelDMEnvPool,
+  DmcPendulumPixelGymEnvPool,
+) = py_env(_DmcPendulumPixelEnvSpec, _DmcPendulumPixelEnvPool)
 DmcPointMassEnvSpec, DmcPointMassDMEnvPool, DmcPointMassGymEnvPool = py_env(
   _DmcPointMassEnvSpec, _DmcPointMassEnvPool
 )
+(
+  DmcPointMassPixelEnvSpec,
+  DmcPointMassPixelDMEnvPool,
+  DmcPointMassPixelGymEnvPool,
+) = py_env(_DmcPointMassPixelEnvSpec, _DmcPointMassPixelEnvPool)
 DmcReacherEnvSpec, DmcReacherDMEnvPool, DmcReacherGymEnvPool = py_env(
   _DmcReacherEnvSpec, _DmcReacherEnvPool
 )
+(
+  DmcReacherPixelEnvSpec,
+  DmcReacherPixelDMEnvPool,
+  DmcReacherPixelGymEnvPool,
+) = py_env(_DmcReacherPixelEnvSpec, _DmcReacherPixelEnvPool)
 DmcSwimmerEnvSpec, DmcSwimmerDMEnvPool, DmcSwimmerGymEnvPool = py_env(
   _DmcSwimmerEnvSpec, _DmcSwimmerEnvPool
 )
+(
+  DmcSwimmerPixelEnvSpec,
+  DmcSwimmerPixelDMEnvPool,
+  DmcSwimmerPixelGymEnvPool,
+) = py_env(_DmcSwimmerPixelEnvSpec, _DmcSwimmerPixelEnvPool)
 DmcWalkerEnvSpec, DmcWalkerDMEnvPool, DmcWalkerGymEnvPool = py_env(
   _DmcWalkerEnvSpec, _DmcWalkerEnvPool
 )
+(
+  DmcWalkerPixelEnvSpec,
+  DmcWalkerPixelDMEnvPool,
+  DmcWalkerPixelGymEnvPool,
+) = py_env(_DmcWalkerPixelEnvSpec, _DmcWalkerPixelEnvPool)
 
 __all__ = [
   "DmcAcrobotEnvSpec",
   "DmcAcrobotDMEnvPool",
   "DmcAcrobotGymEnvPool",
+  "DmcAcrobotPixelEnvSpec",
+  "DmcAcrobotPixelDMEnvPool",
+  "DmcAcrobotPixelGymEnvPool",
   "DmcBallInCupEnvSpec",
   "DmcBallInCupDMEnvPool",
   "DmcBallInCupGymEnvPool",
+  "DmcBallInCupPixelEnvSpec",
+  "DmcBallInCupPixelDMEnvPool",
+  "DmcBallInCupPixelGymEnvPool",
   "DmcCartpoleEnvSpec",
   "DmcCartpoleDMEnvPool",
   "DmcCartpoleGymEnvPool",
+  "DmcCartpolePixelEnvSpec",
+  "DmcCartpolePixelDMEnvPool",
+  "DmcCartpolePixelGymEnvPool",
   "DmcCheetahEnvSpec",
   "DmcCheetahDMEnvPool",
   "DmcCheetahGymEnvPool",
+  "DmcCheetahPixelEnvSpec",
+  "DmcCheetahPixelDMEnvPool",
+  "DmcCheetahPixelGymEnvPool",
   "DmcFingerEnvSpec",
   "DmcFingerDMEnvPool",
   "DmcFingerGymEnvPool",
+  "DmcFingerPixelEnvSpec",
+  "DmcFingerPixelDMEnvPool",
+  "DmcFingerPixelGymEnvPool",
   "DmcFishEnvSpec",
   "DmcFishDMEnvPool",
   "DmcFishGymEnvPool",
+  "DmcFishPixelEnvSpec",
+  "DmcFishPixelDMEnvPool",
+  "DmcFishPixelGymEnvPool",
   "DmcHopperEnvSpec",
   "DmcHopperDMEnvPool",
   "DmcHopperGymEnvPool",
+  "DmcHopperPixelEnvSpec",
+  "DmcHopperPixelDMEnvPool",
+  "DmcHopperPixelGymEnvPool",
   "DmcHumanoidEnvSpec",
   "DmcHumanoidDMEnvPool",
   "DmcHumanoidGymEnvPool",
+  "DmcHumanoidPixelEnvSpec",
+  "DmcHumanoidPixelDMEnvPool",
+  "DmcHumanoidPixelGymEnvPool",
   "DmcHumanoidCMUEnvSpec",
   "DmcHumanoidCMUDMEnvPool",
   "DmcHumanoidCMUGymEnvPool",
+  "DmcHumanoidCMUPixelEnvSpec",
+  "DmcHumanoidCMUPixelDMEnvPool",
+  "DmcHumanoidCMUPixelGymEnvPool",
   "DmcManipulatorEnvSpec",
   "DmcManipulatorDMEnvPool",
   "DmcManipulatorGymEnvPool",
+  "DmcManipulatorPixelEnvSpec",
+  "DmcManipulatorPixelDMEnvPool",
+  "DmcManipulatorPixelGymEnvPool",
   "DmcPendulumEnvSpec",
   "DmcPendulumDMEnvPool",
   "DmcPendulumGymEnvPool",
+  "DmcPendulumPixelEnvSpec",
+  "DmcPendulumPixelDMEnvPool",
+  "DmcPendulumPixelGymEnvPool",
   "DmcPointMassEnvSpec",
   "DmcPointMassDMEnvPool",
   "DmcPointMassGymEnvPool",
+  "DmcPointMassPixelEnvSpec",
+  "DmcPointMassPixelDMEnvPool",
+  "DmcPointMassPixelGymEnvPool",
   "DmcReacherEnvSpec",
   "DmcReacherDMEnvPool",
   "DmcReacherGymEnvPool",
+  "DmcReacherPixelEnvSpec",
+  "DmcReacherPixelDMEnvPool",
+  "DmcReacherPixelGymEnvPool",
   "DmcSwimmerEnvSpec",
   "DmcSwimmerDMEnvPool",
   "DmcSwimmerGymEnvPool",
+  "DmcSwimmerPixelEnvSpec",
+  "DmcSwimmerPixelDMEnvPool",
+  "DmcSwimmerPixelGymEnvPool",
   "DmcWalkerEnvSpec",
   "DmcWalkerDMEnvPool",
   "DmcWalkerGymEnvPool",
+  "DmcWalkerPixelEnvSpec",
+  "DmcWalkerPixelDMEnvPool",
+  "DmcWalkerPixelGymEnvPool",
 ]
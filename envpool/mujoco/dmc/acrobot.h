@@ -59,21 +59,29 @@ class AcrobotEnvFns {
   }
 };
 
-using AcrobotEnvSpec = EnvSpec<AcrobotEnvFns>;
+using AcrobotEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<AcrobotEnvFns>>;
+using AcrobotPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<AcrobotEnvFns>>>;
+
+template <typename EnvSpec>
+class AcrobotEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class AcrobotEnv : public Env<AcrobotEnvSpec>, public MujocoEnv {
  protected:
   int id_upper_arm_, id_lower_arm_, id_target_, id_tip_, id_shoulder_,
       id_elbow_;
   bool is_sparse_;
 
  public:
-  AcrobotEnv(const Spec& spec, int env_id)
-      : Env<AcrobotEnvSpec>(spec, env_id),
+  AcrobotEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetAcrobotXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_upper_arm_(mj_name2id(model_, mjOBJ_XBODY, "upper_arm")),
         id_lower_arm_(mj_name2id(model_, mjOBJ_XBODY, "lower_arm")),
         id_target_(mj_name2id(model_, mjOBJ_SITE, "target")),
@@ -89,8 +97,8 @@ class AcrobotEnv : public Env<AcrobotEnvSpec>, public MujocoEnv {
   }
 
   void TaskInitializeEpisode() override {
-    data_->qpos[id_shoulder_] = RandUniform(-M_PI, M_PI)(gen_);
-    data_->qpos[id_elbow_] = RandUniform(-M_PI, M_PI)(gen_);
+    data_->qpos[id_shoulder_] = RandUniform(-M_PI, M_PI)(this->gen_);
+    data_->qpos[id_elbow_] = RandUniform(-M_PI, M_PI)(this->gen_);
 #ifdef ENVPOOL_TEST
     std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -118,9 +126,10 @@ class AcrobotEnv : public Env<AcrobotEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& orientations = Orientations();
     state["obs:orientations"_].Assign(orientations.begin(),
@@ -163,7 +172,10 @@ class AcrobotEnv : public Env<AcrobotEnvSpec>, public MujocoEnv {
   }
 };
 
+using AcrobotEnv = AcrobotEnvBase<AcrobotEnvSpec>;
+using AcrobotPixelEnv = AcrobotEnvBase<AcrobotPixelEnvSpec>;
 using AcrobotEnvPool = AsyncEnvPool<AcrobotEnv>;
+using AcrobotPixelEnvPool = AsyncEnvPool<AcrobotPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -58,20 +58,28 @@ class BallInCupEnvFns {
   }
 };
 
-using BallInCupEnvSpec = EnvSpec<BallInCupEnvFns>;
+using BallInCupEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<BallInCupEnvFns>>;
+using BallInCupPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<BallInCupEnvFns>>>;
+
+template <typename EnvSpec>
+class BallInCupEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class BallInCupEnv : public Env<BallInCupEnvSpec>, public MujocoEnv {
  protected:
   int id_target_, id_ball_, id_ball_x_, id_ball_z_;
 
  public:
-  BallInCupEnv(const Spec& spec, int env_id)
-      : Env<BallInCupEnvSpec>(spec, env_id),
+  BallInCupEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetBallInCupXML(spec.config["base_path"_],
                                   spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_target_(mj_name2id(model_, mjOBJ_SITE, "target")),
         id_ball_(mj_name2id(model_, mjOBJ_XBODY, "ball")),
         id_ball_x_(GetQposId(model_, "ball_x")),
@@ -86,8 +94,8 @@ class BallInCupEnv : public Env<BallInCupEnvSpec>, public MujocoEnv {
   void TaskInitializeEpisode() override {
     while (true) {
       // Assign a random ball position.
-      data_->qpos[id_ball_x_] = RandUniform(-0.2, 0.2)(gen_);
-      data_->qpos[id_ball_z_] = RandUniform(0.2, 0.5)(gen_);
+      data_->qpos[id_ball_x_] = RandUniform(-0.2, 0.2)(this->gen_);
+      data_->qpos[id_ball_z_] = RandUniform(0.2, 0.5)(this->gen_);
 #ifdef ENVPOOL_TEST
       std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -117,9 +125,10 @@ class BallInCupEnv : public Env<BallInCupEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:position"_].Assign(data_->qpos, model_->nq);
     state["obs:velocity"_].Assign(data_->qvel, model_->nv);
@@ -153,7 +162,10 @@ class BallInCupEnv : public Env<BallInCupEnvSpec>, public MujocoEnv {
   }
 };
 
+using BallInCupEnv = BallInCupEnvBase<BallInCupEnvSpec>;
+using BallInCupPixelEnv = BallInCupEnvBase<BallInCupPixelEnvSpec>;
 using BallInCupEnvPool = AsyncEnvPool<BallInCupEnv>;
+using BallInCupPixelEnvPool = AsyncEnvPool<BallInCupPixelEnv>;
 
 }  // namespace mujoco_dmc
 
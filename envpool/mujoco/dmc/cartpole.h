@@ -83,9 +83,16 @@ class CartpoleEnvFns {
   }
 };
 
-using CartpoleEnvSpec = EnvSpec<CartpoleEnvFns>;
+using CartpoleEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<CartpoleEnvFns>>;
+using CartpolePixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<CartpoleEnvFns>>>;
+
+template <typename EnvSpec>
+class CartpoleEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class CartpoleEnv : public Env<CartpoleEnvSpec>, public MujocoEnv {
  protected:
   int id_slider_, id_hinge1_;
   bool is_sparse_, is_swingup_;
@@ -95,13 +102,14 @@ class CartpoleEnv : public Env<CartpoleEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  CartpoleEnv(const Spec& spec, int env_id)
-      : Env<CartpoleEnvSpec>(spec, env_id),
+  CartpoleEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetCartpoleXML(spec.config["base_path"_],
                                  spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_slider_(GetQposId(model_, "slider")),
         id_hinge1_(GetQposId(model_, "hinge_1")),
         is_sparse_(spec.config["task_name"_] == "balance_sparse" ||
@@ -117,19 +125,19 @@ class CartpoleEnv : public Env<CartpoleEnvSpec>, public MujocoEnv {
 
   void TaskInitializeEpisode() override {
     if (is_swingup_) {
-      data_->qpos[id_slider_] = RandNormal(0, 0.01)(gen_);
-      data_->qpos[id_hinge1_] = RandNormal(M_PI, 0.01)(gen_);
+      data_->qpos[id_slider_] = RandNormal(0, 0.01)(this->gen_);
+      data_->qpos[id_hinge1_] = RandNormal(M_PI, 0.01)(this->gen_);
       for (int i = 2; i < model_->nq; ++i) {
-        data_->qpos[i] = RandNormal(0, 0.01)(gen_);
+        data_->qpos[i] = RandNormal(0, 0.01)(this->gen_);
       }
     } else {
-      data_->qpos[id_slider_] = RandUniform(-0.1, 0.1)(gen_);
+      data_->qpos[id_slider_] = RandUniform(-0.1, 0.1)(this->gen_);
       for (int i = 1; i < model_->nq; ++i) {
-        data_->qpos[i] = RandUniform(-0.034, 0.034)(gen_);
+        data_->qpos[i] = RandUniform(-0.034, 0.034)(this->gen_);
       }
     }
     for (int i = 0; i < model_->nv; ++i) {
-      data_->qvel[i] = RandNormal(0, 0.01)(gen_);
+      data_->qvel[i] = RandNormal(0, 0.01)(this->gen_);
     }
 #ifdef ENVPOOL_TEST
     std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
@@ -185,9 +193,10 @@ class CartpoleEnv : public Env<CartpoleEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& position = BoundedPosition();
     state["obs:position"_].Assign(position.data(), position.size());
@@ -233,7 +242,10 @@ class CartpoleEnv : public Env<CartpoleEnvSpec>, public MujocoEnv {
   }
 };
 
+using CartpoleEnv = CartpoleEnvBase<CartpoleEnvSpec>;
+using CartpolePixelEnv = CartpoleEnvBase<CartpolePixelEnvSpec>;
 using CartpoleEnvPool = AsyncEnvPool<CartpoleEnv>;
+using CartpolePixelEnvPool = AsyncEnvPool<CartpolePixelEnv>;
 
 }  // namespace mujoco_dmc
 
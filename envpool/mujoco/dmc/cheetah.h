@@ -58,20 +58,28 @@ class CheetahEnvFns {
   }
 };
 
-using CheetahEnvSpec = EnvSpec<CheetahEnvFns>;
+using CheetahEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<CheetahEnvFns>>;
+using CheetahPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<CheetahEnvFns>>>;
+
+template <typename EnvSpec>
+class CheetahEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class CheetahEnv : public Env<CheetahEnvSpec>, public MujocoEnv {
  protected:
   const mjtNum kRunSpeed = 10;
   int id_torso_subtreelinvel_;
 
  public:
-  CheetahEnv(const Spec& spec, int env_id)
-      : Env<CheetahEnvSpec>(spec, env_id),
+  CheetahEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetCheetahXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_torso_subtreelinvel_(GetSensorId(model_, "torso_subtreelinvel")) {
     const std::string& task_name = spec.config["task_name"_];
     if (task_name != "run") {
@@ -87,7 +95,7 @@ class CheetahEnv : public Env<CheetahEnvSpec>, public MujocoEnv {
         mjtNum range_min = model_->jnt_range[id_joint * 2 + 0];
         mjtNum range_max = model_->jnt_range[id_joint * 2 + 1];
         data_->qpos[model_->jnt_qposadr[id_joint]] =
-            RandUniform(range_min, range_max)(gen_);
+            RandUniform(range_min, range_max)(this->gen_);
       }
     }
 #ifdef ENVPOOL_TEST
@@ -120,9 +128,10 @@ class CheetahEnv : public Env<CheetahEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:position"_].Assign(data_->qpos + 1, model_->nq - 1);
     state["obs:velocity"_].Assign(data_->qvel, model_->nv);
@@ -137,7 +146,10 @@ class CheetahEnv : public Env<CheetahEnvSpec>, public MujocoEnv {
   }
 };
 
+using CheetahEnv = CheetahEnvBase<CheetahEnvSpec>;
+using CheetahPixelEnv = CheetahEnvBase<CheetahPixelEnvSpec>;
 using CheetahEnvPool = AsyncEnvPool<CheetahEnv>;
+using CheetahPixelEnvPool = AsyncEnvPool<CheetahPixelEnv>;
 
 }  // namespace mujoco_dmc
 
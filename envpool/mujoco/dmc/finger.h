@@ -63,9 +63,16 @@ class FingerEnvFns {
   }
 };
 
-using FingerEnvSpec = EnvSpec<FingerEnvFns>;
+using FingerEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<FingerEnvFns>>;
+using FingerPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<FingerEnvFns>>>;
+
+template <typename EnvSpec>
+class FingerEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
  protected:
   const mjtNum kEasyTargetSize = 0.07;
   const mjtNum kHardTargetSize = 0.03;
@@ -84,12 +91,13 @@ class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  FingerEnv(const Spec& spec, int env_id)
-      : Env<FingerEnvSpec>(spec, env_id),
+  FingerEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetFingerXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_site_target_(mj_name2id(model_, mjOBJ_SITE, "target")),
         id_site_tip_(mj_name2id(model_, mjOBJ_SITE, "tip")),
         id_hinge_(GetQvelId(model_, "hinge")),
@@ -132,7 +140,7 @@ class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
       // target_z = hinge_z + radius * np.cos(target_angle)
       // physics.named.model.site_pos['target', ['x', 'z']] = target_x, target_z
       // physics.named.model.site_size['target', 0] = self._target_radius
-      mjtNum target_angle = RandUniform(-M_PI, M_PI)(gen_);
+      mjtNum target_angle = RandUniform(-M_PI, M_PI)(this->gen_);
       mjtNum hinge_x = data_->xanchor[id_hinge_ * 3 + 0];
       mjtNum hinge_z = data_->xanchor[id_hinge_ * 3 + 2];
       mjtNum radius = model_->geom_size[id_cap1_ * 3 + 0] +
@@ -174,9 +182,10 @@ class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& bound_pos = BoundedPosition();
     const auto& velocity = Velocity();
@@ -202,7 +211,7 @@ class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
   void SetRandomJointAngles(int max_attempts = 1000) {
     int i = 0;
     for (int i = 0; i < max_attempts; i++) {
-      RandomizeLimitedAndRotationalJoints(&gen_);
+      RandomizeLimitedAndRotationalJoints(&this->gen_);
 #ifdef ENVPOOL_TEST
       std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -278,7 +287,10 @@ class FingerEnv : public Env<FingerEnvSpec>, public MujocoEnv {
   }
 };
 
+using FingerEnv = FingerEnvBase<FingerEnvSpec>;
+using FingerPixelEnv = FingerEnvBase<FingerPixelEnvSpec>;
 using FingerEnvPool = AsyncEnvPool<FingerEnv>;
+using FingerPixelEnvPool = AsyncEnvPool<FingerPixelEnv>;
 
 }  // namespace mujoco_dmc
 
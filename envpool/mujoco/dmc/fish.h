@@ -62,9 +62,16 @@ class FishEnvFns {
   }
 };
 
-using FishEnvSpec = EnvSpec<FishEnvFns>;
+using FishEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<FishEnvFns>>;
+using FishPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<FishEnvFns>>>;
+
+template <typename EnvSpec>
+class FishEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
   const std::array<std::string, 7> kJoints = {
       "tail1",          "tail_twist",   "tail2",        "finright_roll",
       "finright_pitch", "finleft_roll", "finleft_pitch"};
@@ -78,12 +85,13 @@ class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  FishEnv(const Spec& spec, int env_id)
-      : Env<FishEnvSpec>(spec, env_id),
+  FishEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetFishXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_mouth_(mj_name2id(model_, mjOBJ_GEOM, "mouth")),
         id_qpos_root_(GetQposId(model_, "root")),
         id_torso_(mj_name2id(model_, mjOBJ_XBODY, "torso")),
@@ -104,8 +112,8 @@ class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
     // quat = self.random.randn(4)
     // physics.named.data.qpos['root'][3:7] = quat / np.linalg.norm(quat)
     std::array<mjtNum, 4> quat = {
-        RandNormal(0, 1)(gen_), RandNormal(0, 1)(gen_), RandNormal(0, 1)(gen_),
-        RandNormal(0, 1)(gen_)};
+        RandNormal(0, 1)(this->gen_), RandNormal(0, 1)(this->gen_),
+        RandNormal(0, 1)(this->gen_), RandNormal(0, 1)(this->gen_)};
     mjtNum quat_norm = std::sqrt(quat[0] * quat[0] + quat[1] * quat[1] +
                                  quat[2] * quat[2] + quat[3] * quat[3]);
     for (int i = 0; i < 4; ++i) {
@@ -114,16 +122,16 @@ class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
     // for joint in _JOINTS:
     //   physics.named.data.qpos[joint] = self.random.uniform(-.2, .2)
     for (int id : id_qpos_joint_) {
-      data_->qpos[id] = RandUniform(-0.2, 0.2)(gen_);
+      data_->qpos[id] = RandUniform(-0.2, 0.2)(this->gen_);
     }
     if (is_swim_) {
       // Randomize target position.
       // physics.named.model.geom_pos['target', 'x'] = uniform(-.4, .4)
       // physics.named.model.geom_pos['target', 'y'] = uniform(-.4, .4)
       // physics.named.model.geom_pos['target', 'z'] = uniform(.1, .3)
-      mjtNum target_x = RandUniform(-0.4, 0.4)(gen_);
-      mjtNum target_y = RandUniform(-0.4, 0.4)(gen_);
-      mjtNum target_z = RandUniform(0.1, 0.3)(gen_);
+      mjtNum target_x = RandUniform(-0.4, 0.4)(this->gen_);
+      mjtNum target_y = RandUniform(-0.4, 0.4)(this->gen_);
+      mjtNum target_z = RandUniform(0.1, 0.3)(this->gen_);
       model_->geom_pos[id_target_ * 3 + 0] = target_x;
       model_->geom_pos[id_target_ * 3 + 1] = target_y;
       model_->geom_pos[id_target_ * 3 + 2] = target_z;
@@ -171,9 +179,10 @@ class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& joint_angles = JointAngles();
     state["obs:joint_angles"_].Assign(joint_angles.begin(),
@@ -239,7 +248,10 @@ class FishEnv : public Env<FishEnvSpec>, public MujocoEnv {
   }
 };
 
+using FishEnv = FishEnvBase<FishEnvSpec>;
+using FishPixelEnv = FishEnvBase<FishPixelEnvSpec>;
 using FishEnvPool = AsyncEnvPool<FishEnv>;
+using FishPixelEnvPool = AsyncEnvPool<FishPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -58,9 +58,16 @@ class HopperEnvFns {
   }
 };
 
-using HopperEnvSpec = EnvSpec<HopperEnvFns>;
+using HopperEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<HopperEnvFns>>;
+using HopperPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<HopperEnvFns>>>;
+
+template <typename EnvSpec>
+class HopperEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
   const mjtNum kStandHeight = 0.6;
   const mjtNum kHopSpeed = 2;
   int id_torso_, id_foot_;
@@ -68,12 +75,13 @@ class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
   bool hopping_;
 
  public:
-  HopperEnv(const Spec& spec, int env_id)
-      : Env<HopperEnvSpec>(spec, env_id),
+  HopperEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetHopperXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_torso_(mj_name2id(model_, mjOBJ_XBODY, "torso")),
         id_foot_(mj_name2id(model_, mjOBJ_XBODY, "foot")),
         id_torso_subtreelinvel_(GetSensorId(model_, "torso_subtreelinvel")),
@@ -92,7 +100,7 @@ class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
 
   void TaskInitializeEpisode() override {
     // randomizers.randomize_limited_and_rotational_joints(physics, self.random)
-    RandomizeLimitedAndRotationalJoints(&gen_);
+    RandomizeLimitedAndRotationalJoints(&this->gen_);
 #ifdef ENVPOOL_TEST
     std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -150,9 +158,10 @@ class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
   }
 
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:position"_].Assign(data_->qpos + 1, model_->nq - 1);
     state["obs:velocity"_].Assign(data_->qvel, model_->nv);
@@ -165,7 +174,10 @@ class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
   }
 };
 
+using HopperEnv = HopperEnvBase<HopperEnvSpec>;
+using HopperPixelEnv = HopperEnvBase<HopperPixelEnvSpec>;
 using HopperEnvPool = AsyncEnvPool<HopperEnv>;
+using HopperPixelEnvPool = AsyncEnvPool<HopperPixelEnv>;
 
 }  // namespace mujoco_dmc
 
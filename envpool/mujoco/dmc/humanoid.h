@@ -64,9 +64,16 @@ class HumanoidEnvFns {
   }
 };
 
-using HumanoidEnvSpec = EnvSpec<HumanoidEnvFns>;
+using HumanoidEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<HumanoidEnvFns>>;
+using HumanoidPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<HumanoidEnvFns>>>;
+
+template <typename EnvSpec>
+class HumanoidEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class HumanoidEnv : public Env<HumanoidEnvSpec>, public MujocoEnv {
  protected:
   // Height of head above which stand reward is 1.
   const mjtNum kStandHeight = 1.4;
@@ -84,13 +91,14 @@ class HumanoidEnv : public Env<HumanoidEnvSpec>, public MujocoEnv {
   bool is_pure_state_;
 
  public:
-  HumanoidEnv(const Spec& spec, int env_id)
-      : Env<HumanoidEnvSpec>(spec, env_id),
+  HumanoidEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetHumanoidXML(spec.config["base_path"_],
                                  spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_head_(mj_name2id(model_, mjOBJ_XBODY, "head")),
         id_left_hand_(mj_name2id(model_, mjOBJ_XBODY, "left_hand")),
         id_left_foot_(mj_name2id(model_, mjOBJ_XBODY, "left_foot")),
@@ -117,7 +125,7 @@ class HumanoidEnv : public Env<HumanoidEnvSpec>, public MujocoEnv {
       // Find a collision-free random initial configuration.
       // randomizers.randomize_limited_and_rotational_joints(physics,
       // self.random)
-      RandomizeLimitedAndRotationalJoints(&gen_);
+      RandomizeLimitedAndRotationalJoints(&this->gen_);
 #ifdef ENVPOOL_TEST
       std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -178,9 +186,10 @@ class HumanoidEnv : public Env<HumanoidEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& joint_angles = JointAngles();
     const auto& extremities = Extremities();
@@ -312,7 +321,10 @@ class HumanoidEnv : public Env<HumanoidEnvSpec>, public MujocoEnv {
   }
 };
 
+using HumanoidEnv = HumanoidEnvBase<HumanoidEnvSpec>;
+using HumanoidPixelEnv = HumanoidEnvBase<HumanoidPixelEnvSpec>;
 using HumanoidEnvPool = AsyncEnvPool<HumanoidEnv>;
+using HumanoidPixelEnvPool = AsyncEnvPool<HumanoidPixelEnv>;
 
 }  // namespace mujoco_dmc
 
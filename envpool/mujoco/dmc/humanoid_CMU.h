@@ -63,9 +63,17 @@ class HumanoidCMUEnvFns {
   }
 };
 
-using HumanoidCMUEnvSpec = EnvSpec<HumanoidCMUEnvFns>;
+using HumanoidCMUEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<HumanoidCMUEnvFns>>;
+using HumanoidCMUPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<HumanoidCMUEnvFns>>>;
+
+template <typename EnvSpec>
+class HumanoidCMUEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class HumanoidCMUEnv : public Env<HumanoidCMUEnvSpec>, public MujocoEnv {
  protected:
   // Height of head above which stand reward is 1.
   const mjtNum kStandHeight = 1.4;
@@ -81,13 +89,14 @@ class HumanoidCMUEnv : public Env<HumanoidCMUEnvSpec>, public MujocoEnv {
   mjtNum move_speed_;
 
  public:
-  HumanoidCMUEnv(const Spec& spec, int env_id)
-      : Env<HumanoidCMUEnvSpec>(spec, env_id),
+  HumanoidCMUEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetHumanoidCMUXML(spec.config["base_path"_],
                                     spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_head_(mj_name2id(model_, mjOBJ_XBODY, "head")),
         id_lhand_(mj_name2id(model_, mjOBJ_XBODY, "lhand")),
         id_lfoot_(mj_name2id(model_, mjOBJ_XBODY, "lfoot")),
@@ -111,7 +120,7 @@ class HumanoidCMUEnv : public Env<HumanoidCMUEnvSpec>, public MujocoEnv {
       // Find a collision-free random initial configuration.
       // randomizers.randomize_limited_and_rotational_joints(physics,
       // self.random)
-      RandomizeLimitedAndRotationalJoints(&gen_);
+      RandomizeLimitedAndRotationalJoints(&this->gen_);
 #ifdef ENVPOOL_TEST
       std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -171,9 +180,10 @@ class HumanoidCMUEnv : public Env<HumanoidCMUEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& joint_angles = JointAngles();
     const auto& extremities = Extremities();
@@ -292,7 +302,10 @@ class HumanoidCMUEnv : public Env<HumanoidCMUEnvSpec>, public MujocoEnv {
   }
 };
 
+using HumanoidCMUEnv = HumanoidCMUEnvBase<HumanoidCMUEnvSpec>;
+using HumanoidCMUPixelEnv = HumanoidCMUEnvBase<HumanoidCMUPixelEnvSpec>;
 using HumanoidCMUEnvPool = AsyncEnvPool<HumanoidCMUEnv>;
+using HumanoidCMUPixelEnvPool = AsyncEnvPool<HumanoidCMUPixelEnv>;
 
 }  // namespace mujoco_dmc
 
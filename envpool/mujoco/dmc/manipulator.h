@@ -81,9 +81,17 @@ class ManipulatorEnvFns {
   }
 };
 
-using ManipulatorEnvSpec = EnvSpec<ManipulatorEnvFns>;
+using ManipulatorEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<ManipulatorEnvFns>>;
+using ManipulatorPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<ManipulatorEnvFns>>>;
+
+template <typename EnvSpec>
+class ManipulatorEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
  protected:
   const mjtNum kClose = 0.01;
   const mjtNum kPInHand = 0.1;
@@ -113,13 +121,14 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
   int id_site_peg_tip_, id_site_ball_, id_site_target_ball_;
 
  public:
-  ManipulatorEnv(const Spec& spec, int env_id)
-      : Env<ManipulatorEnvSpec>(spec, env_id),
+  ManipulatorEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetManipulatorXML(spec.config["base_path"_],
                                     spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         use_peg_(spec.config["task_name"_] == "bring_peg" ||
                  spec.config["task_name"_] == "insert_peg"),
         insert_(spec.config["task_name"_] == "insert_peg" ||
@@ -176,17 +185,17 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
         bool is_limited = model_->jnt_limited[id_joint] == 1 ? true : false;
         mjtNum lower = is_limited ? model_->jnt_range[id_joint * 2 + 0] : -M_PI;
         mjtNum upper = is_limited ? model_->jnt_range[id_joint * 2 + 1] : M_PI;
-        data_->qpos[id_arm_qpos_[i]] = RandUniform(lower, upper)(gen_);
+        data_->qpos[id_arm_qpos_[i]] = RandUniform(lower, upper)(this->gen_);
       }
       data_->qpos[id_finger_] = data_->qpos[id_thumb_];
 #ifdef ENVPOOL_TEST
       std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
-      mjtNum target_x = random_info_[0] = RandUniform(-0.4, 0.4)(gen_);
-      mjtNum target_z = RandUniform(0.1, 0.4)(gen_);
+      mjtNum target_x = random_info_[0] = RandUniform(-0.4, 0.4)(this->gen_);
+      mjtNum target_z = RandUniform(0.1, 0.4)(this->gen_);
       mjtNum target_angle;
       if (insert_) {
-        target_angle = RandUniform(-M_PI / 3, M_PI / 3)(gen_);
+        target_angle = RandUniform(-M_PI / 3, M_PI / 3)(this->gen_);
         // model.body_pos[self._receptacle, ['x', 'z']]
         model_->body_pos[id_body_receptacle_ * 3 + 0] = target_x;
         model_->body_pos[id_body_receptacle_ * 3 + 2] = target_z;
@@ -196,7 +205,7 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
         model_->body_quat[id_body_receptacle_ * 4 + 2] =
             std::sin(target_angle / 2);
       } else {
-        target_angle = RandUniform(-M_PI, M_PI)(gen_);
+        target_angle = RandUniform(-M_PI, M_PI)(this->gen_);
       }
       random_info_[0] = target_x;
       random_info_[1] = target_z;
@@ -210,7 +219,7 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
       model_->body_quat[id_body_target_ * 4 + 0] = std::cos(target_angle / 2);
       model_->body_quat[id_body_target_ * 4 + 2] = std::sin(target_angle / 2);
 
-      mjtNum choice = RandUniform(0, 1)(gen_);
+      mjtNum choice = RandUniform(0, 1)(this->gen_);
       mjtNum object_x;
       mjtNum object_z;
       mjtNum object_angle;
@@ -244,10 +253,11 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
         // object_z = uniform(0, .7)
         // object_angle = uniform(0, 2*np.pi)
         // data.qvel[self._object + '_x'] = uniform(-5, 5)
-        object_x = RandUniform(-0.5, 0.5)(gen_);
-        object_z = RandUniform(0, 0.7)(gen_);
-        object_angle = RandUniform(0, M_PI * 2)(gen_);
-        data_->qvel[id_object_x_] = random_info_[7] = RandUniform(-5, 5)(gen_);
+        object_x = RandUniform(-0.5, 0.5)(this->gen_);
+        object_z = RandUniform(0, 0.7)(this->gen_);
+        object_angle = RandUniform(0, M_PI * 2)(this->gen_);
+        data_->qvel[id_object_x_] = random_info_[7] =
+            RandUniform(-5, 5)(this->gen_);
       }
       data_->qpos[id_qpos_object_joints_[0]] = random_info_[4] = object_x;
       data_->qpos[id_qpos_object_joints_[1]] = random_info_[5] = object_z;
@@ -361,9 +371,10 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
     const auto& joint_vel_obj = JointVelObj();
     const auto& target_pos = Body2dPose(id_xbody_target_);
 
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:arm_pos"_].Assign(bounded_joint_pos.begin(),
                                  bounded_joint_pos.size());
@@ -381,7 +392,10 @@ class ManipulatorEnv : public Env<ManipulatorEnvSpec>, public MujocoEnv {
   }
 };
 
+using ManipulatorEnv = ManipulatorEnvBase<ManipulatorEnvSpec>;
+using ManipulatorPixelEnv = ManipulatorEnvBase<ManipulatorPixelEnvSpec>;
 using ManipulatorEnvPool = AsyncEnvPool<ManipulatorEnv>;
+using ManipulatorPixelEnvPool = AsyncEnvPool<ManipulatorPixelEnv>;
 
 }  // namespace mujoco_dmc
 
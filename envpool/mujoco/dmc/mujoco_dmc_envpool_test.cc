@@ -0,0 +1,99 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "envpool/mujoco/dmc/finger.h"
+#include "envpool/mujoco/sub_step.h"
+
+using MjcAction = typename mujoco_dmc::FingerEnv::Action;
+using MjcState = typename mujoco_dmc::FingerEnv::State;
+
+// a pool which reads the sensordata of its envs
+class PeekEnvPool : public mujoco_dmc::FingerEnvPool {
+ private:
+  struct PeekEnv : mujoco_dmc::FingerEnv {
+    static std::vector<mjtNum> SensorData(const mujoco_dmc::FingerEnv& env) {
+      const mjModel* model = env.*(&PeekEnv::model_);
+      const mjData* data = env.*(&PeekEnv::data_);
+      return {data->sensordata, data->sensordata + model->nsensordata};
+    }
+  };
+
+ public:
+  using mujoco_dmc::FingerEnvPool::AsyncEnvPool;
+  std::vector<mjtNum> SensorData(int env_id) {
+    return PeekEnv::SensorData(*envs_[env_id]);
+  }
+};
+
+// The bytes of every state and the sensordata of every env at each step of a
+// rollout, in the order of env_id.
+std::vector<std::vector<char>> SubStepRollout(bool skip_sensor) {
+  mujoco_physics::skip_sensor = skip_sensor;
+  auto config = mujoco_dmc::FingerEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["seed"_] = 7;
+  config["frame_skip"_] = 4;
+  mujoco_dmc::FingerEnvSpec spec(config);
+  PeekEnvPool envpool(spec);
+  Array all_env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    all_env_ids[i] = i;
+  }
+  envpool.Reset(all_env_ids);
+  std::vector<std::vector<char>> result;
+  std::vector<Array> raw_action({Array(Spec<int>({num_envs})),
+                                 Array(Spec<int>({num_envs})),
+                                 Array(Spec<double>({num_envs, 2}))});
+  MjcAction action(&raw_action);
+  for (int t = 0; t < 300; ++t) {
+    auto state_vec = envpool.Recv();
+    MjcState state(&state_vec);
+    for (int env_id = 0; env_id < num_envs; ++env_id) {
+      int i = 0;
+      while (static_cast<int>(state["info:env_id"_][i]) != env_id) {
+        ++i;
+      }
+      std::vector<char> bytes;
+      for (auto& arr : state_vec) {
+        auto* data = static_cast<const char*>(arr[i].Data());
+        bytes.insert(bytes.end(), data, data + arr[i].size * arr.element_size);
+      }
+      auto sensor = envpool.SensorData(env_id);
+      auto* data = reinterpret_cast<const char*>(sensor.data());
+      bytes.insert(bytes.end(), data, data + sensor.size() * sizeof(mjtNum));
+      result.push_back(std::move(bytes));
+      action["env_id"_][env_id] = env_id;
+      action["players.env_id"_][env_id] = env_id;
+      for (int j = 0; j < 2; ++j) {
+        action["action"_][env_id][j] = std::sin(0.1 * t + env_id + j);
+      }
+    }
+    envpool.Send(action);
+  }
+  mujoco_physics::skip_sensor = true;
+  return result;
+}
+
+TEST(MjcDmcEnvPoolTest, SkipSensor) {
+  // skipping the sensors of the intermediate sub-steps changes
+  // neither the observations, rewards and discounts nor the sensors
+  EXPECT_EQ(SubStepRollout(true), SubStepRollout(false));
+}
@@ -0,0 +1,81 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Unit tests for Mujoco dm_control pixel observations."""
+
+import numpy as np
+from absl.testing import absltest
+
+import envpool.mujoco.dmc.registration  # noqa: F401
+from envpool.registration import make_dm
+
+
+class _MujocoDmcPixelsTest(absltest.TestCase):
+
+  def test_default_no_pixels(self) -> None:
+    env = make_dm("CheetahRun-v1", num_envs=2)
+    self.assertNotIn("pixels", env.observation_spec()._fields)
+    obs = env.reset().observation
+    self.assertEqual(obs._fields, ("position", "velocity"))
+
+  def test_pixels(self) -> None:
+    num_envs = 4
+    for task_id in [
+      "AcrobotSwingup-v1", "CartpoleSwingup-v1", "CheetahRun-v1",
+      "FingerSpin-v1", "HumanoidWalk-v1", "ManipulatorBringBall-v1",
+      "ReacherEasy-v1", "WalkerWalk-v1"
+    ]:
+      env0 = make_dm(task_id, num_envs=num_envs, seed=0, obs_type="pixels")
+      env1 = make_dm(task_id, num_envs=num_envs, seed=0, obs_type="pixels")
+      act_spec = env0.action_spec()
+      pixels0 = env0.reset().observation.pixels
+      pixels1 = env1.reset().observation.pixels
+      self.assertEqual(pixels0.shape, (num_envs, 3, 84, 84))
+      self.assertEqual(pixels0.dtype, np.uint8)
+      np.testing.assert_array_equal(pixels0, pixels1)
+      # the scene is not a blank background
+      self.assertGreater(np.ptp(pixels0[0]), 32, task_id)
+      action = np.random.uniform(
+        act_spec.minimum, act_spec.maximum, (num_envs, *act_spec.shape)
+      )
+      for _ in range(10):
+        next0 = env0.step(action).observation.pixels
+        next1 = env1.step(action).observation.pixels
+      np.testing.assert_array_equal(next0, next1)
+      self.assertFalse(np.array_equal(pixels0, next0), task_id)
+
+  def test_render_config(self) -> None:
+    env = make_dm(
+      "WalkerWalk-v1",
+      num_envs=2,
+      obs_type="pixels",
+      render_width=64,
+      render_height=48,
+      camera_id=1,
+      frame_stack=3,
+    )
+    spec = env.observation_spec().pixels
+    self.assertEqual(spec.shape, (3, 3, 48, 64))
+    obs = env.reset().observation
+    self.assertEqual(obs.pixels.shape, (2, 3, 3, 48, 64))
+    self.assertRaises(
+      ValueError,
+      make_dm,
+      "WalkerWalk-v1",
+      obs_type="pixels",
+      camera_id=100,
+    )
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -20,10 +20,15 @@
 #include <stdexcept>
 #include <vector>
 
+#include "envpool/mujoco/physics_profile.h"
+#include "envpool/mujoco/sub_step.h"
+
 namespace mujoco_dmc {
 
 MujocoEnv::MujocoEnv(const std::string& base_path, const std::string& raw_xml,
-                     int n_sub_steps, int max_episode_steps)
+                     int n_sub_steps, int max_episode_steps,
+                     const std::string& physics_profile,
+                     const RenderConfig& render)
     : n_sub_steps_(n_sub_steps),
       max_episode_steps_(max_episode_steps),
       elapsed_step_(max_episode_steps + 1),
@@ -52,6 +57,11 @@ MujocoEnv::MujocoEnv(const std::string& base_path, const std::string& raw_xml,
   // create model and data
   model_ = mj_loadXML(model_filename.c_str(), vfs.get(), error_.begin(), 1000);
   data_ = mj_makeData(model_);
+  mujoco_physics::ApplyPhysicsProfile(model_, "dmc", physics_profile);
+  if (render.width > 0 && render.height > 0) {
+    renderer_ = std::make_unique<mujoco_render::SoftwareRenderer>(
+        model_, render.width, render.height, render.camera_id);
+  }
 #ifdef ENVPOOL_TEST
   qpos0_.reset(new mjtNum[model_->nq]);
 #endif
@@ -62,6 +72,15 @@ MujocoEnv::~MujocoEnv() {
   mj_deleteData(data_);
 }
 
+std::pair<int, int> MujocoEnv::TransitionDims() const {
+  return mujoco_physics::TransitionDims(model_);
+}
+
+void MujocoEnv::TransitionJacobian(mjtNum eps, bool centered, mjtNum* a,
+                                   mjtNum* b) {
+  jacobian_.Compute(model_, data_, n_sub_steps_, eps, centered, a, b);
+}
+
 // rl control Environment
 // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/rl/control.py#L77
 void MujocoEnv::ControlReset() {
@@ -142,23 +161,34 @@ void MujocoEnv::PhysicsForward() { mj_forward(model_, data_); }
 
 // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/mujoco/engine.py#L146
 void MujocoEnv::PhysicsStep(int nstep, const mjtNum* action) {
-  TaskBeforeSubStep(action);
-  if (model_->opt.integrator != mjINT_RK4) {
-    mj_step2(model_, data_);
-  } else {
-    mj_step(model_, data_);
-  }
-  TaskAftersSubStep();
-  if (nstep > 1) {
-    for (int i = 0; i < nstep - 1; ++i) {
-      TaskBeforeSubStep(action);
+  // Sensors are read after the final mj_step1, which evaluates them at the
+  // final state except for the acceleration sensors of the last sub-step,
+  // so the other sub-steps skip them.
+  for (int i = 0; i < nstep; ++i) {
+    bool last = i == nstep - 1;
+    TaskBeforeSubStep(action);
+    if (i == 0 && model_->opt.integrator != mjINT_RK4) {
+      if (last) {
+        mj_step2(model_, data_);
+      } else {
+        mujoco_physics::Step2SkipSensor(model_, data_);
+      }
+    } else if (last) {
       mj_step(model_, data_);
-      TaskAftersSubStep();
+    } else {
+      mujoco_physics::StepSkipSensor(model_, data_);
     }
+    TaskAftersSubStep();
   }
   mj_step1(model_, data_);
 }
 
+void MujocoEnv::PhysicsRender(uint8_t* rgb) {
+  if (renderer_) {
+    renderer_->Render(data_, rgb);
+  }
+}
+
 // randomizer
 // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/suite/utils/randomizers.py#L35
 void MujocoEnv::RandomizeLimitedAndRotationalJoints(std::mt19937* gen) {
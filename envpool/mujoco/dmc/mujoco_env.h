@@ -20,14 +20,71 @@
 #include <mjxmacro.h>
 #include <mujoco.h>
 
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
+#include <type_traits>
+#include <utility>
 
+#include "envpool/core/dict.h"
+#include "envpool/core/env_spec.h"
+#include "envpool/core/spec.h"
 #include "envpool/mujoco/dmc/utils.h"
+#include "envpool/mujoco/jacobian.h"
+#include "envpool/mujoco/physics_profile.h"
+#include "envpool/mujoco/software_renderer.h"
 
 namespace mujoco_dmc {
 
+/**
+ * EnvFns of the obs_type="pixels" variant of a dmc task, which adds the
+ * [3, render_height, render_width] image of camera camera_id as
+ * "obs:pixels" to the observations of the task.
+ */
+template <typename EnvFns>
+class PixelEnvFns {
+ public:
+  static decltype(auto) DefaultConfig() {
+    return ConcatDict(
+        EnvFns::DefaultConfig(),
+        MakeDict("render_width"_.Bind(84), "render_height"_.Bind(84),
+                 "camera_id"_.Bind(0)));
+  }
+  template <typename Config>
+  static decltype(auto) StateSpec(const Config& conf) {
+    Spec<uint8_t> pixels({3, conf["render_height"_], conf["render_width"_]},
+                         {0, 255});
+    return ConcatDict(EnvFns::StateSpec(conf),
+                      MakeDict("obs:pixels"_.Bind(pixels)));
+  }
+  template <typename Config>
+  static decltype(auto) ActionSpec(const Config& conf) {
+    return EnvFns::ActionSpec(conf);
+  }
+};
+
+template <typename Spec>
+struct IsPixelObs : std::false_type {};
+
+template <typename EnvFns>
+struct IsPixelObs<EnvSpec<PixelEnvFns<EnvFns>>> : std::true_type {};
+
+// Size and camera of "obs:pixels", width and height are 0 if not rendered.
+struct RenderConfig {
+  int width, height, camera_id;
+};
+
+template <typename EnvSpec>
+RenderConfig GetRenderConfig(const EnvSpec& spec) {
+  if constexpr (IsPixelObs<EnvSpec>::value) {
+    return {spec.config["render_width"_], spec.config["render_height"_],
+            spec.config["camera_id"_]};
+  } else {
+    return {0, 0, 0};
+  }
+}
+
 /*
  * This class combines with dmc Task and Physics API.
  *
@@ -47,13 +104,16 @@ class MujocoEnv {
   int n_sub_steps_, max_episode_steps_, elapsed_step_;
   float reward_, discount_;
   bool done_;
+  mujoco_physics::StepJacobian jacobian_;
+  std::unique_ptr<mujoco_render::SoftwareRenderer> renderer_;
 #ifdef ENVPOOL_TEST
   std::unique_ptr<mjtNum> qpos0_;
 #endif
 
  public:
   MujocoEnv(const std::string& base_path, const std::string& raw_xml,
-            int n_sub_steps, int max_episode_steps);
+            int n_sub_steps, int max_episode_steps,
+            const std::string& physics_profile, const RenderConfig& render);
   ~MujocoEnv();
 
   // rl control Environment
@@ -63,6 +123,16 @@ class MujocoEnv {
   // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/rl/control.py#L94
   void ControlStep(const mjtNum* action);
 
+  // Size (nx, nu) of the state and the control in TransitionJacobian.
+  [[nodiscard]] std::pair<int, int> TransitionDims() const;
+
+  // Finite-difference Jacobians of one env step around the current state and
+  // control, with the state (qpos, qvel, act) in the tangent space of
+  // mjd_transitionFD: a is [nx, nx] and b is [nx, nu], both row-major. The
+  // n_sub_steps_ sub-steps are chained with the control held fixed, and the
+  // env itself is not stepped.
+  void TransitionJacobian(mjtNum eps, bool centered, mjtNum* a, mjtNum* b);
+
   // Task
   virtual void TaskInitializeEpisodeMjcf() {}
   virtual void TaskInitializeEpisode() {}
@@ -91,6 +161,18 @@ class MujocoEnv {
   // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/mujoco/engine.py#L146
   void PhysicsStep(int nstep, const mjtNum* action);
 
+  // Render "obs:pixels" into rgb with the CPU renderer, a no-op if the env
+  // has no pixel observation.
+  void PhysicsRender(uint8_t* rgb);
+
+  // Render "obs:pixels" of state for the pixel variant of a task.
+  template <typename EnvSpec, typename State>
+  void RenderPixels(State* state) {
+    if constexpr (IsPixelObs<EnvSpec>::value) {
+      PhysicsRender(static_cast<uint8_t*>((*state)["obs:pixels"_].Data()));
+    }
+  }
+
   // randomizer
   // https://github.com/deepmind/dm_control/blob/1.0.2/dm_control/suite/utils/randomizers.py#L35
   void RandomizeLimitedAndRotationalJoints(std::mt19937* gen);
@@ -59,21 +59,29 @@ class PendulumEnvFns {
   }
 };
 
-using PendulumEnvSpec = EnvSpec<PendulumEnvFns>;
+using PendulumEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<PendulumEnvFns>>;
+using PendulumPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<PendulumEnvFns>>>;
+
+template <typename EnvSpec>
+class PendulumEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class PendulumEnv : public Env<PendulumEnvSpec>, public MujocoEnv {
  protected:
   const mjtNum kCosineBound = std::cos(8.0 / 180 * M_PI);
   int id_hinge_, id_pole_;
 
  public:
-  PendulumEnv(const Spec& spec, int env_id)
-      : Env<PendulumEnvSpec>(spec, env_id),
+  PendulumEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetPendulumXML(spec.config["base_path"_],
                                  spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_hinge_(GetQvelId(model_, "hinge")),
         id_pole_(mj_name2id(model_, mjOBJ_XBODY, "pole")) {
     const std::string& task_name = spec.config["task_name"_];
@@ -84,7 +92,7 @@ class PendulumEnv : public Env<PendulumEnvSpec>, public MujocoEnv {
   }
 
   void TaskInitializeEpisode() override {
-    data_->qpos[0] = RandUniform(-M_PI, M_PI)(gen_);
+    data_->qpos[0] = RandUniform(-M_PI, M_PI)(this->gen_);
 #ifdef ENVPOOL_TEST
     std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -110,9 +118,10 @@ class PendulumEnv : public Env<PendulumEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& pole_orient = PoleOrientation();
     state["obs:orientation"_].Assign(pole_orient.begin(), pole_orient.size());
@@ -137,7 +146,10 @@ class PendulumEnv : public Env<PendulumEnvSpec>, public MujocoEnv {
   }
 };
 
+using PendulumEnv = PendulumEnvBase<PendulumEnvSpec>;
+using PendulumPixelEnv = PendulumEnvBase<PendulumPixelEnvSpec>;
 using PendulumEnvPool = AsyncEnvPool<PendulumEnv>;
+using PendulumPixelEnvPool = AsyncEnvPool<PendulumPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -58,9 +58,16 @@ class PointMassEnvFns {
   }
 };
 
-using PointMassEnvSpec = EnvSpec<PointMassEnvFns>;
+using PointMassEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<PointMassEnvFns>>;
+using PointMassPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<PointMassEnvFns>>>;
+
+template <typename EnvSpec>
+class PointMassEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
  protected:
   bool randomize_gains_;
   int id_geom_target_, id_geom_pointmass_;
@@ -69,13 +76,14 @@ class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  PointMassEnv(const Spec& spec, int env_id)
-      : Env<PointMassEnvSpec>(spec, env_id),
+  PointMassEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_],
                   GetPointMassXML(spec.config["base_path"_],
                                   spec.config["task_name"_]),
                   spec.config["frame_skip"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_], GetRenderConfig(spec)),
 
         id_geom_target_(mj_name2id(model_, mjOBJ_GEOM, "target")),
         id_geom_pointmass_(mj_name2id(model_, mjOBJ_GEOM, "pointmass")) {
@@ -94,7 +102,7 @@ class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
   }
 
   void TaskInitializeEpisode() override {
-    RandomizeLimitedAndRotationalJoints(&gen_);
+    RandomizeLimitedAndRotationalJoints(&this->gen_);
     if (randomize_gains_) {
       const auto& dir1 = GetDir();
       bool parallel = true;
@@ -116,8 +124,8 @@ class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
   }
 
   std::array<mjtNum, 2> GetDir() {
-    std::array<mjtNum, 2> dir = {RandNormal(0, 1)(gen_),
-                                 RandNormal(0, 1)(gen_)};
+    std::array<mjtNum, 2> dir = {RandNormal(0, 1)(this->gen_),
+                                 RandNormal(0, 1)(this->gen_)};
     mjtNum norm_of_dir = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1]);
     return {dir[0] / norm_of_dir, dir[1] / norm_of_dir};
   }
@@ -170,9 +178,10 @@ class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
   }
 
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:position"_].Assign(data_->qpos, model_->nq);
     state["obs:velocity"_].Assign(data_->qvel, model_->nv);
@@ -184,7 +193,10 @@ class PointMassEnv : public Env<PointMassEnvSpec>, public MujocoEnv {
   }
 };
 
+using PointMassEnv = PointMassEnvBase<PointMassEnvSpec>;
+using PointMassPixelEnv = PointMassEnvBase<PointMassPixelEnvSpec>;
 using PointMassEnvPool = AsyncEnvPool<PointMassEnv>;
+using PointMassPixelEnvPool = AsyncEnvPool<PointMassPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -61,9 +61,16 @@ class ReacherEnvFns {
   }
 };
 
-using ReacherEnvSpec = EnvSpec<ReacherEnvFns>;
+using ReacherEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<ReacherEnvFns>>;
+using ReacherPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<ReacherEnvFns>>>;
+
+template <typename EnvSpec>
+class ReacherEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
  protected:
   const mjtNum kBigTarget = 0.05;
   const mjtNum kSmallTarget = 0.015;
@@ -74,12 +81,13 @@ class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  ReacherEnv(const Spec& spec, int env_id)
-      : Env<ReacherEnvSpec>(spec, env_id),
+  ReacherEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetReacherXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_target_(mj_name2id(model_, mjOBJ_GEOM, "target")),
         id_finger_(mj_name2id(model_, mjOBJ_GEOM, "finger")) {
     const std::string& task_name = spec.config["task_name"_];
@@ -95,9 +103,9 @@ class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
 
   void TaskInitializeEpisode() override {
     model_->geom_size[6 * 3] = target_size_;
-    RandomizeLimitedAndRotationalJoints(&gen_);
-    mjtNum angle = RandUniform(0, M_PI * 2)(gen_);
-    mjtNum radius = RandUniform(0.05, 0.2)(gen_);
+    RandomizeLimitedAndRotationalJoints(&this->gen_);
+    mjtNum angle = RandUniform(0, M_PI * 2)(this->gen_);
+    mjtNum radius = RandUniform(0.05, 0.2)(this->gen_);
     // physics.named.model.geom_pos['target', 'x'] = radius * np.sin(angle)
     // physics.named.model.geom_pos['target', 'y'] = radius * np.cos(angle)
     model_->geom_pos[id_target_ * 3 + 0] = radius * std::sin(angle);
@@ -131,9 +139,10 @@ class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:position"_].Assign(data_->qpos, model_->nq);
     const auto& finger = FingerToTarget();
@@ -160,7 +169,10 @@ class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
   }
 };
 
+using ReacherEnv = ReacherEnvBase<ReacherEnvSpec>;
+using ReacherPixelEnv = ReacherEnvBase<ReacherPixelEnvSpec>;
 using ReacherEnvPool = AsyncEnvPool<ReacherEnv>;
+using ReacherPixelEnvPool = AsyncEnvPool<ReacherPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -71,6 +71,13 @@ for domain, task, max_episode_steps in dmc_mujoco_envs:
     spec_cls=f"Dmc{domain_name}EnvSpec",
     dm_cls=f"Dmc{domain_name}DMEnvPool",
     gym_cls=f"Dmc{domain_name}GymEnvPool",
+    obs_types={
+      "pixels": (
+        f"Dmc{domain_name}PixelEnvSpec",
+        f"Dmc{domain_name}PixelDMEnvPool",
+        f"Dmc{domain_name}PixelGymEnvPool",
+      )
+    },
     base_path=base_path,
     task_name=task,
     max_episode_steps=max_episode_steps,
@@ -89,9 +89,16 @@ class SwimmerEnvFns {
   }
 };
 
-using SwimmerEnvSpec = EnvSpec<SwimmerEnvFns>;
+using SwimmerEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<SwimmerEnvFns>>;
+using SwimmerPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<SwimmerEnvFns>>>;
+
+template <typename EnvSpec>
+class SwimmerEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
  protected:
   int id_head_, id_nose_, id_target_, id_target_light_;
 #ifdef ENVPOOL_TEST
@@ -99,22 +106,23 @@ class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
 #endif
 
  public:
-  SwimmerEnv(const Spec& spec, int env_id)
-      : Env<SwimmerEnvSpec>(spec, env_id),
+  SwimmerEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetSwimmerXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_head_(mj_name2id(model_, mjOBJ_GEOM, "head")),
         id_nose_(mj_name2id(model_, mjOBJ_GEOM, "nose")),
         id_target_(mj_name2id(model_, mjOBJ_GEOM, "target")),
         id_target_light_(mj_name2id(model_, mjOBJ_LIGHT, "target_light")) {}
 
   void TaskInitializeEpisode() override {
-    RandomizeLimitedAndRotationalJoints(&gen_);
-    mjtNum target_box = RandUniform(0, 1)(gen_) < 0.2 ? 0.3 : 2.0;
-    mjtNum xpos = RandUniform(-target_box, target_box)(gen_);
-    mjtNum ypos = RandUniform(-target_box, target_box)(gen_);
+    RandomizeLimitedAndRotationalJoints(&this->gen_);
+    mjtNum target_box = RandUniform(0, 1)(this->gen_) < 0.2 ? 0.3 : 2.0;
+    mjtNum xpos = RandUniform(-target_box, target_box)(this->gen_);
+    mjtNum ypos = RandUniform(-target_box, target_box)(this->gen_);
     // physics.named.model.geom_pos['target', 'x'] = xpos
     // physics.named.model.geom_pos['target', 'y'] = ypos
     model_->geom_pos[id_target_ * 3 + 0] = xpos;
@@ -158,9 +166,10 @@ class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
     const auto& to_target = NoseToTarget();
     const auto& body_velocities = BodyVelocities();
 
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     state["obs:joints"_].Assign(joints.data(), joints.size());
     state["obs:to_target"_].Assign(to_target.begin(), to_target.size());
@@ -219,7 +228,10 @@ class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
   }
 };
 
+using SwimmerEnv = SwimmerEnvBase<SwimmerEnvSpec>;
+using SwimmerPixelEnv = SwimmerEnvBase<SwimmerPixelEnvSpec>;
 using SwimmerEnvPool = AsyncEnvPool<SwimmerEnv>;
+using SwimmerPixelEnvPool = AsyncEnvPool<SwimmerPixelEnv>;
 
 }  // namespace mujoco_dmc
 
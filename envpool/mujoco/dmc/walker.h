@@ -59,9 +59,16 @@ class WalkerEnvFns {
   }
 };
 
-using WalkerEnvSpec = EnvSpec<WalkerEnvFns>;
+using WalkerEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<WalkerEnvFns>>;
+using WalkerPixelEnvSpec =
+    EnvSpec<PixelEnvFns<mujoco_physics::MujocoEnvFns<WalkerEnvFns>>>;
+
+template <typename EnvSpec>
+class WalkerEnvBase : public Env<EnvSpec>, public MujocoEnv {
+ public:
+  using Action = typename Env<EnvSpec>::Action;
+  using State = typename Env<EnvSpec>::State;
 
-class WalkerEnv : public Env<WalkerEnvSpec>, public MujocoEnv {
  protected:
   // Minimal height of torso over foot above which stand reward is 1.
   const mjtNum kStandHeight = 1.2;
@@ -72,12 +79,13 @@ class WalkerEnv : public Env<WalkerEnvSpec>, public MujocoEnv {
   mjtNum move_speed_;
 
  public:
-  WalkerEnv(const Spec& spec, int env_id)
-      : Env<WalkerEnvSpec>(spec, env_id),
+  WalkerEnvBase(const EnvSpec& spec, int env_id)
+      : Env<EnvSpec>(spec, env_id),
         MujocoEnv(
             spec.config["base_path"_],
             GetWalkerXML(spec.config["base_path"_], spec.config["task_name"_]),
-            spec.config["frame_skip"_], spec.config["max_episode_steps"_]),
+            spec.config["frame_skip"_], spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_], GetRenderConfig(spec)),
         id_torso_(mj_name2id(model_, mjOBJ_XBODY, "torso")),
         id_torso_subtreelinvel_(GetSensorId(model_, "torso_subtreelinvel")) {
     const std::string& task_name = spec.config["task_name"_];
@@ -94,7 +102,7 @@ class WalkerEnv : public Env<WalkerEnvSpec>, public MujocoEnv {
   }
 
   void TaskInitializeEpisode() override {
-    RandomizeLimitedAndRotationalJoints(&gen_);
+    RandomizeLimitedAndRotationalJoints(&this->gen_);
 #ifdef ENVPOOL_TEST
     std::memcpy(qpos0_.get(), data_->qpos, sizeof(mjtNum) * model_->nq);
 #endif
@@ -132,9 +140,10 @@ class WalkerEnv : public Env<WalkerEnvSpec>, public MujocoEnv {
 
  private:
   void WriteState() {
-    State state = Allocate();
+    State state = this->Allocate();
     state["reward"_] = reward_;
     state["discount"_] = discount_;
+    RenderPixels<EnvSpec>(&state);
     // obs
     const auto& orient = Orientations();
     state["obs:orientations"_].Assign(orient.begin(), orient.size());
@@ -169,7 +178,10 @@ class WalkerEnv : public Env<WalkerEnvSpec>, public MujocoEnv {
   }
 };
 
+using WalkerEnv = WalkerEnvBase<WalkerEnvSpec>;
+using WalkerPixelEnv = WalkerEnvBase<WalkerPixelEnvSpec>;
 using WalkerEnvPool = AsyncEnvPool<WalkerEnv>;
+using WalkerPixelEnvPool = AsyncEnvPool<WalkerPixelEnv>;
 
 }  // namespace mujoco_dmc
 
@@ -70,7 +70,7 @@ class AntEnvFns {
   }
 };
 
-using AntEnvSpec = EnvSpec<AntEnvFns>;
+using AntEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<AntEnvFns>>;
 
 class AntEnv : public Env<AntEnvSpec>, public MujocoEnv {
  protected:
@@ -88,7 +88,8 @@ class AntEnv : public Env<AntEnvSpec>, public MujocoEnv {
       : Env<AntEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/ant.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         id_torso_(mj_name2id(model_, mjOBJ_XBODY, "torso")),
         terminate_when_unhealthy_(spec.config["terminate_when_unhealthy"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
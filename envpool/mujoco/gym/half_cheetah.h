@@ -58,7 +58,8 @@ class HalfCheetahEnvFns {
   }
 };
 
-using HalfCheetahEnvSpec = EnvSpec<HalfCheetahEnvFns>;
+using HalfCheetahEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<HalfCheetahEnvFns>>;
 
 class HalfCheetahEnv : public Env<HalfCheetahEnvSpec>, public MujocoEnv {
  protected:
@@ -73,7 +74,8 @@ class HalfCheetahEnv : public Env<HalfCheetahEnvSpec>, public MujocoEnv {
         MujocoEnv(
             spec.config["base_path"_] + "/mujoco/assets_gym/half_cheetah.xml",
             spec.config["frame_skip"_], spec.config["post_constraint"_],
-            spec.config["max_episode_steps"_]),
+            spec.config["max_episode_steps"_],
+            spec.config["physics_profile"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
         forward_reward_weight_(spec.config["forward_reward_weight"_]),
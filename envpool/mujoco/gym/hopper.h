@@ -60,7 +60,7 @@ class HopperEnvFns {
   }
 };
 
-using HopperEnvSpec = EnvSpec<HopperEnvFns>;
+using HopperEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<HopperEnvFns>>;
 
 class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
  protected:
@@ -77,7 +77,8 @@ class HopperEnv : public Env<HopperEnvSpec>, public MujocoEnv {
       : Env<HopperEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/hopper.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         terminate_when_unhealthy_(spec.config["terminate_when_unhealthy"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
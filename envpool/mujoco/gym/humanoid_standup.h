@@ -60,7 +60,8 @@ class HumanoidStandupEnvFns {
   }
 };
 
-using HumanoidStandupEnvSpec = EnvSpec<HumanoidStandupEnvFns>;
+using HumanoidStandupEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<HumanoidStandupEnvFns>>;
 
 class HumanoidStandupEnv : public Env<HumanoidStandupEnvSpec>,
                            public MujocoEnv {
@@ -76,7 +77,8 @@ class HumanoidStandupEnv : public Env<HumanoidStandupEnvSpec>,
         MujocoEnv(spec.config["base_path"_] +
                       "/mujoco/assets_gym/humanoidstandup.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
         contact_cost_weight_(spec.config["contact_cost_weight"_]),
@@ -54,7 +54,8 @@ class InvertedDoublePendulumEnvFns {
   }
 };
 
-using InvertedDoublePendulumEnvSpec = EnvSpec<InvertedDoublePendulumEnvFns>;
+using InvertedDoublePendulumEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<InvertedDoublePendulumEnvFns>>;
 
 class InvertedDoublePendulumEnv : public Env<InvertedDoublePendulumEnvSpec>,
                                   public MujocoEnv {
@@ -70,7 +71,8 @@ class InvertedDoublePendulumEnv : public Env<InvertedDoublePendulumEnvSpec>,
         MujocoEnv(spec.config["base_path"_] +
                       "/mujoco/assets_gym/inverted_double_pendulum.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         healthy_reward_(spec.config["healthy_reward"_]),
         healthy_z_max_(spec.config["healthy_z_max"_]),
         observation_min_(spec.config["observation_min"_]),
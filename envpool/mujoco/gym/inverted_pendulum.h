@@ -53,7 +53,8 @@ class InvertedPendulumEnvFns {
   }
 };
 
-using InvertedPendulumEnvSpec = EnvSpec<InvertedPendulumEnvFns>;
+using InvertedPendulumEnvSpec =
+    EnvSpec<mujoco_physics::MujocoEnvFns<InvertedPendulumEnvFns>>;
 
 class InvertedPendulumEnv : public Env<InvertedPendulumEnvSpec>,
                             public MujocoEnv {
@@ -67,7 +68,8 @@ class InvertedPendulumEnv : public Env<InvertedPendulumEnvSpec>,
         MujocoEnv(spec.config["base_path"_] +
                       "/mujoco/assets_gym/inverted_pendulum.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         healthy_reward_(spec.config["healthy_reward"_]),
         healthy_z_min_(spec.config["healthy_z_min"_]),
         healthy_z_max_(spec.config["healthy_z_max"_]),
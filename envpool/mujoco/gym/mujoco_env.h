@@ -21,6 +21,11 @@
 #include <mujoco.h>
 
 #include <string>
+#include <utility>
+
+#include "envpool/mujoco/jacobian.h"
+#include "envpool/mujoco/physics_profile.h"
+#include "envpool/mujoco/sub_step.h"
 
 namespace mujoco_gym {
 
@@ -39,10 +44,11 @@ class MujocoEnv {
   bool post_constraint_;
   int max_episode_steps_, elapsed_step_;
   bool done_;
+  mujoco_physics::StepJacobian jacobian_;
 
  public:
   MujocoEnv(const std::string& xml, int frame_skip, bool post_constraint,
-            int max_episode_steps)
+            int max_episode_steps, const std::string& physics_profile)
       : model_(mj_loadXML(xml.c_str(), nullptr, error_.begin(), 1000)),
         data_(mj_makeData(model_)),
         init_qpos_(new mjtNum[model_->nq]),
@@ -56,6 +62,7 @@ class MujocoEnv {
         max_episode_steps_(max_episode_steps),
         elapsed_step_(max_episode_steps + 1),
         done_(true) {
+    mujoco_physics::ApplyPhysicsProfile(model_, "gym", physics_profile);
     std::memcpy(init_qpos_, data_->qpos, sizeof(mjtNum) * model_->nq);
     std::memcpy(init_qvel_, data_->qvel, sizeof(mjtNum) * model_->nv);
   }
@@ -77,6 +84,34 @@ class MujocoEnv {
     mj_forward(model_, data_);
   }
 
+  /**
+   * Continue the episode of another env of the same task, see
+   * `AsyncEnvPool::Branch`.
+   */
+  void CopyStateFrom(const MujocoEnv& other) {
+    mj_copyData(data_, model_, other.data_);
+    elapsed_step_ = other.elapsed_step_;
+    done_ = other.done_;
+  }
+
+  /**
+   * Size (nx, nu) of the state and the control in TransitionJacobian.
+   */
+  [[nodiscard]] std::pair<int, int> TransitionDims() const {
+    return mujoco_physics::TransitionDims(model_);
+  }
+
+  /**
+   * Finite-difference Jacobians of one env step around the current state and
+   * control, with the state (qpos, qvel, act) in the tangent space of
+   * mjd_transitionFD: a is [nx, nx] and b is [nx, nu], both row-major. The
+   * frame_skip_ sub-steps are chained with the control held fixed, and the
+   * env itself is not stepped.
+   */
+  void TransitionJacobian(mjtNum eps, bool centered, mjtNum* a, mjtNum* b) {
+    jacobian_.Compute(model_, data_, frame_skip_, eps, centered, a, b);
+  }
+
   virtual void MujocoResetModel() {
     throw std::runtime_error("reset_model not implemented");
   }
@@ -85,9 +120,11 @@ class MujocoEnv {
     for (int i = 0; i < model_->nu; ++i) {
       data_->ctrl[i] = action[i];
     }
-    for (int i = 0; i < frame_skip_; ++i) {
-      mj_step(model_, data_);
+    // only the last sub-step needs to evaluate the sensors
+    for (int i = 0; i < frame_skip_ - 1; ++i) {
+      mujoco_physics::StepSkipSensor(model_, data_);
     }
+    mj_step(model_, data_);
     if (post_constraint_) {
       mj_rnePostConstraint(model_, data_);
     }
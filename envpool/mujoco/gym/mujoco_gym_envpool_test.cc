@@ -15,10 +15,13 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
 #include <random>
 #include <vector>
 
 #include "envpool/mujoco/gym/half_cheetah.h"
+#include "envpool/mujoco/sub_step.h"
 
 using MjcAction = typename mujoco_gym::HalfCheetahEnv::Action;
 using MjcState = typename mujoco_gym::HalfCheetahEnv::State;
@@ -51,3 +54,218 @@ TEST(MjcEnvPoolTest, CheckAction) {
   envpool.Send(action);
   state_vec = envpool.Recv();
 }
+
+TEST(MjcEnvPoolTest, FrameStack) {
+  auto config = mujoco_gym::HalfCheetahEnvSpec::kDefaultConfig;
+  int num_envs = 8;
+  int frame_stack = 3;
+  int obs_dim = 17;
+  config["num_envs"_] = num_envs;
+  config["frame_stack"_] = frame_stack;
+  mujoco_gym::HalfCheetahEnvSpec spec(config);
+  EXPECT_EQ(spec.state_spec["obs"_].shape,
+            std::vector<int>({frame_stack, obs_dim}));
+  mujoco_gym::HalfCheetahEnvPool envpool(spec);
+  Array all_env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    all_env_ids[i] = i;
+  }
+  envpool.Reset(all_env_ids);
+  auto state_vec = envpool.Recv();
+  MjcState state(&state_vec);
+  // the first observation fills the whole history
+  std::vector<std::vector<mjtNum>> last(num_envs);
+  for (int i = 0; i < num_envs; ++i) {
+    auto* obs = static_cast<mjtNum*>(state["obs"_][i].Data());
+    for (int k = 1; k < frame_stack; ++k) {
+      for (int j = 0; j < obs_dim; ++j) {
+        EXPECT_EQ(obs[k * obs_dim + j], obs[j]);
+      }
+    }
+    last[static_cast<int>(state["info:env_id"_][i])].assign(
+        obs, obs + frame_stack * obs_dim);
+  }
+  std::vector<Array> raw_action({Array(Spec<int>({num_envs})),
+                                 Array(Spec<int>({num_envs})),
+                                 Array(Spec<double>({num_envs, 6}))});
+  MjcAction action(&raw_action);
+  for (int i = 0; i < num_envs; ++i) {
+    action["env_id"_][i] = i;
+    action["players.env_id"_][i] = i;
+    for (int j = 0; j < 6; ++j) {
+      action["action"_][i][j] = (i + j + 1) / 100.0;
+    }
+  }
+  for (int t = 0; t < 5; ++t) {
+    envpool.Send(action);
+    state_vec = envpool.Recv();
+    // the history is shifted by one frame at each step
+    for (int i = 0; i < num_envs; ++i) {
+      int env_id = state["info:env_id"_][i];
+      auto* obs = static_cast<mjtNum*>(state["obs"_][i].Data());
+      for (int j = 0; j < (frame_stack - 1) * obs_dim; ++j) {
+        EXPECT_EQ(obs[j], last[env_id][j + obs_dim]);
+      }
+      last[env_id].assign(obs, obs + frame_stack * obs_dim);
+    }
+  }
+}
+
+TEST(MjcEnvPoolTest, Jacobians) {
+  auto config = mujoco_gym::HalfCheetahEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  int nv = 9;
+  int nu = 6;
+  int nx = 2 * nv;
+  config["num_envs"_] = num_envs;
+  mujoco_gym::HalfCheetahEnvSpec spec(config);
+  mujoco_gym::HalfCheetahEnvPool envpool(spec);
+  Array all_env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    all_env_ids[i] = i;
+  }
+  envpool.Reset(all_env_ids);
+  envpool.Recv();
+  auto make_action = [&](int n, int env_id) {
+    std::vector<Array> raw_action({Array(Spec<int>({n})),
+                                   Array(Spec<int>({n})),
+                                   Array(Spec<double>({n, nu}))});
+    MjcAction action(&raw_action);
+    for (int i = 0; i < n; ++i) {
+      action["env_id"_][i] = env_id < 0 ? i : env_id;
+      action["players.env_id"_][i] = env_id < 0 ? i : env_id;
+      for (int j = 0; j < nu; ++j) {
+        action["action"_][i][j] = (j + 1) / 10.0;
+      }
+    }
+    return raw_action;
+  };
+  envpool.Send(make_action(num_envs, -1));
+  envpool.Recv();
+  auto [a, b] = envpool.Jacobians(all_env_ids, 1e-6, true);
+  EXPECT_EQ(a.Shape(), std::vector<std::size_t>({4, 18, 18}));
+  EXPECT_EQ(b.Shape(), std::vector<std::size_t>({4, 18, 6}));
+  // b predicts the change of the next observation, which is (qpos[1:], qvel)
+  // here, when one action is perturbed
+  double delta = 1e-4;
+  auto* jac_b = static_cast<double*>(b[0].Data());
+  for (int k = 0; k < nu; ++k) {
+    auto raw_action = make_action(2, 0);
+    double u = raw_action[2][1][k];
+    raw_action[2][1][k] = u + delta;
+    auto state_vec = envpool.Branch(0, 1, raw_action);
+    MjcState state(&state_vec);
+    auto* obs0 = static_cast<mjtNum*>(state["obs"_][0].Data());
+    auto* obs1 = static_cast<mjtNum*>(state["obs"_][1].Data());
+    for (int j = 1; j < nx; ++j) {
+      double fd = (obs1[j - 1] - obs0[j - 1]) / delta;
+      double pred = jac_b[j * nu + k];
+      EXPECT_NEAR(fd, pred, 1e-3 + 1e-2 * std::abs(pred));
+    }
+  }
+}
+
+TEST(MjcEnvPoolTest, JacobiansAfterRecv) {
+  auto config = mujoco_gym::HalfCheetahEnvSpec::kDefaultConfig;
+  int num_envs = 8;
+  int batch = 3;
+  int nu = 6;
+  config["num_envs"_] = num_envs;
+  config["batch_size"_] = batch;
+  config["num_threads"_] = 4;
+  mujoco_gym::HalfCheetahEnvSpec spec(config);
+  mujoco_gym::HalfCheetahEnvPool envpool(spec);
+  Array all_env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    all_env_ids[i] = i;
+  }
+  envpool.Reset(all_env_ids);
+  for (int iter = 0; iter < 500; ++iter) {
+    auto state_vec = envpool.Recv();
+    MjcState state(&state_vec);
+    Array env_ids = state["info:env_id"_];
+    // an env is never in flight once received
+    EXPECT_NO_THROW(envpool.Jacobians(env_ids, 1e-6, false));
+    std::vector<Array> raw_action({Array(Spec<int>({batch})),
+                                   Array(Spec<int>({batch})),
+                                   Array(Spec<double>({batch, nu}))});
+    MjcAction action(&raw_action);
+    action["env_id"_] = env_ids;
+    action["players.env_id"_] = env_ids;
+    envpool.Send(raw_action);
+  }
+}
+
+// a pool which reads the sensordata of its envs
+class PeekEnvPool : public mujoco_gym::HalfCheetahEnvPool {
+ private:
+  struct PeekEnv : mujoco_gym::HalfCheetahEnv {
+    static std::vector<mjtNum> SensorData(
+        const mujoco_gym::HalfCheetahEnv& env) {
+      const mjModel* model = env.*(&PeekEnv::model_);
+      const mjData* data = env.*(&PeekEnv::data_);
+      return {data->sensordata, data->sensordata + model->nsensordata};
+    }
+  };
+
+ public:
+  using mujoco_gym::HalfCheetahEnvPool::AsyncEnvPool;
+  std::vector<mjtNum> SensorData(int env_id) {
+    return PeekEnv::SensorData(*envs_[env_id]);
+  }
+};
+
+// The bytes of every state and the sensordata of every env at each step of a
+// rollout, in the order of env_id.
+std::vector<std::vector<char>> SubStepRollout(bool skip_sensor) {
+  mujoco_physics::skip_sensor = skip_sensor;
+  auto config = mujoco_gym::HalfCheetahEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["seed"_] = 7;
+  mujoco_gym::HalfCheetahEnvSpec spec(config);
+  PeekEnvPool envpool(spec);
+  Array all_env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    all_env_ids[i] = i;
+  }
+  envpool.Reset(all_env_ids);
+  std::vector<std::vector<char>> result;
+  std::vector<Array> raw_action({Array(Spec<int>({num_envs})),
+                                 Array(Spec<int>({num_envs})),
+                                 Array(Spec<double>({num_envs, 6}))});
+  MjcAction action(&raw_action);
+  for (int t = 0; t < 300; ++t) {
+    auto state_vec = envpool.Recv();
+    MjcState state(&state_vec);
+    for (int env_id = 0; env_id < num_envs; ++env_id) {
+      int i = 0;
+      while (static_cast<int>(state["info:env_id"_][i]) != env_id) {
+        ++i;
+      }
+      std::vector<char> bytes;
+      for (auto& arr : state_vec) {
+        auto* data = static_cast<const char*>(arr[i].Data());
+        bytes.insert(bytes.end(), data, data + arr[i].size * arr.element_size);
+      }
+      auto sensor = envpool.SensorData(env_id);
+      auto* data = reinterpret_cast<const char*>(sensor.data());
+      bytes.insert(bytes.end(), data, data + sensor.size() * sizeof(mjtNum));
+      result.push_back(std::move(bytes));
+      action["env_id"_][env_id] = env_id;
+      action["players.env_id"_][env_id] = env_id;
+      for (int j = 0; j < 6; ++j) {
+        action["action"_][env_id][j] = std::sin(0.1 * t + env_id + j);
+      }
+    }
+    envpool.Send(action);
+  }
+  mujoco_physics::skip_sensor = true;
+  return result;
+}
+
+TEST(MjcEnvPoolTest, SkipSensor) {
+  // skipping the sensors of the intermediate sub-steps changes
+  // neither the observations and rewards nor the sensors
+  EXPECT_EQ(SubStepRollout(true), SubStepRollout(false));
+}
@@ -0,0 +1,48 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Unit tests for Mujoco physics_profile."""
+
+import numpy as np
+from absl.testing import absltest
+
+from envpool.mujoco.physics_fidelity import fidelity_report
+from envpool.registration import make_gym
+
+
+class _MujocoPhysicsProfileTest(absltest.TestCase):
+
+  def test_exact(self) -> None:
+    report = fidelity_report("Hopper-v4", "exact", num_steps=200)
+    self.assertEqual(report["obs_divergence"], 0.0)
+    self.assertEqual(report["reward_delta"], 0.0)
+
+  def test_fast(self) -> None:
+    for task_id in ["Hopper-v4", "Ant-v4", "CheetahRun-v1"]:
+      for profile in ["fast", "fastest"]:
+        report = fidelity_report(task_id, profile, num_steps=200)
+        self.assertTrue(np.isfinite(report["obs_divergence"]), report)
+        self.assertTrue(np.isfinite(report["return_delta"]), report)
+        # the first step starts from the same state
+        self.assertLess(report["obs_divergence_curve"][0], 0.1, report)
+        cone = "pyramidal" if profile == "fastest" else "model"
+        self.assertEqual(report["cone"], cone)
+        self.assertEqual(report["disableflags"], "model")
+
+  def test_unknown(self) -> None:
+    with self.assertRaises(ValueError):
+      make_gym("Hopper-v4", physics_profile="unknown")
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -56,7 +56,7 @@ class PusherEnvFns {
   }
 };
 
-using PusherEnvSpec = EnvSpec<PusherEnvFns>;
+using PusherEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<PusherEnvFns>>;
 
 class PusherEnv : public Env<PusherEnvSpec>, public MujocoEnv {
  protected:
@@ -70,7 +70,8 @@ class PusherEnv : public Env<PusherEnvSpec>, public MujocoEnv {
       : Env<PusherEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/pusher.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         id_tips_arm_(mj_name2id(model_, mjOBJ_XBODY, "tips_arm")),
         id_object_(mj_name2id(model_, mjOBJ_XBODY, "object")),
         id_goal_(mj_name2id(model_, mjOBJ_XBODY, "goal")),
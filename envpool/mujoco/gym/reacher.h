@@ -54,7 +54,7 @@ class ReacherEnvFns {
   }
 };
 
-using ReacherEnvSpec = EnvSpec<ReacherEnvFns>;
+using ReacherEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<ReacherEnvFns>>;
 
 class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
  protected:
@@ -67,7 +67,8 @@ class ReacherEnv : public Env<ReacherEnvSpec>, public MujocoEnv {
       : Env<ReacherEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/reacher.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         id_fingertip_(mj_name2id(model_, mjOBJ_XBODY, "fingertip")),
         id_target_(mj_name2id(model_, mjOBJ_XBODY, "target")),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
@@ -61,7 +61,7 @@ class SwimmerEnvFns {
   }
 };
 
-using SwimmerEnvSpec = EnvSpec<SwimmerEnvFns>;
+using SwimmerEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<SwimmerEnvFns>>;
 
 class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
  protected:
@@ -74,7 +74,8 @@ class SwimmerEnv : public Env<SwimmerEnvSpec>, public MujocoEnv {
       : Env<SwimmerEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/swimmer.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
         forward_reward_weight_(spec.config["forward_reward_weight"_]),
@@ -59,7 +59,7 @@ class Walker2dEnvFns {
   }
 };
 
-using Walker2dEnvSpec = EnvSpec<Walker2dEnvFns>;
+using Walker2dEnvSpec = EnvSpec<mujoco_physics::MujocoEnvFns<Walker2dEnvFns>>;
 
 class Walker2dEnv : public Env<Walker2dEnvSpec>, public MujocoEnv {
  protected:
@@ -75,7 +75,8 @@ class Walker2dEnv : public Env<Walker2dEnvSpec>, public MujocoEnv {
       : Env<Walker2dEnvSpec>(spec, env_id),
         MujocoEnv(spec.config["base_path"_] + "/mujoco/assets_gym/walker2d.xml",
                   spec.config["frame_skip"_], spec.config["post_constraint"_],
-                  spec.config["max_episode_steps"_]),
+                  spec.config["max_episode_steps"_],
+                  spec.config["physics_profile"_]),
         terminate_when_unhealthy_(spec.config["terminate_when_unhealthy"_]),
         no_pos_(spec.config["exclude_current_positions_from_observation"_]),
         ctrl_cost_weight_(spec.config["ctrl_cost_weight"_]),
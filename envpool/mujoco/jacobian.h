@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_MUJOCO_JACOBIAN_H_
+#define ENVPOOL_MUJOCO_JACOBIAN_H_
+
+#include <mujoco.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace mujoco_physics {
+
+/**
+ * Size (nx, nu) of the state and the control in StepJacobian.
+ */
+inline std::pair<int, int> TransitionDims(const mjModel* m) {
+  return {2 * m->nv + m->na, m->nu};
+}
+
+/**
+ * Finite-difference Jacobians of an env step made of n_sub_steps mj_step,
+ * with the state (qpos, qvel, act) in the tangent space of
+ * mjd_transitionFD. Owns the scratch data, so the env data is not stepped.
+ */
+class StepJacobian {
+ private:
+  // scratch copy of the env data, created on first use
+  mjData* data_;
+  std::vector<mjtNum> ai_, bi_, tmp_;
+
+ public:
+  StepJacobian() : data_(nullptr) {}
+  ~StepJacobian() {
+    if (data_ != nullptr) {
+      mj_deleteData(data_);
+    }
+  }
+  StepJacobian(const StepJacobian&) = delete;
+  StepJacobian& operator=(const StepJacobian&) = delete;
+
+  /**
+   * Linearize the step of d around its state and control: a is [nx, nx]
+   * and b is [nx, nu], both row-major. The sub-steps are chained with the
+   * control held fixed.
+   */
+  void Compute(const mjModel* m, const mjData* d, int n_sub_steps,
+               mjtNum eps, bool centered, mjtNum* a, mjtNum* b) {
+    auto [nx, nu] = TransitionDims(m);
+    if (data_ == nullptr) {
+      data_ = mj_makeData(m);
+    }
+    mj_copyData(data_, m, d);
+    ai_.resize(nx * nx);
+    bi_.resize(nx * nu);
+    tmp_.resize(nx * std::max(nx, nu));
+    for (int i = 0; i < n_sub_steps; ++i) {
+      mjtNum* sub_a = i == 0 ? a : ai_.data();
+      mjtNum* sub_b = i == 0 ? b : bi_.data();
+      mjd_transitionFD(m, data_, eps, centered, sub_a, sub_b, nullptr,
+                       nullptr);
+      if (i > 0) {
+        // a = ai * a, b = ai * b + bi
+        mju_mulMatMat(tmp_.data(), ai_.data(), a, nx, nx, nx);
+        mju_copy(a, tmp_.data(), nx * nx);
+        mju_mulMatMat(tmp_.data(), ai_.data(), b, nx, nx, nu);
+        mju_add(b, tmp_.data(), bi_.data(), nx * nu);
+      }
+      if (i + 1 < n_sub_steps) {
+        mj_step(m, data_);
+      }
+    }
+  }
+};
+
+}  // namespace mujoco_physics
+
+#endif  // ENVPOOL_MUJOCO_JACOBIAN_H_
@@ -0,0 +1,136 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Fidelity of an approximate MuJoCo physics_profile against exact physics.
+
+Usage: python -m envpool.mujoco.physics_fidelity --task HalfCheetah-v4
+"""
+
+import argparse
+import pprint
+import time
+from typing import Any, Dict, Tuple
+
+import numpy as np
+
+import envpool.mujoco.dmc.registration  # noqa: F401
+import envpool.mujoco.gym.registration  # noqa: F401
+from envpool.registration import make_gym, make_spec
+
+# opt.cone and opt.disableflags of each physics_profile, "model" if kept as
+# in the model xml; keep in sync with envpool/mujoco/physics_profile.h
+PROFILE_OPTIONS = {
+  "exact": {"cone": "model", "disableflags": "model"},
+  "fast": {"cone": "model", "disableflags": "model"},
+  "fastest": {"cone": "pyramidal", "disableflags": "model"},
+}
+
+
+def _flat_obs(obs: Any) -> np.ndarray:
+  if isinstance(obs, dict):
+    return np.concatenate(
+      [np.asarray(v).reshape(len(v), -1) for v in obs.values()], axis=1
+    )
+  return np.asarray(obs).reshape(len(obs), -1)
+
+
+def _rollout(
+  task_id: str,
+  physics_profile: str,
+  actions: np.ndarray,
+  seed: int,
+) -> Tuple[np.ndarray, np.ndarray, np.ndarray, float]:
+  num_steps, num_envs = actions.shape[:2]
+  env = make_gym(
+    task_id, num_envs=num_envs, seed=seed, physics_profile=physics_profile
+  )
+  env.reset()
+  obs, rew, done = [], [], []
+  start = time.time()
+  for action in actions:
+    result = env.step(action)
+    obs.append(_flat_obs(result[0]))
+    rew.append(result[1])
+    # (obs, rew, done, info) or (obs, rew, terminated, truncated, info)
+    done.append(result[2] | result[3] if len(result) == 5 else result[2])
+  duration = time.time() - start
+  return np.stack(obs), np.stack(rew), np.stack(done), duration
+
+
+def fidelity_report(
+  task_id: str,
+  physics_profile: str = "fast",
+  num_envs: int = 8,
+  num_steps: int = 1000,
+  seed: int = 0,
+) -> Dict[str, Any]:
+  """Compare paired exact and approximate rollouts of task_id.
+
+  Both rollouts start from the same seeds and take the same random actions.
+  Observations are compared while both envs are still in their first
+  episode, since episodes may end at different steps afterwards.
+
+  Return a dict of:
+
+  * ``speedup``: wall time of the exact rollout over the approximate one;
+  * ``obs_divergence``: mean L2 distance of the observations;
+  * ``obs_divergence_curve``: the same, per step, NaN once no env is left;
+  * ``max_obs_divergence``: max L2 distance of the observations;
+  * ``reward_delta``: mean absolute difference of the per-step rewards;
+  * ``return_delta``: difference of the mean return of the first episode;
+  * ``cone`` and ``disableflags``: the friction cone and the disable flags
+    of the approximate physics, see ``PROFILE_OPTIONS``.
+  """
+  spec = make_spec(task_id)
+  low = spec.action_space.low
+  high = spec.action_space.high
+  rng = np.random.default_rng(seed)
+  actions = rng.uniform(
+    low, high, size=(num_steps, num_envs, *spec.action_space.shape)
+  ).astype(spec.action_space.dtype)
+  obs0, rew0, done0, t0 = _rollout(task_id, "exact", actions, seed)
+  obs1, rew1, done1, t1 = _rollout(task_id, physics_profile, actions, seed)
+  # steps up to and including the first done of either rollout
+  ended = np.cumsum(done0 | done1, axis=0)
+  mask = (ended - (done0 | done1)) == 0
+  dist = np.linalg.norm(obs0 - obs1, axis=-1)
+  count = mask.sum(axis=1)
+  curve = np.where(
+    count > 0, (dist * mask).sum(axis=1) / np.maximum(count, 1), np.nan
+  )
+  return {
+    "task_id": task_id,
+    "physics_profile": physics_profile,
+    "speedup": t0 / max(t1, 1e-9),
+    "obs_divergence": float(dist[mask].mean()),
+    "obs_divergence_curve": curve,
+    "max_obs_divergence": float(dist[mask].max()),
+    "reward_delta": float(np.abs(rew0 - rew1)[mask].mean()),
+    "return_delta": float(((rew1 - rew0) * mask).sum(axis=0).mean()),
+    **PROFILE_OPTIONS[physics_profile],
+  }
+
+
+if __name__ == "__main__":
+  parser = argparse.ArgumentParser()
+  parser.add_argument("--task", type=str, default="HalfCheetah-v4")
+  parser.add_argument("--physics-profile", type=str, default="fast")
+  parser.add_argument("--num-envs", type=int, default=8)
+  parser.add_argument("--num-steps", type=int, default=1000)
+  parser.add_argument("--seed", type=int, default=0)
+  args = parser.parse_args()
+  report = fidelity_report(
+    args.task, args.physics_profile, args.num_envs, args.num_steps, args.seed
+  )
+  report.pop("obs_divergence_curve")
+  pprint.pprint(report)
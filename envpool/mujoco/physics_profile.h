@@ -0,0 +1,125 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_MUJOCO_PHYSICS_PROFILE_H_
+#define ENVPOOL_MUJOCO_PHYSICS_PROFILE_H_
+
+#include <mujoco.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "envpool/core/dict.h"
+
+namespace mujoco_physics {
+
+/**
+ * Solver settings of an approximate physics profile. A profile only trades
+ * accuracy for speed: iteration counts are upper bounds and tolerances are
+ * lower bounds of the values in the model xml.
+ *
+ * opt.disableflags is left to the model: in MuJoCo 2.2.1 every disable bit
+ * either drops a physical effect (contacts, limits, gravity, ...) instead
+ * of approximating it, drops the sensors the observations are read from, or
+ * makes the solver slower (warmstart).
+ */
+struct PhysicsPreset {
+  int iterations;
+  mjtNum tolerance;
+  int noslip_iterations;
+  int mpr_iterations;
+  mjtNum mpr_tolerance;
+  // replace the RK4 integrator with semi-implicit Euler
+  bool euler;
+  // replace elliptic friction cones with pyramidal ones, which the solver
+  // converges on in fewer iterations
+  bool pyramidal;
+};
+
+/**
+ * Presets of each (env family, physics_profile). The dmc models are more
+ * constrained (e.g., humanoid_CMU, manipulator) and keep more iterations.
+ */
+inline const std::map<std::pair<std::string, std::string>, PhysicsPreset>&
+PhysicsPresets() {
+  static const std::map<std::pair<std::string, std::string>, PhysicsPreset>
+      presets = {
+          {{"gym", "fast"}, {20, 1e-6, 0, 20, 1e-6, false, false}},
+          {{"gym", "fastest"}, {5, 1e-4, 0, 10, 1e-4, true, true}},
+          {{"dmc", "fast"}, {30, 1e-6, 0, 20, 1e-6, false, false}},
+          {{"dmc", "fastest"}, {10, 1e-4, 0, 10, 1e-4, true, true}},
+      };
+  return presets;
+}
+
+/**
+ * Adjust model->opt according to physics_profile, one of "exact" (keep the
+ * model as is), "fast" and "fastest".
+ */
+inline void ApplyPhysicsProfile(mjModel* model, const std::string& family,
+                                const std::string& physics_profile) {
+  if (physics_profile == "exact") {
+    return;
+  }
+  const auto& presets = PhysicsPresets();
+  auto it = presets.find({family, physics_profile});
+  if (it == presets.end()) {
+    throw std::invalid_argument("Unknown physics_profile \"" +
+                                physics_profile +
+                                "\", should be one of exact, fast, fastest");
+  }
+  const PhysicsPreset& p = it->second;
+  mjOption& opt = model->opt;
+  opt.iterations = std::min(opt.iterations, p.iterations);
+  opt.tolerance = std::max(opt.tolerance, p.tolerance);
+  opt.noslip_iterations = std::min(opt.noslip_iterations, p.noslip_iterations);
+  opt.mpr_iterations = std::min(opt.mpr_iterations, p.mpr_iterations);
+  opt.mpr_tolerance = std::max(opt.mpr_tolerance, p.mpr_tolerance);
+  if (p.euler && opt.integrator == mjINT_RK4) {
+    opt.integrator = mjINT_EULER;
+  }
+  if (p.pyramidal) {
+    opt.cone = mjCONE_PYRAMIDAL;
+  }
+}
+
+/**
+ * EnvFns of a gym or dmc task with the config keys shared by all of them.
+ */
+template <typename EnvFns>
+class MujocoEnvFns {
+ public:
+  static decltype(auto) DefaultConfig() {
+    return ConcatDict(
+        EnvFns::DefaultConfig(),
+        MakeDict("physics_profile"_.Bind(std::string("exact"))));
+  }
+  template <typename Config>
+  static decltype(auto) StateSpec(const Config& conf) {
+    return EnvFns::StateSpec(conf);
+  }
+  template <typename Config>
+  static decltype(auto) ActionSpec(const Config& conf) {
+    return EnvFns::ActionSpec(conf);
+  }
+};
+
+}  // namespace mujoco_physics
+
+#endif  // ENVPOOL_MUJOCO_PHYSICS_PROFILE_H_
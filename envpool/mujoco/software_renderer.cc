@@ -0,0 +1,513 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "envpool/mujoco/software_renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace mujoco_render {
+
+namespace {
+
+using Vec3 = SoftwareRenderer::Vec3;
+// camera-space position followed by the local texture coordinate
+using ClipVertex = std::array<float, 5>;
+
+constexpr int kSlices = 16;
+constexpr int kStacks = 8;
+constexpr float kPi = 3.14159265358979f;
+
+Vec3 Sub(const Vec3& a, const Vec3& b) {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+Vec3 Cross(const Vec3& a, const Vec3& b) {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+float Dot(const Vec3& a, const Vec3& b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vec3 Normalize(const Vec3& a) {
+  float norm = std::sqrt(Dot(a, a));
+  if (norm < 1e-12f) {
+    return {0, 0, 0};
+  }
+  return {a[0] / norm, a[1] / norm, a[2] / norm};
+}
+
+// camera-space coordinate of world point p, rot is row-major with the camera
+// axes as columns
+Vec3 ToCamera(const float* rot, const Vec3& p) {
+  return {rot[0] * p[0] + rot[3] * p[1] + rot[6] * p[2],
+          rot[1] * p[0] + rot[4] * p[1] + rot[7] * p[2],
+          rot[2] * p[0] + rot[5] * p[1] + rot[8] * p[2]};
+}
+
+// triangles of the surface of revolution of profile (z, rho) around z
+void AddLathe(const std::vector<std::pair<float, float>>& profile,
+              std::vector<Vec3>* out) {
+  for (std::size_t i = 0; i + 1 < profile.size(); ++i) {
+    auto [z0, r0] = profile[i];
+    auto [z1, r1] = profile[i + 1];
+    for (int j = 0; j < kSlices; ++j) {
+      float a0 = 2 * kPi * j / kSlices;
+      float a1 = 2 * kPi * (j + 1) / kSlices;
+      Vec3 p00{r0 * std::cos(a0), r0 * std::sin(a0), z0};
+      Vec3 p01{r0 * std::cos(a1), r0 * std::sin(a1), z0};
+      Vec3 p10{r1 * std::cos(a0), r1 * std::sin(a0), z1};
+      Vec3 p11{r1 * std::cos(a1), r1 * std::sin(a1), z1};
+      if (r0 > 0) {
+        out->insert(out->end(), {p00, p10, p01});
+      }
+      if (r1 > 0) {
+        out->insert(out->end(), {p01, p10, p11});
+      }
+    }
+  }
+}
+
+// profile of a sphere of radius r, the upper half shifted by +h and the lower
+// half by -h, which is a capsule of half-length h
+std::vector<std::pair<float, float>> CapsuleProfile(float r, float h) {
+  std::vector<std::pair<float, float>> profile;
+  for (int k = 0; k <= kStacks; ++k) {
+    float theta = kPi * k / kStacks;
+    float z = r * std::cos(theta);
+    float rho = r * std::sin(theta);
+    if (2 * k < kStacks) {
+      profile.emplace_back(z + h, rho);
+    } else if (2 * k > kStacks) {
+      profile.emplace_back(z - h, rho);
+    } else {
+      profile.emplace_back(h, rho);
+      profile.emplace_back(-h, rho);
+    }
+  }
+  return profile;
+}
+
+void AddBox(const Vec3& half, std::vector<Vec3>* out) {
+  auto corner = [&](int i) -> Vec3 {
+    return {(i & 1 ? 1 : -1) * half[0], (i & 2 ? 1 : -1) * half[1],
+            (i & 4 ? 1 : -1) * half[2]};
+  };
+  static const int kFaces[6][4] = {{0, 2, 6, 4}, {1, 5, 7, 3}, {0, 4, 5, 1},
+                                   {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 6, 7, 5}};
+  for (const auto& f : kFaces) {
+    out->insert(out->end(), {corner(f[0]), corner(f[1]), corner(f[2])});
+    out->insert(out->end(), {corner(f[0]), corner(f[2]), corner(f[3])});
+  }
+}
+
+// clip a triangle against the near plane into a convex polygon of at most 4
+// vertices, return the number of vertices
+int ClipNear(const ClipVertex* tri, float znear, ClipVertex* out) {
+  int n = 0;
+  for (int i = 0; i < 3; ++i) {
+    const ClipVertex& a = tri[i];
+    const ClipVertex& b = tri[(i + 1) % 3];
+    bool a_in = a[2] <= -znear;
+    bool b_in = b[2] <= -znear;
+    if (a_in) {
+      out[n++] = a;
+    }
+    if (a_in != b_in) {
+      float t = (-znear - a[2]) / (b[2] - a[2]);
+      ClipVertex c;
+      for (int k = 0; k < 5; ++k) {
+        c[k] = a[k] + t * (b[k] - a[k]);
+      }
+      out[n++] = c;
+    }
+  }
+  return n;
+}
+
+uint8_t ToByte(float x) {
+  return static_cast<uint8_t>(std::clamp(x, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+}  // namespace
+
+SoftwareRenderer::SoftwareRenderer(const mjModel* model, int width,
+                                   int height, int camera_id)
+    : model_(model),
+      width_(width),
+      height_(height),
+      camera_id_(camera_id),
+      background_{0, 0, 0} {
+  if (width <= 0 || height <= 0) {
+    throw std::invalid_argument("Render size should be positive, got " +
+                                std::to_string(width) + "x" +
+                                std::to_string(height));
+  }
+  inv_depth_.resize(width * height);
+  if (camera_id < -1 || camera_id >= model->ncam) {
+    throw std::invalid_argument("Invalid camera_id " +
+                                std::to_string(camera_id) + ", the model has " +
+                                std::to_string(model->ncam) + " cameras");
+  }
+  for (int i = 0; i < model->ngeom; ++i) {
+    if (model->geom_group[i] < 3) {
+      AddPrimitive(false, i, model->geom_type[i], model->geom_size + i * 3,
+                   model->geom_dataid[i]);
+    }
+  }
+  for (int i = 0; i < model->nsite; ++i) {
+    if (model->site_group[i] < 3) {
+      AddPrimitive(true, i, model->site_type[i], model->site_size + i * 3,
+                   -1);
+    }
+  }
+  for (int t = 0; t < model->ntex; ++t) {
+    int n = model->tex_width[t] * model->tex_height[t];
+    const mjtByte* texel = model->tex_rgb + model->tex_adr[t];
+    Vec3 mean{0, 0, 0};
+    for (int i = 0; i < n * 3; ++i) {
+      mean[i % 3] += texel[i];
+    }
+    for (auto& c : mean) {
+      c /= std::max(n, 1) * 255.0f;
+    }
+    tex_mean_.push_back(mean);
+    if (model->tex_type[t] == mjTEXTURE_SKYBOX) {
+      background_ = mean;
+    }
+  }
+}
+
+void SoftwareRenderer::AddPrimitive(bool is_site, int id, int type,
+                                    const mjtNum* size, int mesh_id) {
+  Primitive prim{is_site, id, static_cast<int>(vertices_.size()), 0, {0, 0}};
+  auto r = static_cast<float>(size[0]);
+  auto h = static_cast<float>(size[1]);
+  switch (type) {
+    case mjGEOM_PLANE: {
+      // zero size means an infinite plane
+      float far =
+          model_->vis.map.zfar * static_cast<float>(model_->stat.extent);
+      float sx = size[0] > 0 ? r : far;
+      float sy = size[1] > 0 ? h : far;
+      vertices_.insert(vertices_.end(), {{-sx, -sy, 0}, {sx, -sy, 0},
+                                         {sx, sy, 0}, {-sx, -sy, 0},
+                                         {sx, sy, 0}, {-sx, sy, 0}});
+      int matid = is_site ? -1 : model_->geom_matid[id];
+      if (matid >= 0) {
+        for (int k = 0; k < 2; ++k) {
+          float repeat = model_->mat_texrepeat[matid * 2 + k];
+          float half = k == 0 ? sx : sy;
+          prim.tex_scale[k] = model_->mat_texuniform[matid] != 0
+                                  ? repeat
+                                  : repeat / (2 * half);
+        }
+      }
+      break;
+    }
+    case mjGEOM_SPHERE:
+      AddLathe(CapsuleProfile(r, 0), &vertices_);
+      break;
+    case mjGEOM_CAPSULE:
+      AddLathe(CapsuleProfile(r, h), &vertices_);
+      break;
+    case mjGEOM_CYLINDER:
+      AddLathe({{h, 0}, {h, r}, {-h, r}, {-h, 0}}, &vertices_);
+      break;
+    case mjGEOM_ELLIPSOID: {
+      std::size_t begin = vertices_.size();
+      AddLathe(CapsuleProfile(1, 0), &vertices_);
+      for (std::size_t i = begin; i < vertices_.size(); ++i) {
+        for (int k = 0; k < 3; ++k) {
+          vertices_[i][k] *= static_cast<float>(size[k]);
+        }
+      }
+      break;
+    }
+    case mjGEOM_BOX:
+      AddBox({r, h, static_cast<float>(size[2])}, &vertices_);
+      break;
+    case mjGEOM_MESH: {
+      if (mesh_id < 0) {
+        break;
+      }
+      const float* vert = model_->mesh_vert + model_->mesh_vertadr[mesh_id] * 3;
+      const int* face = model_->mesh_face + model_->mesh_faceadr[mesh_id] * 3;
+      for (int f = 0; f < model_->mesh_facenum[mesh_id] * 3; ++f) {
+        const float* v = vert + face[f] * 3;
+        vertices_.push_back({v[0], v[1], v[2]});
+      }
+      break;
+    }
+    default:
+      // height fields are not supported
+      break;
+  }
+  prim.end = static_cast<int>(vertices_.size());
+  if (prim.end > prim.begin) {
+    primitives_.push_back(prim);
+  }
+}
+
+void SoftwareRenderer::Render(const mjData* data, uint8_t* rgb) {
+  // camera pose, rot is row-major with the camera axes as columns, the camera
+  // looks along its -z axis with y up
+  Vec3 cam_pos;
+  float rot[9];
+  float fovy;
+  if (camera_id_ >= 0) {
+    for (int k = 0; k < 3; ++k) {
+      cam_pos[k] = static_cast<float>(data->cam_xpos[camera_id_ * 3 + k]);
+    }
+    for (int k = 0; k < 9; ++k) {
+      rot[k] = static_cast<float>(data->cam_xmat[camera_id_ * 9 + k]);
+    }
+    fovy = static_cast<float>(model_->cam_fovy[camera_id_]);
+  } else {
+    float az = model_->vis.global.azimuth * kPi / 180;
+    float el = model_->vis.global.elevation * kPi / 180;
+    Vec3 forward{std::cos(el) * std::cos(az), std::cos(el) * std::sin(az),
+                 std::sin(el)};
+    auto distance = static_cast<float>(1.5 * model_->stat.extent);
+    for (int k = 0; k < 3; ++k) {
+      cam_pos[k] =
+          static_cast<float>(model_->stat.center[k]) - distance * forward[k];
+    }
+    Vec3 right = Normalize(Cross(forward, {0, 0, 1}));
+    Vec3 up = Cross(right, forward);
+    for (int k = 0; k < 3; ++k) {
+      rot[k * 3 + 0] = right[k];
+      rot[k * 3 + 1] = up[k];
+      rot[k * 3 + 2] = -forward[k];
+    }
+    fovy = model_->vis.global.fovy;
+  }
+  focal_ = 0.5f * static_cast<float>(height_) / std::tan(fovy * kPi / 360);
+  float znear = model_->vis.map.znear * static_cast<float>(model_->stat.extent);
+
+  // lights in camera space, the headlight shines along the view direction
+  ambient_ = {0, 0, 0};
+  lights_.clear();
+  if (model_->vis.headlight.active != 0) {
+    Light light;
+    light.directional = true;
+    light.dir_or_pos = {0, 0, -1};
+    for (int k = 0; k < 3; ++k) {
+      ambient_[k] += model_->vis.headlight.ambient[k];
+      light.diffuse[k] = model_->vis.headlight.diffuse[k];
+    }
+    lights_.push_back(light);
+  }
+  for (int i = 0; i < model_->nlight; ++i) {
+    if (model_->light_active[i] == 0) {
+      continue;
+    }
+    Light light;
+    light.directional = model_->light_directional[i] != 0;
+    Vec3 v;
+    for (int k = 0; k < 3; ++k) {
+      ambient_[k] += model_->light_ambient[i * 3 + k];
+      light.diffuse[k] = model_->light_diffuse[i * 3 + k];
+      v[k] = light.directional
+                 ? static_cast<float>(data->light_xdir[i * 3 + k])
+                 : static_cast<float>(data->light_xpos[i * 3 + k]) -
+                       cam_pos[k];
+    }
+    light.dir_or_pos = ToCamera(rot, v);
+    lights_.push_back(light);
+  }
+
+  std::size_t plane = static_cast<std::size_t>(width_) * height_;
+  for (int c = 0; c < 3; ++c) {
+    std::fill(rgb + c * plane, rgb + (c + 1) * plane, ToByte(background_[c]));
+  }
+  std::fill(inv_depth_.begin(), inv_depth_.end(), 0.0f);
+
+  for (const auto& prim : primitives_) {
+    int id = prim.id;
+    const float* rgba =
+        prim.is_site ? model_->site_rgba + id * 4 : model_->geom_rgba + id * 4;
+    int matid = prim.is_site ? model_->site_matid[id] : model_->geom_matid[id];
+    // as in mjv, the material color replaces the default geom color
+    if (matid >= 0 && rgba[0] == 0.5f && rgba[1] == 0.5f && rgba[2] == 0.5f &&
+        rgba[3] == 1.0f) {
+      rgba = model_->mat_rgba + matid * 4;
+    }
+    if (rgba[3] <= 0) {
+      continue;
+    }
+    int texid = matid >= 0 ? model_->mat_texid[matid] : -1;
+    Vec3 base{rgba[0], rgba[1], rgba[2]};
+    if (texid >= 0) {
+      bool sample = model_->tex_type[texid] == mjTEXTURE_2D &&
+                    (prim.tex_scale[0] != 0 || prim.tex_scale[1] != 0);
+      if (!sample) {
+        for (int k = 0; k < 3; ++k) {
+          base[k] *= tex_mean_[texid][k];
+        }
+        texid = -1;
+      }
+    }
+    // local -> camera: rotation m = rot^T * xmat and translation t
+    const mjtNum* xpos =
+        prim.is_site ? data->site_xpos + id * 3 : data->geom_xpos + id * 3;
+    const mjtNum* xmat =
+        prim.is_site ? data->site_xmat + id * 9 : data->geom_xmat + id * 9;
+    float m[9];
+    for (int j = 0; j < 3; ++j) {
+      Vec3 col = ToCamera(rot, {static_cast<float>(xmat[j]),
+                                static_cast<float>(xmat[3 + j]),
+                                static_cast<float>(xmat[6 + j])});
+      for (int i = 0; i < 3; ++i) {
+        m[i * 3 + j] = col[i];
+      }
+    }
+    Vec3 t = ToCamera(rot, {static_cast<float>(xpos[0]) - cam_pos[0],
+                            static_cast<float>(xpos[1]) - cam_pos[1],
+                            static_cast<float>(xpos[2]) - cam_pos[2]});
+    for (int v = prim.begin; v < prim.end; v += 3) {
+      ClipVertex tri[3];
+      Vec3 p[3];
+      for (int j = 0; j < 3; ++j) {
+        const Vec3& l = vertices_[v + j];
+        for (int i = 0; i < 3; ++i) {
+          p[j][i] = m[i * 3] * l[0] + m[i * 3 + 1] * l[1] +
+                    m[i * 3 + 2] * l[2] + t[i];
+          tri[j][i] = p[j][i];
+        }
+        tri[j][3] = l[0] * prim.tex_scale[0];
+        tri[j][4] = l[1] * prim.tex_scale[1];
+      }
+      if (tri[0][2] > -znear && tri[1][2] > -znear && tri[2][2] > -znear) {
+        continue;
+      }
+      Vec3 normal = Normalize(Cross(Sub(p[1], p[0]), Sub(p[2], p[0])));
+      // two-sided: shade the side facing the camera
+      if (Dot(normal, p[0]) > 0) {
+        normal = {-normal[0], -normal[1], -normal[2]};
+      }
+      Vec3 centroid;
+      for (int i = 0; i < 3; ++i) {
+        centroid[i] = (p[0][i] + p[1][i] + p[2][i]) / 3;
+      }
+      Vec3 shade = ambient_;
+      for (const auto& light : lights_) {
+        Vec3 dir = light.directional
+                       ? Normalize(light.dir_or_pos)
+                       : Normalize(Sub(centroid, light.dir_or_pos));
+        float lambert = std::max(0.0f, -Dot(normal, dir));
+        for (int k = 0; k < 3; ++k) {
+          shade[k] += light.diffuse[k] * lambert;
+        }
+      }
+      Vec3 color;
+      for (int k = 0; k < 3; ++k) {
+        color[k] = base[k] * std::min(shade[k], 1.0f);
+      }
+      ClipVertex poly[4];
+      int n = ClipNear(tri, znear, poly);
+      for (int i = 1; i + 1 < n; ++i) {
+        ClipVertex fan[3] = {poly[0], poly[i], poly[i + 1]};
+        RasterizeTriangle(fan, color, texid, rgb);
+      }
+    }
+  }
+}
+
+std::vector<float> SoftwareRenderer::Depth() const {
+  std::vector<float> depth(inv_depth_.size());
+  std::transform(inv_depth_.begin(), inv_depth_.end(), depth.begin(),
+                 [](float w) { return w > 0 ? 1.0f / w : 0.0f; });
+  return depth;
+}
+
+void SoftwareRenderer::RasterizeTriangle(const ClipVertex* v,
+                                         const Vec3& color, int texid,
+                                         uint8_t* rgb) {
+  // screen x, y (row 0 at the top), inverse depth, u / depth, v / depth
+  float s[3][5];
+  for (int j = 0; j < 3; ++j) {
+    float w = -1.0f / v[j][2];
+    s[j][0] = 0.5f * static_cast<float>(width_) + focal_ * v[j][0] * w;
+    s[j][1] = 0.5f * static_cast<float>(height_) - focal_ * v[j][1] * w;
+    s[j][2] = w;
+    s[j][3] = v[j][3] * w;
+    s[j][4] = v[j][4] * w;
+  }
+  auto edge = [](const float* a, const float* b, float x, float y) {
+    return (b[0] - a[0]) * (y - a[1]) - (b[1] - a[1]) * (x - a[0]);
+  };
+  float area = edge(s[0], s[1], s[2][0], s[2][1]);
+  if (std::abs(area) < 1e-12f) {
+    return;
+  }
+  int x0 = std::max(0, static_cast<int>(std::floor(
+                           std::min({s[0][0], s[1][0], s[2][0]}))));
+  int x1 = std::min(width_ - 1, static_cast<int>(std::ceil(std::max(
+                                    {s[0][0], s[1][0], s[2][0]}))));
+  int y0 = std::max(0, static_cast<int>(std::floor(
+                           std::min({s[0][1], s[1][1], s[2][1]}))));
+  int y1 = std::min(height_ - 1, static_cast<int>(std::ceil(std::max(
+                                     {s[0][1], s[1][1], s[2][1]}))));
+  std::size_t plane = static_cast<std::size_t>(width_) * height_;
+  const mjtByte* tex = nullptr;
+  int tw = 0;
+  int th = 0;
+  if (texid >= 0) {
+    tex = model_->tex_rgb + model_->tex_adr[texid];
+    tw = model_->tex_width[texid];
+    th = model_->tex_height[texid];
+  }
+  for (int y = y0; y <= y1; ++y) {
+    float py = static_cast<float>(y) + 0.5f;
+    for (int x = x0; x <= x1; ++x) {
+      float px = static_cast<float>(x) + 0.5f;
+      float b0 = edge(s[1], s[2], px, py) / area;
+      float b1 = edge(s[2], s[0], px, py) / area;
+      float b2 = 1.0f - b0 - b1;
+      if (b0 < 0 || b1 < 0 || b2 < 0) {
+        continue;
+      }
+      float w = b0 * s[0][2] + b1 * s[1][2] + b2 * s[2][2];
+      std::size_t idx = static_cast<std::size_t>(y) * width_ + x;
+      if (w <= inv_depth_[idx]) {
+        continue;
+      }
+      inv_depth_[idx] = w;
+      Vec3 c = color;
+      if (tex != nullptr) {
+        float u = (b0 * s[0][3] + b1 * s[1][3] + b2 * s[2][3]) / w;
+        float t = (b0 * s[0][4] + b1 * s[1][4] + b2 * s[2][4]) / w;
+        int tx = static_cast<int>((u - std::floor(u)) * tw) % tw;
+        int ty = static_cast<int>((t - std::floor(t)) * th) % th;
+        const mjtByte* texel = tex + (ty * tw + tx) * 3;
+        for (int k = 0; k < 3; ++k) {
+          c[k] *= texel[k] / 255.0f;
+        }
+      }
+      for (int k = 0; k < 3; ++k) {
+        rgb[k * plane + idx] = ToByte(c[k]);
+      }
+    }
+  }
+}
+
+}  // namespace mujoco_render
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_MUJOCO_SOFTWARE_RENDERER_H_
+#define ENVPOOL_MUJOCO_SOFTWARE_RENDERER_H_
+
+#include <mujoco.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace mujoco_render {
+
+/**
+ * Headless CPU rasterizer of the geoms and sites of an mjModel, seen from one
+ * of its cameras. It approximates the default scene of mjv/mjr: groups 0-2
+ * are visible, triangles are flat-shaded by the headlight and the model
+ * lights, planes show their 2D texture and the background is the mean color
+ * of the skybox. Shadows, reflections, specular highlights, fog and height
+ * fields are not rendered.
+ *
+ * The tessellation of each geom and site is built once from the model sizes;
+ * poses, colors and lights are read from the model and data on every frame.
+ * A renderer is not thread-safe, each env owns its own.
+ */
+class SoftwareRenderer {
+ public:
+  using Vec3 = std::array<float, 3>;
+
+  /**
+   * camera_id is an index of model cameras, or -1 for the free camera of
+   * mjv_defaultFreeCamera.
+   */
+  SoftwareRenderer(const mjModel* model, int width, int height, int camera_id);
+
+  /**
+   * Render the current frame of data into rgb of shape [3, height, width].
+   * data should be at least after mj_kinematics and mj_camlight.
+   */
+  void Render(const mjData* data, uint8_t* rgb);
+
+  /**
+   * Camera-space depth of each pixel of the last frame along the optical
+   * axis, row-major of shape [height, width]; 0 where nothing is drawn.
+   */
+  [[nodiscard]] std::vector<float> Depth() const;
+
+ private:
+  struct Primitive {
+    bool is_site;
+    int id;
+    // range of vertices_, 3 per triangle
+    int begin, end;
+    // texture coordinate per unit length of the local x and y, planes only
+    float tex_scale[2];
+  };
+  struct Light {
+    Vec3 dir_or_pos, diffuse;
+    bool directional;
+  };
+
+  const mjModel* model_;
+  int width_, height_, camera_id_;
+  std::vector<Primitive> primitives_;
+  std::vector<Vec3> vertices_;
+  std::vector<Vec3> tex_mean_;
+  Vec3 background_;
+  // per-frame state
+  std::vector<float> inv_depth_;
+  std::vector<Light> lights_;
+  Vec3 ambient_;
+  float focal_;
+
+  void AddPrimitive(bool is_site, int id, int type, const mjtNum* size,
+                    int mesh_id);
+  // v holds the camera-space position and texture coordinate of each vertex
+  void RasterizeTriangle(const std::array<float, 5>* v, const Vec3& color,
+                         int texid, uint8_t* rgb);
+};
+
+}  // namespace mujoco_render
+
+#endif  // ENVPOOL_MUJOCO_SOFTWARE_RENDERER_H_
@@ -0,0 +1,124 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/mujoco/software_renderer.h"
+
+#include <gtest/gtest.h>
+#include <mujoco.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "envpool/mujoco/dmc/mujoco_env.h"
+#include "envpool/mujoco/dmc/utils.h"
+
+// A dmc model at the pose of its first reset, rendered from camera 0.
+class RenderedModel : public mujoco_dmc::MujocoEnv {
+ public:
+  static constexpr int kWidth = 96;
+  static constexpr int kHeight = 72;
+
+  explicit RenderedModel(const std::string& xml)
+      : MujocoEnv("envpool", mujoco_dmc::GetFileContent("envpool", xml), 1,
+                  1000, "exact", {kWidth, kHeight, 0}),
+        rgb_(3 * kWidth * kHeight) {
+    ControlReset();
+    renderer_->Render(data_, rgb_.data());
+  }
+
+  [[nodiscard]] std::vector<float> Depth() const { return renderer_->Depth(); }
+
+  // another renderer of camera 0 of the same model
+  std::unique_ptr<mujoco_render::SoftwareRenderer> NewRenderer(
+      int width, int height) const {
+    return std::make_unique<mujoco_render::SoftwareRenderer>(model_, width,
+                                                             height, 0);
+  }
+
+  // Depth along the optical axis of the nearest visible geom hit by the ray
+  // through the center of each pixel, 0 if the ray hits nothing.
+  [[nodiscard]] std::vector<float> RayDepth() const {
+    const mjtNum* pos = data_->cam_xpos;
+    const mjtNum* rot = data_->cam_xmat;
+    mjtNum focal = 0.5 * kHeight / std::tan(model_->cam_fovy[0] * mjPI / 360);
+    // groups 0-2 are rendered
+    mjtByte geomgroup[mjNGROUP] = {1, 1, 1, 0, 0, 0};
+    std::vector<float> depth(kWidth * kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        // unit depth along the camera -z axis, so the ray length is the depth
+        mjtNum local[3] = {(x + 0.5 - 0.5 * kWidth) / focal,
+                           -(y + 0.5 - 0.5 * kHeight) / focal, -1};
+        mjtNum dir[3];
+        mju_mulMatVec(dir, rot, local, 3, 3);
+        int geom_id;
+        mjtNum dist = mj_ray(model_, data_, pos, dir, geomgroup, 1, -1,
+                             &geom_id);
+        depth[y * kWidth + x] = dist >= 0 ? static_cast<float>(dist) : 0.0f;
+      }
+    }
+    return depth;
+  }
+
+ private:
+  std::vector<uint8_t> rgb_;
+};
+
+// The rasterized silhouette and depth match the geoms of the model, up to the
+// tessellation and the sites, which mj_ray does not see.
+void CheckAgainstRays(const std::string& xml) {
+  RenderedModel model(xml);
+  auto depth = model.Depth();
+  auto ray = model.RayDepth();
+  int silhouette_mismatch = 0;
+  int both_hit = 0;
+  int depth_mismatch = 0;
+  for (std::size_t i = 0; i < depth.size(); ++i) {
+    bool hit = depth[i] > 0;
+    bool ray_hit = ray[i] > 0;
+    if (hit != ray_hit) {
+      ++silhouette_mismatch;
+    } else if (hit) {
+      ++both_hit;
+      if (std::abs(depth[i] - ray[i]) > 0.05f * ray[i]) {
+        ++depth_mismatch;
+      }
+    }
+  }
+  auto num_pixels = static_cast<double>(depth.size());
+  EXPECT_GT(both_hit, num_pixels / 10) << xml;
+  EXPECT_LT(silhouette_mismatch, 0.03 * num_pixels) << xml;
+  EXPECT_LT(depth_mismatch, 0.03 * both_hit) << xml;
+}
+
+TEST(SoftwareRendererTest, MatchesRayCast) {
+  for (const auto* xml : {"cartpole.xml", "cheetah.xml", "point_mass.xml",
+                          "reacher.xml", "walker.xml"}) {
+    CheckAgainstRays(xml);
+  }
+}
+
+TEST(SoftwareRendererTest, InvalidSize) {
+  RenderedModel model("cartpole.xml");
+  // the size is checked before any buffer of that size is allocated
+  EXPECT_THROW(model.NewRenderer(0, 72), std::invalid_argument);
+  EXPECT_THROW(model.NewRenderer(-96, 72), std::invalid_argument);
+  EXPECT_THROW(model.NewRenderer(-96, -72), std::invalid_argument);
+  EXPECT_NE(model.NewRenderer(96, 72), nullptr);
+}
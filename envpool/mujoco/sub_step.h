@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_MUJOCO_SUB_STEP_H_
+#define ENVPOOL_MUJOCO_SUB_STEP_H_
+
+#include <mujoco.h>
+
+namespace mujoco_physics {
+
+#ifdef ENVPOOL_TEST
+// tests turn the skipping off to compare against the full sub-steps
+inline bool skip_sensor = true;  // NOLINT
+#endif
+
+/**
+ * mj_step without the sensors (with the post-constraint pass they may
+ * trigger), for the sub-steps of an env step whose sensor values are
+ * overwritten by a later sub-step. Sensors never feed back into the
+ * dynamics, so the state is the same as after mj_step, and mjModel is left
+ * untouched. Energy is still evaluated if the model enables it. Integrators
+ * other than Euler and RK4 take a full mj_step.
+ */
+inline void StepSkipSensor(const mjModel* m, mjData* d) {
+  int integrator = m->opt.integrator;
+#ifdef ENVPOOL_TEST
+  if (!skip_sensor) {
+    integrator = -1;
+  }
+#endif
+  if (integrator != mjINT_EULER && integrator != mjINT_RK4) {
+    mj_step(m, d);
+    return;
+  }
+  // the body of mj_step, with mj_forward replaced
+  mj_checkPos(m, d);
+  mj_checkVel(m, d);
+  mj_forwardSkip(m, d, mjSTAGE_NONE, 1);
+  mj_checkAcc(m, d);
+  if (m->opt.enableflags & mjENBL_FWDINV) {
+    mj_compareFwdInv(m, d);
+  }
+  if (integrator == mjINT_RK4) {
+    mj_RungeKutta(m, d, 4);
+  } else {
+    mj_Euler(m, d);
+  }
+}
+
+/**
+ * mj_step2 without the acceleration sensors, i.e., the second half of
+ * StepSkipSensor after mj_step1. Integrators other than Euler take a full
+ * mj_step2.
+ */
+inline void Step2SkipSensor(const mjModel* m, mjData* d) {
+  int integrator = m->opt.integrator;
+#ifdef ENVPOOL_TEST
+  if (!skip_sensor) {
+    integrator = -1;
+  }
+#endif
+  if (integrator != mjINT_EULER) {
+    mj_step2(m, d);
+    return;
+  }
+  // the body of mj_step2, without mj_sensorAcc
+  mj_fwdActuation(m, d);
+  mj_fwdAcceleration(m, d);
+  mj_fwdConstraint(m, d);
+  mj_checkAcc(m, d);
+  if (m->opt.enableflags & mjENBL_FWDINV) {
+    mj_compareFwdInv(m, d);
+  }
+  mj_Euler(m, d);
+}
+
+}  // namespace mujoco_physics
+
+#endif  // ENVPOOL_MUJOCO_SUB_STEP_H_
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_PLUGIN_ENVPOOL_PLUGIN_H_
+#define ENVPOOL_PLUGIN_ENVPOOL_PLUGIN_H_
+
+/**
+ * Stable C ABI of envpool env plugins.
+ *
+ * A plugin is a shared object which only depends on this header and exports
+ * `envpool_plugin`, returning a table of functions that describe and run a
+ * single env. envpool loads it at runtime with `make("plugin:/path/lib.so")`
+ * and runs the envs in its worker threads; every env is only used by one
+ * thread at a time, but different envs run concurrently.
+ *
+ * Observations and actions are float32 C contiguous arrays of static shapes,
+ * in buffers owned by envpool. Episodes are truncated by envpool at
+ * `max_episode_steps`.
+ *
+ * Functions returning int return a negative value on failure, and
+ * `last_error` gives the message of the last failure on the calling thread.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ENVPOOL_PLUGIN_ABI_VERSION 1
+#define ENVPOOL_PLUGIN_MAX_NDIM 8
+#define ENVPOOL_PLUGIN_SYMBOL "envpool_plugin"
+#define ENVPOOL_PLUGIN_EXPORT __attribute__((visibility("default")))
+
+typedef struct {
+  int ndim;
+  int64_t shape[ENVPOOL_PLUGIN_MAX_NDIM];
+  /* bounds of every element */
+  float low, high;
+} envpool_plugin_array_t;
+
+typedef struct {
+  envpool_plugin_array_t obs;
+  envpool_plugin_array_t action;
+} envpool_plugin_spec_t;
+
+typedef struct {
+  /* ENVPOOL_PLUGIN_ABI_VERSION the plugin is compiled with */
+  int abi_version;
+  /* Describe the envs created with the `plugin_config` string `config`. */
+  int (*spec)(const char* config, envpool_plugin_spec_t* spec);
+  /* Create one env, NULL on failure. */
+  void* (*create)(const char* config, int env_id, int seed);
+  void (*destroy)(void* env);
+  /* Start a new episode and write its first observation. */
+  int (*reset)(void* env, float* obs);
+  /**
+   * Apply `action`, write the next observation and reward, and set
+   * `terminated` to nonzero when the episode ends.
+   */
+  int (*step)(void* env, const float* action, float* obs, float* reward,
+              int* terminated);
+  /* Reseed the env before its next reset, NULL if not supported. */
+  int (*seed)(void* env, int seed);
+  const char* (*last_error)(void);
+} envpool_plugin_t;
+
+/* The entry point every plugin exports. */
+ENVPOOL_PLUGIN_EXPORT const envpool_plugin_t* envpool_plugin(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // ENVPOOL_PLUGIN_ENVPOOL_PLUGIN_H_
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// An example plugin: a point mass in dim dimensions (plugin_config, 2 by
+// default) which is pushed towards the origin. The observation is the
+// position followed by the velocity, the reward is minus the distance to the
+// origin, and the episode terminates once the point is close enough.
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "envpool/plugin/envpool_plugin.h"
+
+namespace {
+
+thread_local std::string last_error;  // NOLINT
+
+const float kDt = 0.1;
+const float kGoal = 0.05;
+
+int ParseDim(const char* config) {
+  std::string s(config);
+  if (s.empty()) {
+    return 2;
+  }
+  int dim = std::stoi(s);
+  if (dim < 1) {
+    throw std::invalid_argument("dim should be positive, got " + s);
+  }
+  return dim;
+}
+
+struct PointMass {
+  int dim;
+  std::mt19937 gen;
+  std::vector<float> pos, vel;
+
+  PointMass(int dim, int seed) : dim(dim), gen(seed), pos(dim), vel(dim) {}
+
+  void WriteObs(float* obs) const {
+    for (int i = 0; i < dim; ++i) {
+      obs[i] = pos[i];
+      obs[dim + i] = vel[i];
+    }
+  }
+};
+
+template <typename Fn>
+int Guard(Fn&& fn) {
+  try {
+    return fn();
+  } catch (const std::exception& e) {
+    last_error = e.what();
+  }
+  return -1;
+}
+
+int Spec(const char* config, envpool_plugin_spec_t* spec) {
+  return Guard([&] {
+    int dim = ParseDim(config);
+    spec->obs = {1, {2 * dim}, -INFINITY, INFINITY};
+    spec->action = {1, {dim}, -1, 1};
+    return 0;
+  });
+}
+
+void* Create(const char* config, int env_id, int seed) {
+  void* env = nullptr;
+  Guard([&] {
+    env = new PointMass(ParseDim(config), seed);
+    return 0;
+  });
+  return env;
+}
+
+void Destroy(void* env) { delete static_cast<PointMass*>(env); }
+
+int Reset(void* env, float* obs) {
+  auto* p = static_cast<PointMass*>(env);
+  std::uniform_real_distribution<float> dist(-1, 1);
+  for (int i = 0; i < p->dim; ++i) {
+    p->pos[i] = dist(p->gen);
+    p->vel[i] = 0;
+  }
+  p->WriteObs(obs);
+  return 0;
+}
+
+int Step(void* env, const float* action, float* obs, float* reward,
+         int* terminated) {
+  auto* p = static_cast<PointMass*>(env);
+  float dist = 0;
+  for (int i = 0; i < p->dim; ++i) {
+    float a = std::fmin(std::fmax(action[i], -1.0F), 1.0F);
+    p->vel[i] += a * kDt;
+    p->pos[i] += p->vel[i] * kDt;
+    dist += p->pos[i] * p->pos[i];
+  }
+  dist = std::sqrt(dist);
+  p->WriteObs(obs);
+  *reward = -dist;
+  *terminated = dist < kGoal;
+  return 0;
+}
+
+int Seed(void* env, int seed) {
+  static_cast<PointMass*>(env)->gen.seed(seed);
+  return 0;
+}
+
+const char* LastError() { return last_error.c_str(); }
+
+const envpool_plugin_t kPlugin = {ENVPOOL_PLUGIN_ABI_VERSION,
+                                  Spec,
+                                  Create,
+                                  Destroy,
+                                  Reset,
+                                  Step,
+                                  Seed,
+                                  LastError};
+
+}  // namespace
+
+extern "C" const envpool_plugin_t* envpool_plugin(void) { return &kPlugin; }
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENVPOOL_PLUGIN_PLUGIN_ENV_H_
+#define ENVPOOL_PLUGIN_PLUGIN_ENV_H_
+
+#include <dlfcn.h>
+
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "envpool/core/async_envpool.h"
+#include "envpool/core/env.h"
+#include "envpool/plugin/envpool_plugin.h"
+
+namespace plugin {
+
+/**
+ * dlopen the plugin at path and return its function table. Each path is
+ * loaded once and never unloaded, since envs of any pool may still run its
+ * code.
+ */
+inline const envpool_plugin_t* LoadPlugin(const std::string& path) {
+  static std::mutex mutex;
+  static std::map<std::string, const envpool_plugin_t*> loaded;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = loaded.find(path);
+  if (it != loaded.end()) {
+    return it->second;
+  }
+  if (path.empty()) {
+    throw std::invalid_argument("plugin_path is empty");
+  }
+  void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr) {
+    throw std::runtime_error("Cannot load plugin " + path + ": " + dlerror());
+  }
+  using Entry = const envpool_plugin_t* (*)();
+  auto entry = reinterpret_cast<Entry>(dlsym(handle, ENVPOOL_PLUGIN_SYMBOL));
+  const envpool_plugin_t* plugin = entry == nullptr ? nullptr : entry();
+  if (plugin == nullptr) {
+    dlclose(handle);
+    throw std::runtime_error(path + " does not export " ENVPOOL_PLUGIN_SYMBOL);
+  }
+  if (plugin->abi_version != ENVPOOL_PLUGIN_ABI_VERSION) {
+    dlclose(handle);
+    throw std::runtime_error(
+        path + " is built for plugin ABI version " +
+        std::to_string(plugin->abi_version) + ", expected " +
+        std::to_string(ENVPOOL_PLUGIN_ABI_VERSION));
+  }
+  return loaded[path] = plugin;
+}
+
+inline void CheckCall(const envpool_plugin_t* plugin, int ret,
+                      const char* func) {
+  if (ret < 0) {
+    std::string message =
+        plugin->last_error == nullptr ? "" : plugin->last_error();
+    throw std::runtime_error(std::string("plugin ") + func +
+                             " failed: " + message);
+  }
+}
+
+inline std::vector<int> PluginShape(const envpool_plugin_array_t& array) {
+  if (array.ndim < 0 || array.ndim > ENVPOOL_PLUGIN_MAX_NDIM) {
+    throw std::runtime_error("plugin spec has invalid ndim " +
+                             std::to_string(array.ndim));
+  }
+  return std::vector<int>(array.shape, array.shape + array.ndim);
+}
+
+template <typename Config>
+envpool_plugin_spec_t PluginSpec(const Config& conf) {
+  const envpool_plugin_t* plugin = LoadPlugin(conf["plugin_path"_]);
+  envpool_plugin_spec_t spec{};
+  CheckCall(plugin, plugin->spec(conf["plugin_config"_].c_str(), &spec),
+            "spec");
+  return spec;
+}
+
+class PluginEnvFns {
+ public:
+  static decltype(auto) DefaultConfig() {
+    return MakeDict("plugin_path"_.Bind(std::string("")),
+                    "plugin_config"_.Bind(std::string("")));
+  }
+  template <typename Config>
+  static decltype(auto) StateSpec(const Config& conf) {
+    auto obs = PluginSpec(conf).obs;
+    return MakeDict(
+        "obs"_.Bind(Spec<float>(PluginShape(obs), {obs.low, obs.high})));
+  }
+  template <typename Config>
+  static decltype(auto) ActionSpec(const Config& conf) {
+    auto action = PluginSpec(conf).action;
+    std::vector<int> shape = PluginShape(action);
+    shape.insert(shape.begin(), -1);
+    return MakeDict(
+        "action"_.Bind(Spec<float>(shape, {action.low, action.high})));
+  }
+};
+
+using PluginEnvSpec = EnvSpec<PluginEnvFns>;
+
+/**
+ * An env whose dynamics live in a plugin, see envpool_plugin.h. The plugin
+ * writes the observation into obs_, which is copied into the state buffer
+ * once done is known.
+ */
+class PluginEnv : public Env<PluginEnvSpec> {
+ protected:
+  const envpool_plugin_t* plugin_;
+  void* env_;
+  std::vector<float> obs_;
+  int max_episode_steps_, elapsed_step_;
+  bool done_;
+
+ public:
+  PluginEnv(const Spec& spec, int env_id)
+      : Env<PluginEnvSpec>(spec, env_id),
+        plugin_(LoadPlugin(spec.config["plugin_path"_])),
+        env_(plugin_->create(spec.config["plugin_config"_].c_str(), env_id,
+                             seed_)),
+        max_episode_steps_(spec.config["max_episode_steps"_]),
+        elapsed_step_(max_episode_steps_ + 1),
+        done_(true) {
+    if (env_ == nullptr) {
+      CheckCall(plugin_, -1, "create");
+    }
+    // the state spec of obs has the frame_stack dimension, if any
+    std::size_t size = 1;
+    for (int d : PluginShape(PluginSpec(spec.config).obs)) {
+      size *= d;
+    }
+    obs_.resize(size);
+  }
+
+  ~PluginEnv() { plugin_->destroy(env_); }
+
+  bool IsDone() override { return done_; }
+
+  void Seed(int seed) override {
+    if (plugin_->seed != nullptr) {
+      CheckCall(plugin_, plugin_->seed(env_, seed), "seed");
+    }
+  }
+
+  void Reset() override {
+    CheckCall(plugin_, plugin_->reset(env_, obs_.data()), "reset");
+    done_ = false;
+    elapsed_step_ = 0;
+    WriteState(0.0);
+  }
+
+  void Step(const Action& action) override {
+    float reward = 0;
+    int terminated = 0;
+    CheckCall(plugin_,
+              plugin_->step(env_,
+                            static_cast<float*>(action["action"_].Data()),
+                            obs_.data(), &reward, &terminated),
+              "step");
+    ++elapsed_step_;
+    done_ = terminated != 0 || elapsed_step_ >= max_episode_steps_;
+    WriteState(reward);
+  }
+
+ private:
+  void WriteState(float reward) {
+    State state = Allocate();
+    state["obs"_].Assign(obs_.data(), obs_.size());
+    state["reward"_] = reward;
+  }
+};
+
+using PluginEnvPool = AsyncEnvPool<PluginEnv>;
+
+}  // namespace plugin
+
+#endif  // ENVPOOL_PLUGIN_PLUGIN_ENV_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 Garena Online Private Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "envpool/plugin/plugin_env.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using PluginAction = typename plugin::PluginEnv::Action;
+using PluginState = typename plugin::PluginEnv::State;
+
+static const char kExamplePlugin[] = "envpool/plugin/libexample_plugin.so";
+
+TEST(PluginEnvTest, Spec) {
+  auto config = plugin::PluginEnvSpec::kDefaultConfig;
+  config["plugin_path"_] = std::string(kExamplePlugin);
+  config["plugin_config"_] = std::string("3");
+  plugin::PluginEnvSpec spec(config);
+  EXPECT_EQ(spec.state_spec["obs"_].shape, std::vector<int>({6}));
+  EXPECT_EQ(spec.action_spec["action"_].shape, std::vector<int>({-1, 3}));
+  EXPECT_EQ(std::get<0>(spec.action_spec["action"_].bounds), -1);
+  EXPECT_EQ(std::get<1>(spec.action_spec["action"_].bounds), 1);
+  config["frame_stack"_] = 4;
+  plugin::PluginEnvSpec stacked(config);
+  EXPECT_EQ(stacked.state_spec["obs"_].shape, std::vector<int>({4, 6}));
+}
+
+TEST(PluginEnvTest, Error) {
+  auto config = plugin::PluginEnvSpec::kDefaultConfig;
+  EXPECT_THROW(plugin::PluginEnvSpec{config}, std::invalid_argument);
+  config["plugin_path"_] = std::string("envpool/plugin/no_such_plugin.so");
+  EXPECT_THROW(plugin::PluginEnvSpec{config}, std::runtime_error);
+  config["plugin_path"_] = std::string(kExamplePlugin);
+  config["plugin_config"_] = std::string("0");
+  try {
+    plugin::PluginEnvSpec spec(config);
+    FAIL();
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("dim should be positive"),
+              std::string::npos);
+  }
+}
+
+TEST(PluginEnvTest, Step) {
+  auto config = plugin::PluginEnvSpec::kDefaultConfig;
+  int num_envs = 4;
+  config["num_envs"_] = num_envs;
+  config["max_episode_steps"_] = 200;
+  config["plugin_path"_] = std::string(kExamplePlugin);
+  plugin::PluginEnvSpec spec(config);
+  plugin::PluginEnvPool envpool(spec);
+  Array env_ids(Spec<int>({num_envs}));
+  for (int i = 0; i < num_envs; ++i) {
+    env_ids[i] = i;
+  }
+  envpool.Reset(env_ids);
+  int num_done = 0;
+  for (int iter = 0; iter < 1000; ++iter) {
+    auto state_vec = envpool.Recv();
+    PluginState state(&state_vec);
+    ASSERT_EQ(state["info:env_id"_].Shape(0), num_envs);
+    // a PD controller drives the point mass to the origin
+    Array action_array(Spec<float>({num_envs, 2}));
+    for (int i = 0; i < num_envs; ++i) {
+      float pos_norm = 0;
+      for (int j = 0; j < 2; ++j) {
+        float pos = state["obs"_](i, j);
+        float vel = state["obs"_](i, j + 2);
+        action_array(i, j) = -pos - 2 * vel;
+        pos_norm += pos * pos;
+      }
+      if (static_cast<int>(state["elapsed_step"_][i]) > 0) {
+        EXPECT_FLOAT_EQ(static_cast<float>(state["reward"_][i]),
+                        -std::sqrt(pos_norm));
+      }
+      if (static_cast<bool>(state["done"_][i])) {
+        ++num_done;
+        EXPECT_FALSE(static_cast<bool>(state["trunc"_][i]));
+        EXPECT_LT(std::sqrt(pos_norm), 0.05);
+      }
+    }
+    std::vector<Array> raw_action(3);
+    PluginAction action(&raw_action);
+    action["env_id"_] = state["info:env_id"_];
+    action["players.env_id"_] = state["info:env_id"_];
+    action["action"_] = action_array;
+    envpool.Send(action);
+  }
+  EXPECT_GT(num_done, 0);
+}
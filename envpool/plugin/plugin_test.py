@@ -0,0 +1,73 @@
+# Copyright 2021 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Unit tests for envs loaded from plugins."""
+
+import os
+
+import numpy as np
+from absl.testing import absltest
+
+import envpool.plugin.registration  # noqa: F401
+from envpool.registration import make_dm, make_gym, make_spec
+
+_EXAMPLE_PLUGIN = "plugin:" + os.path.abspath(
+  "envpool/plugin/libexample_plugin.so"
+)
+
+
+class _PluginEnvTest(absltest.TestCase):
+
+  def test_spec(self) -> None:
+    spec = make_spec(_EXAMPLE_PLUGIN, plugin_config="3")
+    self.assertEqual(spec.observation_space.shape, (6,))
+    self.assertEqual(spec.action_space.shape, (3,))
+    np.testing.assert_allclose(spec.action_space.low, -1)
+    np.testing.assert_allclose(spec.action_space.high, 1)
+    self.assertRaises(
+      RuntimeError, make_spec, "plugin:envpool/plugin/no_such_plugin.so"
+    )
+    self.assertRaises(
+      RuntimeError, make_spec, _EXAMPLE_PLUGIN, plugin_config="0"
+    )
+
+  def test_step(self) -> None:
+    num_envs = 4
+    env = make_gym(_EXAMPLE_PLUGIN, num_envs=num_envs, max_episode_steps=200)
+    obs, _ = env.reset()
+    self.assertEqual(obs.shape, (num_envs, 4))
+    num_terminated = 0
+    for _ in range(200):
+      # a PD controller drives the point mass to the origin
+      action = -obs[:, :2] - 2 * obs[:, 2:]
+      obs, rew, terminated, truncated, _ = env.step(action)
+      num_terminated += terminated.sum()
+      np.testing.assert_allclose(
+        rew, -np.linalg.norm(obs[:, :2], axis=1), rtol=1e-5
+      )
+    self.assertGreater(num_terminated, 0)
+
+  def test_deterministic(self) -> None:
+    envs = [
+      make_dm(_EXAMPLE_PLUGIN, num_envs=2, seed=1, num_threads=n)
+      for n in [1, 2]
+    ]
+    ts = [e.reset() for e in envs]
+    for _ in range(50):
+      np.testing.assert_allclose(ts[0].observation.obs, ts[1].observation.obs)
+      action = np.ones((2, 2), dtype=np.float32) * 0.5
+      ts = [e.step(action, np.arange(2)) for e in envs]
+
+
+if __name__ == "__main__":
+  absltest.main()
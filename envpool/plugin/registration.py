@@ -0,0 +1,26 @@
+# Copyright 2021 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Plugin env registration."""
+
+from envpool.registration import register, register_prefix
+
+register(
+  task_id="Plugin-v0",
+  import_path="envpool.plugin",
+  spec_cls="PluginEnvSpec",
+  dm_cls="PluginDMEnvPool",
+  gym_cls="PluginGymEnvPool",
+)
+
+register_prefix("plugin:", "Plugin-v0", "plugin_path")
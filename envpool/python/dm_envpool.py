@@ -14,7 +14,8 @@
 """EnvPool meta class for dm_env API."""
 
 from abc import ABC, ABCMeta
-from typing import Any, Dict, List, Tuple, Union
+from types import MethodType
+from typing import Any, Callable, Dict, List, Sequence, Tuple, Union
 
 import dm_env
 import numpy as np
@@ -42,6 +43,41 @@ class DMEnvPoolMixin(ABC):
     return self._dm_action_spec
 
 
+def _make_to_dm(
+  state_keys: List[str], hidden_keys: Sequence[str] = ()
+) -> Callable:
+  """Make the converter of a list of states with keys state_keys.
+
+  The states of hidden_keys are dropped.
+  """
+  tree_pairs = [
+    (path, i)
+    for path, i in dm_structure("State", state_keys)
+    if state_keys[i] not in hidden_keys
+  ]
+  state_idx = list(zip(*tree_pairs))[-1]
+
+  def _to_dm(
+    self: Any,
+    state_values: List[np.ndarray],
+    reset: bool,
+    return_info: bool,
+  ) -> TimeStep:
+    values = map(lambda i: state_values[i], state_idx)
+    state = treevalue.unflatten(
+      [(path, vi) for (path, _), vi in zip(tree_pairs, values)]
+    )
+    timestep = TimeStep(
+      step_type=state.step_type,
+      observation=state.State,
+      reward=state.reward,
+      discount=state.discount,
+    )
+    return timestep
+
+  return _to_dm
+
+
 class DMEnvPoolMeta(ABCMeta):
   """Additional wrapper for EnvPool dm_env API."""
 
@@ -68,34 +104,18 @@ class DMEnvPoolMeta(ABCMeta):
     check_key_duplication(name, "state", state_keys)
     check_key_duplication(name, "action", action_keys)
 
-    tree_pairs = dm_structure("State", state_keys)
-    state_idx = list(zip(*tree_pairs))[-1]
-
-    def _to_dm(
-      self: Any,
-      state_values: List[np.ndarray],
-      reset: bool,
-      return_info: bool,
-    ) -> TimeStep:
-      values = map(lambda i: state_values[i], state_idx)
-      state = treevalue.unflatten(
-        [(path, vi) for (path, _), vi in zip(tree_pairs, values)]
-      )
-      timestep = TimeStep(
-        step_type=state.step_type,
-        observation=state.State,
-        reward=state.reward,
-        discount=state.discount,
-      )
-      return timestep
-
-    attrs["_to"] = _to_dm
+    attrs["_to"] = _make_to_dm(state_keys)
+    attrs["_make_to"] = staticmethod(_make_to_dm)
     subcls = super().__new__(cls, name, parents, attrs)
 
     def init(self: Any, spec: Any) -> None:
       """Set self.spec to EnvSpecMeta."""
       super(subcls, self).__init__(spec)
       self.spec = spec
+      self._prepare()
+      hidden_keys = spec._hidden_state_keys
+      if hidden_keys:
+        self._to = MethodType(_make_to_dm(state_keys, hidden_keys), self)
 
     setattr(subcls, "__init__", init)  # noqa: B010
     return subcls
@@ -60,6 +60,11 @@ class EnvSpecMixin(ABC):
     state_spec = [ArraySpec(*s) for s in self._state_spec]
     return dict(zip(self._state_keys, state_spec))
 
+  @property
+  def _hidden_state_keys(self: EnvSpec) -> List[str]:
+    """States left out of the observation and info, i.e. an empty payload."""
+    return [] if self.config.user_state_size > 0 else ["info:user_state"]
+
   @property
   def action_array_spec(self: EnvSpec) -> Dict[str, Any]:
     """Specs of the actions of the environment.
@@ -83,7 +88,8 @@ class EnvSpecMixin(ABC):
       k.replace("obs:", "").replace("info:", ""):
       dm_spec_transform(k.replace(":", ".").split(".")[-1], v, "obs")
       for k, v in spec.items()
-      if k.startswith("obs") or k.startswith("info")
+      if (k.startswith("obs") or k.startswith("info")) and
+      k not in self._hidden_state_keys
     }
     return to_namedtuple("State", to_nested_dict(spec))
 
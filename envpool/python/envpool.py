@@ -16,7 +16,16 @@
 import pprint
 import warnings
 from abc import ABC
-from typing import Any, Dict, List, Optional, Tuple, Union
+from typing import (
+  Any,
+  Callable,
+  Dict,
+  List,
+  Optional,
+  Sequence,
+  Tuple,
+  Union,
+)
 
 import numpy as np
 import treevalue
@@ -30,10 +39,21 @@ class EnvPoolMixin(ABC):
 
   _spec: EnvSpec
 
+  def _prepare(self: EnvPool) -> None:
+    """Precompute what send and recv read.
+
+    Nothing is then lazily written on the hot path, so Python threads driving
+    different envpools share no mutable state.
+    """
+    self._action_checked = False
+    self._last_action_type = self._spec._action_spec[-1][0]
+    self._last_action_name = self._spec._action_keys[-1]
+    self._action_names = self._spec._action_keys
+    self._all_env_ids = np.arange(self.config["num_envs"], dtype=np.int32)
+
   def _check_action(self: EnvPool, actions: List[np.ndarray]) -> None:
-    if hasattr(self, "_check_action_finished"):  # only check once
+    if self._action_checked:  # only check once
       return
-    self._check_action_finished = True
     for a, (k, v) in zip(actions, self.spec.action_array_spec.items()):
       if v.dtype != a.dtype:
         raise RuntimeError(
@@ -51,6 +71,7 @@ class EnvPoolMixin(ABC):
             f"Expected shape {('num_env', *shape)} with action \"{k}\", "
             f"got {a.shape}"
           )
+    self._action_checked = True
 
   def _from(
     self: EnvPool,
@@ -63,10 +84,6 @@ class EnvPoolMixin(ABC):
       alist = treevalue.flatten(atree)
       adict = {".".join(k): v for k, v in alist}
     else:  # only 3 keys in action_keys
-      if not hasattr(self, "_last_action_type"):
-        self._last_action_type = self._spec._action_spec[-1][0]
-      if not hasattr(self, "_last_action_name"):
-        self._last_action_name = self._spec._action_keys[-1]
       if isinstance(action, np.ndarray):
         # else it could be a jax array, when using xla
         action = action.astype(
@@ -81,8 +98,6 @@ class EnvPoolMixin(ABC):
       adict["env_id"] = env_id.astype(np.int32)
     if "players.env_id" not in adict:
       adict["players.env_id"] = adict["env_id"]
-    if not hasattr(self, "_action_names"):
-      self._action_names = self._spec._action_keys
     return list(map(lambda k: adict[k], self._action_names))  # type: ignore
 
   def __len__(self: EnvPool) -> int:
@@ -92,8 +107,6 @@ class EnvPoolMixin(ABC):
   @property
   def all_env_ids(self: EnvPool) -> np.ndarray:
     """All env_id in numpy ndarray with dtype=np.int32."""
-    if not hasattr(self, "_all_env_ids"):
-      self._all_env_ids = np.arange(self.config["num_envs"], dtype=np.int32)
     return self._all_env_ids  # type: ignore
 
   @property
@@ -115,11 +128,21 @@ class EnvPoolMixin(ABC):
     self: EnvPool,
     action: Union[Dict[str, Any], np.ndarray],
     env_id: Optional[np.ndarray] = None,
+    user_state: Optional[np.ndarray] = None,
   ) -> None:
-    """Send actions into EnvPool."""
+    """Send actions into EnvPool.
+
+    ``user_state`` of shape ``(len(env_id), user_state_size)``, e.g. the
+    hidden state of a recurrent policy, is kept by the envpool and returned
+    in ``info["user_state"]`` with the next state of each env, already in the
+    batch order of ``recv``. It is zeroed when an episode starts.
+    """
     action = self._from(action, env_id)
     self._check_action(action)
-    self._send(action)
+    if user_state is None:
+      self._send(action)
+    else:
+      self._send(action, np.asarray(user_state, dtype=np.float32))
 
   def recv(
     self: EnvPool,
@@ -138,26 +161,229 @@ class EnvPoolMixin(ABC):
     self: EnvPool,
     action: Union[Dict[str, Any], np.ndarray],
     env_id: Optional[np.ndarray] = None,
+    user_state: Optional[np.ndarray] = None,
   ) -> Union[TimeStep, Tuple]:
     """Perform one step with multiple environments in EnvPool."""
-    self.send(action, env_id)
+    self.send(action, env_id, user_state)
     return self.recv(reset=False, return_info=True)
 
   def reset(
     self: EnvPool,
     env_id: Optional[np.ndarray] = None,
+    seed: Optional[Union[int, np.ndarray]] = None,
   ) -> Union[TimeStep, Tuple]:
     """Reset envs in env_id.
 
+    If seed is given, the envs are reseeded before the reset, without
+    rebuilding the pool: an int seeds env ``i`` with ``seed + i`` as
+    ``envpool.make(..., seed=seed)`` does, and an array gives the seed of
+    each env in env_id.
+
     This behavior is not defined in async mode.
     """
     if env_id is None:
       env_id = self.all_env_ids
-    self._reset(env_id)
+    if seed is None:
+      self._reset(env_id)
+    else:
+      env_id = np.asarray(env_id, dtype=np.int32)
+      seeds = np.asarray(seed, dtype=np.int32)
+      if seeds.ndim == 0:
+        seeds = seeds + env_id
+      self._reset(env_id, seeds)
     return self.recv(
       reset=True, return_info=self.config["gym_reset_return_info"]
     )
 
+  def lane_stats(self: EnvPool) -> List[Dict[str, float]]:
+    """Step latency of each priority lane, indexed by ``env_priority``.
+
+    Latency is measured from ``send`` / ``reset`` until the env has written
+    its state, and is only recorded when ``env_priority`` defines more than
+    one lane.
+    """
+    stats = []
+    for num_steps, total_ns, max_ns in self._lane_stats():
+      stats.append(
+        {
+          "num_steps": num_steps,
+          "mean_latency_us": total_ns / max(num_steps, 1) / 1e3,
+          "max_latency_us": max_ns / 1e3,
+        }
+      )
+    return stats
+
+  def set_num_threads(self: EnvPool, num_threads: int) -> None:
+    """Resize the worker threads of a live envpool.
+
+    Extra workers are parked after their current step and new ones are
+    started on demand. With ``elastic_threads=True``, ``num_threads`` is the
+    upper bound of active workers.
+    """
+    self._set_num_threads(num_threads)
+
+  def num_active_threads(self: EnvPool) -> int:
+    """Number of worker threads which are not parked."""
+    return self._num_active_threads()
+
+  def throttle_stats(self: EnvPool) -> Dict[str, float]:
+    """Actual throughput against ``max_fps`` and ``cpu_quota``.
+
+    The averages are taken over the lifetime of this envpool; steps and busy
+    time are only counted when the corresponding limit is set.
+    """
+    (
+      elapsed_ns, num_steps, step_throttled_ns, busy_ns, cpu_throttled_ns
+    ) = self._throttle_stats()
+    elapsed = max(elapsed_ns, 1) / 1e9
+    return {
+      "fps": num_steps / elapsed,
+      "max_fps": self.config["max_fps"],
+      "step_throttled_s": step_throttled_ns / 1e9,
+      "cpu_usage": busy_ns / 1e9 / elapsed,
+      "cpu_quota": self.config["cpu_quota"],
+      "cpu_throttled_s": cpu_throttled_ns / 1e9,
+    }
+
+  def gauges(self: EnvPool) -> Dict[str, Any]:
+    """Live queue depth and buffer occupancy, read without locking.
+
+    * ``action_queue``: number of sent actions waiting for a worker;
+    * ``partial_state_buffers``: number of batches partially written;
+    * ``ready_state_buffers``: number of complete batches waiting for
+      ``recv``;
+    * ``stock_state_buffers``: number of empty batches prepared in advance;
+    * ``in_flight``: bool array of shape ``(num_envs,)``, whether each env
+      has been sent an action or reset whose state is not yet written.
+    """
+    action_queue, num_partial, num_ready, num_stock = self._gauges()
+    return {
+      "action_queue": action_queue,
+      "partial_state_buffers": num_partial,
+      "ready_state_buffers": num_ready,
+      "stock_state_buffers": num_stock,
+      "in_flight": np.asarray(self._in_flight(), dtype=bool),
+    }
+
+  def branch(
+    self: EnvPool,
+    env_id: int,
+    action: Union[Dict[str, Any], np.ndarray],
+  ) -> Union[TimeStep, Tuple]:
+    """Roll out copies of env ``env_id`` with K action sequences of length H.
+
+    ``action`` has the leading shape ``(K, H)``, and every array of the result
+    has the same leading shape; the env itself is not stepped. Steps after a
+    copy is done continue from its terminal state and should be masked out
+    with ``done``.
+    """
+
+    def flatten(x: np.ndarray) -> np.ndarray:
+      return x.reshape(-1, *x.shape[2:])
+
+    if isinstance(action, dict):
+      atree = treevalue.TreeValue(action)
+      num_branches, horizon = treevalue.flatten(atree)[0][1].shape[:2]
+      action = treevalue.jsonify(treevalue.mapping(atree, flatten))
+    else:
+      num_branches, horizon = action.shape[:2]
+      action = flatten(action)
+    env_ids = np.full(num_branches * horizon, env_id, dtype=np.int32)
+    action = self._from(action, env_ids)
+    self._check_action(action)
+    state_list = self._branch(env_id, horizon, action)
+    state_list = [
+      s.reshape(num_branches, horizon, *s.shape[1:]) for s in state_list
+    ]
+    return self._to(state_list, False, True)
+
+  def jacobians(
+    self: EnvPool,
+    env_id: Optional[np.ndarray] = None,
+    eps: float = 1e-6,
+    centered: bool = False,
+  ) -> Tuple[np.ndarray, np.ndarray]:
+    """Finite-difference dynamics Jacobians of the envs in env_id.
+
+    Return ``(A, B)`` of shape ``(n, nx, nx)`` and ``(n, nx, nu)``: the
+    derivatives of the next state w.r.t. the current state and the action,
+    linearized around the current state and the last action of each env.
+    The state is ``(qpos, qvel, act)`` in the tangent space of MuJoCo's
+    ``mjd_transitionFD``, so ``nx = 2 * nv + na``. Only MuJoCo tasks are
+    supported, and the envs must not be in flight.
+    """
+    if env_id is None:
+      env_id = self.all_env_ids
+    return self._jacobians(np.asarray(env_id, dtype=np.int32), eps, centered)
+
+  def evaluate(
+    self: EnvPool,
+    policy: Callable[[Union[TimeStep, Tuple]], Any],
+    num_episodes_per_env: Union[int, Sequence[int]],
+  ) -> np.ndarray:
+    """Run exactly ``num_episodes_per_env`` episodes in each env.
+
+    ``policy`` maps the output of ``recv`` to the actions of that batch. An
+    env which has finished its quota is no longer sent actions, so no episode
+    is started only to be discarded, and the batches shrink as envs finish.
+    The envs are reset first and must not be in flight; the envpool is
+    drained when this returns.
+
+    Return a structured array with one row per episode, ordered by env_id
+    and then by episode, with the fields ``env_id``, ``return`` and
+    ``length``.
+    """
+    if self.config.get("max_num_players", 1) != 1:
+      raise ValueError("evaluate only supports single-player envs")
+    quota = np.broadcast_to(
+      np.asarray(num_episodes_per_env, dtype=np.int64), (len(self),)
+    ).copy()
+    if (quota < 0).any():
+      raise ValueError("num_episodes_per_env should be non-negative")
+    keys = self._spec._state_keys
+    env_id_idx, reward_idx, done_idx, step_idx = map(
+      keys.index, ["info:env_id", "reward", "done", "elapsed_step"]
+    )
+    ep_return = np.zeros(len(self))
+    episodes: List[Tuple[int, float, int]] = []
+    env_ids = np.flatnonzero(quota > 0).astype(np.int32)
+    num_in_flight = len(env_ids)
+    if num_in_flight > 0:
+      self._reset(env_ids)
+    while num_in_flight > 0:
+      state = self._recv()
+      env_id = state[env_id_idx]
+      done = state[done_idx]
+      num_in_flight -= len(env_id)
+      ep_return[env_id] += state[reward_idx]
+      finished = env_id[done]
+      episodes.extend(
+        zip(finished, ep_return[finished], state[step_idx][done])
+      )
+      ep_return[finished] = 0
+      quota[finished] -= 1
+      active = ~done | (quota[env_id] > 0)
+      if not active.any():
+        continue
+      action = policy(self._to(state, False, True))
+      if not active.all():
+        if isinstance(action, dict):
+          action = treevalue.jsonify(
+            treevalue.mapping(
+              treevalue.TreeValue(action), lambda x: x[active]
+            )
+          )
+        else:
+          action = action[active]
+      self.send(action, env_id[active])
+      num_in_flight += int(active.sum())
+    result = np.array(
+      episodes,
+      dtype=[("env_id", np.int32), ("return", np.float64),
+             ("length", np.int32)],
+    )
+    return result[np.argsort(result["env_id"], kind="stable")]
+
   @property
   def config(self: EnvPool) -> Dict[str, Any]:
     """Config dict of this class."""
@@ -14,7 +14,8 @@
 """EnvPool meta class for gym.Env API."""
 
 from abc import ABC, ABCMeta
-from typing import Any, Dict, List, Tuple, Union
+from types import MethodType
+from typing import Any, Callable, Dict, List, Sequence, Tuple, Union
 
 import gym
 import numpy as np
@@ -44,6 +45,46 @@ class GymEnvPoolMixin(ABC):
     return self._gym_action_space
 
 
+def _make_to_gym(
+  state_keys: List[str], hidden_keys: Sequence[str] = ()
+) -> Callable:
+  """Make the converter of a list of states with keys state_keys.
+
+  The states of hidden_keys are dropped.
+  """
+  tree_pairs = [
+    (path, i)
+    for path, i in gym_structure(state_keys)
+    if state_keys[i] not in hidden_keys
+  ]
+  state_idx = list(zip(*tree_pairs))[-1]
+
+  new_gym_api = version.parse(gym.__version__) >= version.parse("0.26.0")
+
+  def _to_gym(
+    self: Any, state_values: List[np.ndarray], reset: bool, return_info: bool
+  ) -> Union[Any, Tuple[Any, Any], Tuple[Any, np.ndarray, np.ndarray, Any],
+             Tuple[Any, np.ndarray, np.ndarray, np.ndarray, Any]]:
+    values = map(lambda i: state_values[i], state_idx)
+    state = treevalue.unflatten(
+      [(path, vi) for (path, _), vi in zip(tree_pairs, values)]
+    )
+    if reset and not (return_info or new_gym_api):
+      return state.obs
+    info = treevalue.jsonify(state.info)
+    if not new_gym_api:
+      info["TimeLimit.truncated"] = state.trunc
+    info["elapsed_step"] = state.elapsed_step
+    if reset:
+      return state.obs, info
+    if new_gym_api:
+      terminated = state.done & ~state.trunc
+      return state.obs, state.reward, terminated, state.trunc, info
+    return state.obs, state.reward, state.done, info
+
+  return _to_gym
+
+
 class GymEnvPoolMeta(ABCMeta, gym.Env.__class__):
   """Additional wrapper for EnvPool gym.Env API."""
 
@@ -68,39 +109,18 @@ class GymEnvPoolMeta(ABCMeta, gym.Env.__class__):
     check_key_duplication(name, "state", state_keys)
     check_key_duplication(name, "action", action_keys)
 
-    tree_pairs = gym_structure(state_keys)
-    state_idx = list(zip(*tree_pairs))[-1]
-
-    new_gym_api = version.parse(gym.__version__) >= version.parse("0.26.0")
-
-    def _to_gym(
-      self: Any, state_values: List[np.ndarray], reset: bool, return_info: bool
-    ) -> Union[Any, Tuple[Any, Any], Tuple[Any, np.ndarray, np.ndarray, Any],
-               Tuple[Any, np.ndarray, np.ndarray, np.ndarray, Any]]:
-      values = map(lambda i: state_values[i], state_idx)
-      state = treevalue.unflatten(
-        [(path, vi) for (path, _), vi in zip(tree_pairs, values)]
-      )
-      if reset and not (return_info or new_gym_api):
-        return state.obs
-      info = treevalue.jsonify(state.info)
-      if not new_gym_api:
-        info["TimeLimit.truncated"] = state.trunc
-      info["elapsed_step"] = state.elapsed_step
-      if reset:
-        return state.obs, info
-      if new_gym_api:
-        terminated = state.done & ~state.trunc
-        return state.obs, state.reward, terminated, state.trunc, info
-      return state.obs, state.reward, state.done, info
-
-    attrs["_to"] = _to_gym
+    attrs["_to"] = _make_to_gym(state_keys)
+    attrs["_make_to"] = staticmethod(_make_to_gym)
     subcls = super().__new__(cls, name, parents, attrs)
 
     def init(self: Any, spec: Any) -> None:
       """Set self.spec to EnvSpecMeta."""
       super(subcls, self).__init__(spec)
       self.spec = spec
+      self._prepare()
+      hidden_keys = spec._hidden_state_keys
+      if hidden_keys:
+        self._to = MethodType(_make_to_gym(state_keys, hidden_keys), self)
 
     setattr(subcls, "__init__", init)  # noqa: B010
     return subcls
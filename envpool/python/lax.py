@@ -14,7 +14,7 @@
 """Provide xla mixin for envpool."""
 
 from abc import ABC
-from typing import Any, Callable, Dict, Optional, Tuple, Union
+from typing import Any, Callable, Dict, List, Optional, Tuple, Union
 
 from dm_env import TimeStep
 from jax import numpy as jnp
@@ -25,15 +25,33 @@ from .xla_template import make_xla
 class XlaMixin(ABC):
   """Mixin to provide XLA for envpool class."""
 
+  def _xla_state_keys(self: Any) -> List[str]:
+    """Keys of the states XLA recv appends to the padded states.
+
+    A batch is padded to batch_size envs, and to batch_size * max_num_players
+    players; a container state along its leading dim to xla_container_size.
+    Padded env_id and players.env_id are -1, which send skips. Appended are
+    the length of each container state, then the masks of the valid envs and
+    players.
+    """
+    keys = []
+    for key, spec in zip(self._state_keys, self._spec._state_spec):
+      if isinstance(spec[1], tuple):  # container: (outer_shape, inner_shape)
+        keys.append("info:length." + key.split(":")[-1])
+    return keys + ["info:mask", "info:players.mask"]
+
   def xla(self: Any) -> Tuple[Any, Callable, Callable, Callable]:
     """Return the XLA version of send/recv/step functions."""
     _handle, _recv, _send = make_xla(self)
+    _to = self._make_to(
+      self._state_keys + self._xla_state_keys(), self.spec._hidden_state_keys
+    )
 
     def recv(handle: jnp.ndarray) -> Union[TimeStep, Tuple]:
       ret = _recv(handle)
       new_handle = ret[0]
       state_list = ret[1:]
-      return new_handle, self._to(state_list, reset=False, return_info=True)
+      return new_handle, _to(self, state_list, reset=False, return_info=True)
 
     def send(
       handle: jnp.ndarray,
@@ -20,6 +20,7 @@ from typing import (
   List,
   NamedTuple,
   Optional,
+  Sequence,
   Tuple,
   Type,
   Union,
@@ -74,6 +75,10 @@ class EnvSpec(Protocol):
   def state_array_spec(self) -> Dict[str, Any]:
     """Specs of the states of the environment in ArraySpec format."""
 
+  @property
+  def _hidden_state_keys(self) -> List[str]:
+    """States left out of the observation and info."""
+
   @property
   def action_array_spec(self) -> Dict[str, Any]:
     """Specs of the actions of the environment in ArraySpec format."""
@@ -108,14 +113,21 @@ class ArraySpec(object):
     self.dtype = dtype
     self.shape = shape
     if element_wise_bounds[0]:
-      self.minimum = np.array(element_wise_bounds[0])
+      self.minimum = self._reshape(np.array(element_wise_bounds[0]))
     else:
       self.minimum = bounds[0]
     if element_wise_bounds[1]:
-      self.maximum = np.array(element_wise_bounds[1])
+      self.maximum = self._reshape(np.array(element_wise_bounds[1]))
     else:
       self.maximum = bounds[1]
 
+  def _reshape(self, bounds: np.ndarray) -> np.ndarray:
+    """Reshape flat element-wise bounds, e.g., of a stacked observation."""
+    shape = [s for s in self.shape if s != -1]
+    if len(shape) > 1 and bounds.size == np.prod(shape):
+      return bounds.reshape(shape)
+    return bounds
+
   def __repr__(self) -> str:
     """Beautify debug info."""
     return (
@@ -151,12 +163,46 @@ class EnvPool(Protocol):
   def _recv(self) -> List[np.ndarray]:
     """Cpp private _recv method."""
 
-  def _send(self, action: List[np.ndarray]) -> None:
+  def _send(
+    self,
+    action: List[np.ndarray],
+    user_state: Optional[np.ndarray] = None,
+  ) -> None:
     """Cpp private _send method."""
 
-  def _reset(self, env_id: np.ndarray) -> None:
+  def _reset(
+    self, env_id: np.ndarray, seed: Optional[np.ndarray] = None
+  ) -> None:
     """Cpp private _reset method."""
 
+  def _lane_stats(self) -> List[Tuple[int, int, int]]:
+    """Cpp private _lane_stats method."""
+
+  def _set_num_threads(self, num_threads: int) -> None:
+    """Cpp private _set_num_threads method."""
+
+  def _num_active_threads(self) -> int:
+    """Cpp private _num_active_threads method."""
+
+  def _throttle_stats(self) -> Tuple[int, int, int, int, int]:
+    """Cpp private _throttle_stats method."""
+
+  def _gauges(self) -> Tuple[int, int, int, int]:
+    """Cpp private _gauges method."""
+
+  def _in_flight(self) -> List[bool]:
+    """Cpp private _in_flight method."""
+
+  def _branch(
+    self, env_id: int, horizon: int, action: List[np.ndarray]
+  ) -> List[np.ndarray]:
+    """Cpp private _branch method."""
+
+  def _jacobians(
+    self, env_id: np.ndarray, eps: float, centered: bool
+  ) -> Tuple[np.ndarray, np.ndarray]:
+    """Cpp private _jacobians method."""
+
   def _from(
     self,
     action: Union[Dict[str, Any], np.ndarray],
@@ -205,6 +251,7 @@ class EnvPool(Protocol):
     self,
     action: Union[Dict[str, Any], np.ndarray],
     env_id: Optional[np.ndarray] = None,
+    user_state: Optional[np.ndarray] = None,
   ) -> None:
     """Envpool send wrapper."""
 
@@ -222,14 +269,53 @@ class EnvPool(Protocol):
     self,
     action: Union[Dict[str, Any], np.ndarray],
     env_id: Optional[np.ndarray] = None,
+    user_state: Optional[np.ndarray] = None,
   ) -> Union[TimeStep, Tuple]:
     """Envpool step interface that performs send/recv."""
 
   def reset(
     self,
     env_id: Optional[np.ndarray] = None,
+    seed: Optional[Union[int, np.ndarray]] = None,
   ) -> Union[TimeStep, Tuple]:
     """Envpool reset interface."""
 
+  def lane_stats(self) -> List[Dict[str, float]]:
+    """Step latency of each priority lane."""
+
+  def set_num_threads(self, num_threads: int) -> None:
+    """Resize the worker threads of a live envpool."""
+
+  def num_active_threads(self) -> int:
+    """Number of worker threads which are not parked."""
+
+  def throttle_stats(self) -> Dict[str, float]:
+    """Actual throughput against max_fps and cpu_quota."""
+
+  def gauges(self) -> Dict[str, Any]:
+    """Live queue depth and buffer occupancy."""
+
+  def branch(
+    self,
+    env_id: int,
+    action: Union[Dict[str, Any], np.ndarray],
+  ) -> Union[TimeStep, Tuple]:
+    """Roll out copies of one env with several action sequences."""
+
+  def jacobians(
+    self,
+    env_id: Optional[np.ndarray] = None,
+    eps: float = 1e-6,
+    centered: bool = False,
+  ) -> Tuple[np.ndarray, np.ndarray]:
+    """Finite-difference dynamics Jacobians of the envs in env_id."""
+
+  def evaluate(
+    self,
+    policy: Callable[[Union[TimeStep, Tuple]], Any],
+    num_episodes_per_env: Union[int, Sequence[int]],
+  ) -> np.ndarray:
+    """Run exactly num_episodes_per_env episodes in each env."""
+
   def xla(self) -> Tuple[Any, Callable, Callable, Callable]:
     """Get the xla functions."""
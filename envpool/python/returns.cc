@@ -0,0 +1,163 @@
+// Copyright 2022 Garena Online Private Limited
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "envpool/core/returns.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace py = pybind11;
+
+template <typename T>
+using CArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/**
+ * Check that arr is a [rows, batch] array.
+ */
+template <typename T>
+void CheckShape(const CArray<T>& arr, const std::string& name, py::ssize_t rows,
+                py::ssize_t batch) {
+  if (arr.ndim() != 2 || arr.shape(0) != rows || arr.shape(1) != batch) {
+    std::string shape;
+    for (py::ssize_t i = 0; i < arr.ndim(); ++i) {
+      shape += std::to_string(arr.shape(i));
+      if (arr.ndim() == 1 || i + 1 < arr.ndim()) {
+        shape += arr.ndim() == 1 ? "," : ", ";
+      }
+    }
+    throw std::invalid_argument("Expected " + name + " with shape (" +
+                                std::to_string(rows) + ", " +
+                                std::to_string(batch) + "), got (" + shape +
+                                ")");
+  }
+}
+
+struct Rollout {
+  CArray<float> value, reward, discount;
+  CArray<bool> done, trunc;
+  std::size_t num_steps, batch;
+
+  Rollout(const py::array& v, const py::array& r, const py::array& d,
+          const py::array& dn, const py::array& tr)
+      : value(v), reward(r), discount(d), done(dn), trunc(tr) {
+    if (value.ndim() != 2 || value.shape(0) < 2) {
+      throw std::invalid_argument(
+          "Expected value with shape (T + 1, B) and T >= 1");
+    }
+    py::ssize_t rows = value.shape(0);
+    py::ssize_t cols = value.shape(1);
+    CheckShape(reward, "reward", rows, cols);
+    CheckShape(discount, "discount", rows, cols);
+    CheckShape(done, "done", rows, cols);
+    CheckShape(trunc, "trunc", rows, cols);
+    num_steps = rows - 1;
+    batch = cols;
+  }
+
+  [[nodiscard]] CArray<float> Output() const {
+    return CArray<float>(std::vector<py::ssize_t>{
+        static_cast<py::ssize_t>(num_steps), static_cast<py::ssize_t>(batch)});
+  }
+};
+
+std::size_t NumThreads(int num_threads) {
+  return num_threads > 0 ? num_threads : std::thread::hardware_concurrency();
+}
+
+std::tuple<CArray<float>, CArray<float>> Gae(
+    const py::array& value, const py::array& reward, const py::array& discount,
+    const py::array& done, const py::array& trunc, float gamma,
+    float gae_lambda, int num_threads) {
+  Rollout r(value, reward, discount, done, trunc);
+  auto advantage = r.Output();
+  auto target = r.Output();
+  {
+    py::gil_scoped_release release;
+    returns::ComputeGae(r.num_steps, r.batch, r.value.data(), r.reward.data(),
+                        r.discount.data(), r.done.data(), r.trunc.data(),
+                        gamma, gae_lambda, advantage.mutable_data(),
+                        target.mutable_data(), NumThreads(num_threads));
+  }
+  return {advantage, target};
+}
+
+CArray<float> NStepReturn(const py::array& value, const py::array& reward,
+                          const py::array& discount, const py::array& done,
+                          const py::array& trunc, float gamma, int n_step,
+                          int num_threads) {
+  if (n_step < 1) {
+    throw std::invalid_argument("n_step should be >= 1, got " +
+                                std::to_string(n_step));
+  }
+  Rollout r(value, reward, discount, done, trunc);
+  auto target = r.Output();
+  {
+    py::gil_scoped_release release;
+    returns::ComputeNStepReturn(
+        r.num_steps, r.batch, r.value.data(), r.reward.data(),
+        r.discount.data(), r.done.data(), r.trunc.data(), gamma, n_step,
+        target.mutable_data(), NumThreads(num_threads));
+  }
+  return target;
+}
+
+std::tuple<CArray<float>, CArray<float>> Vtrace(
+    const py::array& value, const py::array& reward, const py::array& discount,
+    const py::array& done, const py::array& trunc, const py::array& rho,
+    float gamma, float rho_bar, float c_bar, float pg_rho_bar,
+    int num_threads) {
+  Rollout r(value, reward, discount, done, trunc);
+  CArray<float> ratio(rho);
+  CheckShape(ratio, "rho", r.num_steps, r.batch);
+  auto vs = r.Output();
+  auto pg_advantage = r.Output();
+  {
+    py::gil_scoped_release release;
+    returns::ComputeVtrace(r.num_steps, r.batch, r.value.data(),
+                           r.reward.data(), r.discount.data(), r.done.data(),
+                           r.trunc.data(), ratio.data(), gamma, rho_bar, c_bar,
+                           pg_rho_bar, vs.mutable_data(),
+                           pg_advantage.mutable_data(),
+                           NumThreads(num_threads));
+  }
+  return {vs, pg_advantage};
+}
+
+PYBIND11_MODULE(returns, m) {
+  m.doc() =
+      "Batched return computation over [T + 1, B] rollouts stacked from "
+      "consecutive recv calls.";
+  m.def("compute_gae", &Gae, py::arg("value"), py::arg("reward"),
+        py::arg("discount"), py::arg("done"), py::arg("trunc"),
+        py::arg("gamma") = 0.99, py::arg("gae_lambda") = 0.95,
+        py::arg("num_threads") = 0,
+        "Return (advantage, target) of GAE(lambda), both in shape [T, B].");
+  m.def("compute_nstep_return", &NStepReturn, py::arg("value"),
+        py::arg("reward"), py::arg("discount"), py::arg("done"),
+        py::arg("trunc"), py::arg("gamma") = 0.99, py::arg("n_step") = 1,
+        py::arg("num_threads") = 0,
+        "Return n-step bootstrapped targets in shape [T, B].");
+  m.def("compute_vtrace", &Vtrace, py::arg("value"), py::arg("reward"),
+        py::arg("discount"), py::arg("done"), py::arg("trunc"), py::arg("rho"),
+        py::arg("gamma") = 0.99, py::arg("rho_bar") = 1.0,
+        py::arg("c_bar") = 1.0, py::arg("pg_rho_bar") = 1.0,
+        py::arg("num_threads") = 0,
+        "Return (vs, pg_advantage) of V-trace, both in shape [T, B].");
+}
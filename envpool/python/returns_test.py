@@ -0,0 +1,96 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Unit test for batched return computation and speed benchmark."""
+
+import time
+from typing import Tuple
+
+import numpy as np
+from absl import logging
+from absl.testing import absltest
+
+from envpool.python.returns import (
+  compute_gae,
+  compute_nstep_return,
+  compute_vtrace,
+)
+
+
+def _rollout(
+  num_steps: int, batch: int
+) -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+  rng = np.random.default_rng(0)
+  value = rng.standard_normal((num_steps + 1, batch)).astype(np.float32)
+  reward = rng.standard_normal((num_steps + 1, batch)).astype(np.float32)
+  done = rng.random((num_steps + 1, batch)) < 0.05
+  trunc = done & (rng.random((num_steps + 1, batch)) < 0.3)
+  discount = (~done).astype(np.float32)
+  return value, reward, discount, done, trunc
+
+
+def _numpy_gae(
+  value: np.ndarray,
+  reward: np.ndarray,
+  discount: np.ndarray,
+  done: np.ndarray,
+  trunc: np.ndarray,
+  gamma: float,
+  gae_lambda: float,
+) -> np.ndarray:
+  num_steps = value.shape[0] - 1
+  boot = np.where(trunc, 1.0, discount)
+  adv = np.zeros_like(value[:-1])
+  last = np.zeros_like(value[0])
+  for t in reversed(range(num_steps)):
+    delta = reward[t + 1] + gamma * boot[t + 1] * value[t + 1] - value[t]
+    last = ~done[t] * (delta + gamma * gae_lambda * ~done[t + 1] * last)
+    adv[t] = last
+  return adv
+
+
+class _ReturnsTest(absltest.TestCase):
+
+  def test_gae(self) -> None:
+    rollout = _rollout(64, 1024)
+    t = time.time()
+    adv, target = compute_gae(*rollout, gamma=0.99, gae_lambda=0.95)
+    duration = time.time() - t
+    t = time.time()
+    ref = _numpy_gae(*rollout, gamma=0.99, gae_lambda=0.95)
+    logging.info(f"gae {duration:.6f}s, numpy {time.time() - t:.6f}s")
+    np.testing.assert_allclose(adv, ref, atol=1e-4)
+    np.testing.assert_allclose(target, ref + rollout[0][:-1], atol=1e-4)
+
+  def test_nstep(self) -> None:
+    rollout = _rollout(32, 256)
+    _, target = compute_gae(*rollout, gamma=0.9, gae_lambda=1.0)
+    nstep = compute_nstep_return(*rollout, gamma=0.9, n_step=32)
+    np.testing.assert_allclose(nstep, target, atol=1e-4)
+    one_step = compute_nstep_return(*rollout, gamma=0.9, n_step=1)
+    _, td0 = compute_gae(*rollout, gamma=0.9, gae_lambda=0.0)
+    np.testing.assert_allclose(one_step, td0, atol=1e-4)
+
+  def test_vtrace(self) -> None:
+    rollout = _rollout(32, 256)
+    rho = np.ones((32, 256), np.float32)
+    vs, pg_adv = compute_vtrace(*rollout, rho, gamma=0.99)
+    adv, target = compute_gae(*rollout, gamma=0.99, gae_lambda=1.0)
+    np.testing.assert_allclose(vs, target, atol=1e-4)
+    self.assertEqual(pg_adv.shape, (32, 256))
+    with self.assertRaisesRegex(ValueError, r"got \(33, 256\)"):
+      compute_vtrace(*rollout, np.ones((33, 256)))
+
+
+if __name__ == "__main__":
+  absltest.main()
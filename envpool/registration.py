@@ -14,7 +14,7 @@
 """Global env registry."""
 
 import importlib
-from typing import Any, Dict, List, Tuple
+from typing import Any, Dict, List, Optional, Tuple
 
 import gym
 from packaging import version
@@ -27,18 +27,68 @@ class EnvRegistry:
     """Constructor of EnvRegistry."""
     self.specs: Dict[str, Tuple[str, str, Dict[str, Any]]] = {}
     self.envpools: Dict[str, Dict[str, Tuple[str, str]]] = {}
+    self.obs_types: Dict[str, Dict[str, Tuple[str, str, str]]] = {}
+    self.prefixes: Dict[str, Tuple[str, str]] = {}
 
   def register(
-    self, task_id: str, import_path: str, spec_cls: str, dm_cls: str,
-    gym_cls: str, **kwargs: Any
+    self,
+    task_id: str,
+    import_path: str,
+    spec_cls: str,
+    dm_cls: str,
+    gym_cls: str,
+    obs_types: Optional[Dict[str, Tuple[str, str, str]]] = None,
+    default_obs_type: str = "state",
+    **kwargs: Any
   ) -> None:
-    """Register EnvSpec and EnvPool in global EnvRegistry."""
+    """Register EnvSpec and EnvPool in global EnvRegistry.
+
+    obs_types maps each alternative observation type of the task, selected by
+    `make(..., obs_type=...)`, to its (spec_cls, dm_cls, gym_cls). The
+    registered classes are the ones of default_obs_type.
+    """
     assert task_id not in self.specs
     self.specs[task_id] = (import_path, spec_cls, kwargs)
     self.envpools[task_id] = {
       "dm": (import_path, dm_cls),
       "gym": (import_path, gym_cls)
     }
+    if obs_types is not None:
+      assert default_obs_type not in obs_types
+      self.obs_types[task_id] = {
+        default_obs_type: (spec_cls, dm_cls, gym_cls),
+        **obs_types,
+      }
+
+  def register_prefix(self, prefix: str, task_id: str, key: str) -> None:
+    """Route `make(prefix + value, ...)` to `make(task_id, key=value, ...)`.
+
+    E.g., `make("plugin:/path/lib.so")` makes "Plugin-v0" with
+    `plugin_path="/path/lib.so"`.
+    """
+    assert task_id in self.specs
+    self.prefixes[prefix] = (task_id, key)
+
+  def _resolve(self, task_id: str,
+               kwargs: Dict[str, Any]) -> Tuple[str, Dict[str, Any]]:
+    """Turn a prefixed task_id into the registered one and its kwargs."""
+    for prefix, (prefix_task_id, key) in self.prefixes.items():
+      if task_id.startswith(prefix):
+        return prefix_task_id, {**kwargs, key: task_id[len(prefix):]}
+    return task_id, kwargs
+
+  def _obs_type_cls(self, task_id: str,
+                    kwargs: Dict[str, Any]) -> Optional[Tuple[str, str, str]]:
+    """Pop obs_type from kwargs and return its classes, if the task has any."""
+    if task_id not in self.obs_types or "obs_type" not in kwargs:
+      return None
+    obs_type = kwargs.pop("obs_type")
+    if obs_type not in self.obs_types[task_id]:
+      raise ValueError(
+        f"Unknown obs_type {obs_type!r} of {task_id}, should be one of "
+        f"{list(self.obs_types[task_id].keys())}."
+      )
+    return self.obs_types[task_id][obs_type]
 
   def make(self, task_id: str, env_type: str, **kwargs: Any) -> Any:
     """Make envpool."""
@@ -52,12 +102,16 @@ class EnvRegistry:
         "after resets."
       )
 
+    task_id, kwargs = self._resolve(task_id, kwargs)
     assert task_id in self.specs, \
       f"{task_id} is not supported, `envpool.list_all_envs()` may help."
     assert env_type in ["dm", "gym"]
 
     spec = self.make_spec(task_id, **kwargs)
     import_path, envpool_cls = self.envpools[task_id][env_type]
+    obs_type_cls = self._obs_type_cls(task_id, kwargs)
+    if obs_type_cls is not None:
+      envpool_cls = obs_type_cls[1 if env_type == "dm" else 2]
     return getattr(importlib.import_module(import_path), envpool_cls)(spec)
 
   def make_dm(self, task_id: str, **kwargs: Any) -> Any:
@@ -70,8 +124,12 @@ class EnvRegistry:
 
   def make_spec(self, task_id: str, **make_kwargs: Any) -> Any:
     """Make EnvSpec."""
+    task_id, make_kwargs = self._resolve(task_id, make_kwargs)
     import_path, spec_cls, kwargs = self.specs[task_id]
     kwargs = {**kwargs, **make_kwargs}
+    obs_type_cls = self._obs_type_cls(task_id, kwargs)
+    if obs_type_cls is not None:
+      spec_cls = obs_type_cls[0]
 
     # check arguments
     if "seed" in kwargs:  # Issue 214
@@ -97,6 +155,7 @@ class EnvRegistry:
 # use a global EnvRegistry
 registry = EnvRegistry()
 register = registry.register
+register_prefix = registry.register_prefix
 make = registry.make
 make_dm = registry.make_dm
 make_gym = registry.make_gym
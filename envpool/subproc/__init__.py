@@ -0,0 +1,28 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Pure-Python gym envs hosted in worker processes in EnvPool."""
+
+from envpool.python.api import py_env
+
+from .subproc_envpool import _SubprocEnvPool, _SubprocEnvSpec
+
+SubprocEnvSpec, SubprocDMEnvPool, SubprocGymEnvPool = py_env(
+  _SubprocEnvSpec, _SubprocEnvPool
+)
+
+__all__ = [
+  "SubprocEnvSpec",
+  "SubprocDMEnvPool",
+  "SubprocGymEnvPool",
+]
@@ -0,0 +1,402 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Process pool hosting pure-Python gym envs behind the EnvPool protocol.
+
+The envs are spread over ``num_threads`` worker processes. Actions and
+states are exchanged through shared memory arrays with one row per env,
+laid out from the gym spaces; the pipes to the workers only carry env ids.
+``_recv`` follows the semantics of the C++ ``StateBufferQueue``: a batch is
+made of the first ``batch_size`` envs which finish their step, in the order
+they finish, or of all envs ordered by env_id in sync mode.
+"""
+
+import multiprocessing as mp
+import os
+import traceback
+from collections import namedtuple
+from multiprocessing.connection import Connection, wait
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+import gym
+import numpy as np
+from packaging import version
+
+_STEP, _RESET, _RESET_SEED = 0, 1, 2
+_OK, _ERROR = b"\x00", b"\x01"
+_INT_MIN, _INT_MAX = -2**31, 2**31 - 1
+
+_CONFIG = {
+  "num_envs": 1,
+  "batch_size": 0,
+  "num_threads": 0,
+  "seed": 42,
+  "max_episode_steps": _INT_MAX,
+  "gym_reset_return_info": False,
+  "user_state_size": 0,
+  # gym.make(env_id, **env_kwargs), or env_fn(**env_kwargs) if env_fn is set
+  "env_id": "",
+  "env_kwargs": {},
+  "env_fn": None,
+  # multiprocessing start method, "" for the platform default
+  "start_method": "",
+}
+# the same keys and order as the C++ common_state_spec/common_action_spec
+_STATE_KEYS = [
+  "info:env_id", "info:players.env_id", "elapsed_step", "done", "reward",
+  "discount", "step_type", "trunc", "info:user_state", "obs"
+]
+_ACTION_KEYS = ["env_id", "players.env_id", "action"]
+
+_new_gym_api = version.parse(gym.__version__) >= version.parse("0.26.0")
+
+
+def _make_env(
+  env_fn: Optional[Callable], env_id: str, env_kwargs: Dict[str, Any]
+) -> gym.Env:
+  if env_fn is not None:
+    return env_fn(**env_kwargs)
+  return gym.make(env_id, **env_kwargs)
+
+
+def _scalar_spec(dtype: Any, shape: List[int], bounds: Tuple) -> Tuple:
+  return (np.dtype(dtype), shape, bounds, ([], []))
+
+
+def _space_spec(space: gym.Space, batch: bool) -> Tuple:
+  """(dtype, shape, bounds, element-wise bounds) of a Box or Discrete."""
+  lead = [-1] if batch else []
+  if isinstance(space, gym.spaces.Discrete):
+    start = int(getattr(space, "start", 0))
+    return _scalar_spec(np.int32, lead, (start, start + int(space.n) - 1))
+  if isinstance(space, gym.spaces.Box):
+    low = np.broadcast_to(space.low, space.shape).astype(space.dtype)
+    high = np.broadcast_to(space.high, space.shape).astype(space.dtype)
+    return (
+      np.dtype(space.dtype), lead + list(space.shape),
+      (low.min(), high.max()), (low.ravel().tolist(), high.ravel().tolist())
+    )
+  raise ValueError(
+    f"Only Box and Discrete spaces are supported, got {space}. Flatten the "
+    "space with a gym wrapper first."
+  )
+
+
+class _SubprocEnvSpec:
+  """EnvSpec of python envs, which probes the spaces with one env."""
+
+  _config_keys = list(_CONFIG.keys())
+  _default_config_values = tuple(_CONFIG.values())
+  _state_keys = _STATE_KEYS
+  _action_keys = _ACTION_KEYS
+
+  def __init__(self, config: Tuple):
+    """Create one env in this process to read its spaces."""
+    conf = dict(zip(self._config_keys, config))
+    if conf["batch_size"] == 0:
+      conf["batch_size"] = conf["num_envs"]
+    self._config_values = tuple(conf.values())
+    env = _make_env(conf["env_fn"], conf["env_id"], conf["env_kwargs"])
+    try:
+      obs_spec = _space_spec(env.observation_space, False)
+      action_spec = _space_spec(env.action_space, True)
+    finally:
+      env.close()
+    self._state_spec = (
+      _scalar_spec(np.int32, [], (_INT_MIN, _INT_MAX)),
+      _scalar_spec(np.int32, [-1], (_INT_MIN, _INT_MAX)),
+      _scalar_spec(np.int32, [], (_INT_MIN, _INT_MAX)),
+      _scalar_spec(np.bool_, [], (False, True)),
+      _scalar_spec(np.float32, [-1], (-np.inf, np.inf)),
+      _scalar_spec(np.float32, [-1], (0.0, 1.0)),
+      _scalar_spec(np.int32, [], (_INT_MIN, _INT_MAX)),
+      _scalar_spec(np.bool_, [], (False, True)),
+      _scalar_spec(np.float32, [conf["user_state_size"]], (-np.inf, np.inf)),
+      obs_spec,
+    )
+    self._action_spec = (
+      _scalar_spec(np.int32, [], (_INT_MIN, _INT_MAX)),
+      _scalar_spec(np.int32, [-1], (_INT_MIN, _INT_MAX)),
+      action_spec,
+    )
+
+
+_SharedSpec = namedtuple("_SharedSpec", ["raw", "dtype", "shape"])
+
+
+def _shared(dtype: Any, shape: Tuple[int, ...]) -> _SharedSpec:
+  dtype = np.dtype(dtype)
+  nbytes = max(int(np.prod(shape)) * dtype.itemsize, 1)
+  return _SharedSpec(mp.RawArray("b", nbytes), dtype, shape)
+
+
+def _view(spec: _SharedSpec) -> np.ndarray:
+  count = int(np.prod(spec.shape))
+  return np.frombuffer(spec.raw, spec.dtype, count).reshape(spec.shape)
+
+
+def _error(env_id: int) -> bytes:
+  """Message of an exception raised by env_id, -1 for the whole worker."""
+  return _ERROR + np.int32(env_id).tobytes() + traceback.format_exc().encode()
+
+
+def _worker(
+  conn: Connection,
+  env_fn: Optional[Callable],
+  env_id: str,
+  env_kwargs: Dict[str, Any],
+  env_ids: List[int],
+  seed: int,
+  max_episode_steps: int,
+  shared: Dict[str, _SharedSpec],
+) -> None:
+  """Step the envs of env_ids on the commands of the main process.
+
+  Each command is (env_id, op, seed); after writing the state of an env into
+  its shared rows, the worker sends its env_id back, or the traceback if the
+  env raised.
+  """
+  buf = {k: _view(v) for k, v in shared.items()}
+  discrete = buf["action"].ndim == 1
+  envs: Dict[int, gym.Env] = {}
+  try:
+    for i in env_ids:
+      envs[i] = _make_env(env_fn, env_id, env_kwargs)
+  except Exception:
+    conn.send_bytes(_error(-1))
+    return
+  # first reset of env i is seeded with seed + i, as the C++ envs
+  next_seed: Dict[int, Optional[int]] = {i: seed + i for i in env_ids}
+  done = {i: True for i in env_ids}
+
+  def reset(i: int) -> None:
+    env, s = envs[i], next_seed[i]
+    next_seed[i] = None
+    if _new_gym_api:
+      obs = env.reset(seed=s)[0] if s is not None else env.reset()[0]
+    else:
+      if s is not None:
+        env.seed(s)
+      obs = env.reset()
+    done[i] = False
+    buf["obs"][i] = obs
+    buf["reward"][i] = 0
+    buf["elapsed_step"][i] = 0
+    buf["done"][i] = False
+    buf["trunc"][i] = False
+    buf["discount"][i] = 1
+    buf["step_type"][i] = 0
+
+  def step(i: int) -> None:
+    action = buf["action"][i]
+    result = envs[i].step(int(action) if discrete else action.copy())
+    if len(result) == 5:
+      obs, reward, terminated, truncated, _ = result
+    else:
+      obs, reward, d, info = result
+      truncated = info.get("TimeLimit.truncated", False)
+      terminated = d and not truncated
+    elapsed = buf["elapsed_step"][i] + 1
+    truncated = truncated or elapsed >= max_episode_steps
+    done[i] = bool(terminated or truncated)
+    buf["obs"][i] = obs
+    buf["reward"][i] = reward
+    buf["elapsed_step"][i] = elapsed
+    buf["done"][i] = done[i]
+    buf["trunc"][i] = truncated and not terminated
+    buf["discount"][i] = not done[i]
+    buf["step_type"][i] = 2 if done[i] else 1
+
+  while True:
+    msg = conn.recv_bytes()
+    if not msg:
+      break
+    for i, op, s in np.frombuffer(msg, np.int32).reshape(-1, 3).tolist():
+      try:
+        if op == _RESET_SEED:
+          next_seed[i] = s
+        # as the C++ envs, a done env is reset instead of stepped
+        if op != _STEP or done[i]:
+          reset(i)
+        else:
+          step(i)
+      except Exception:
+        # the env is reset by its next command, as after a done step
+        done[i] = True
+        conn.send_bytes(_error(i))
+        continue
+      conn.send_bytes(_OK + np.int32(i).tobytes())
+  for env in envs.values():
+    env.close()
+
+
+class _SubprocEnvPool:
+  """EnvPool of python envs hosted in worker processes."""
+
+  _state_keys = _STATE_KEYS
+  _action_keys = _ACTION_KEYS
+
+  def __init__(self, spec: _SubprocEnvSpec):
+    """Start the worker processes and allocate the shared rows."""
+    self._spec = spec
+    conf = dict(zip(spec._config_keys, spec._config_values))
+    self._num_envs = conf["num_envs"]
+    self._batch_size = conf["batch_size"]
+    num_workers = conf["num_threads"] or os.cpu_count() or 1
+    self._num_workers = min(num_workers, self._num_envs)
+    state_spec = dict(zip(self._state_keys, spec._state_spec))
+    action_dtype, action_shape = spec._action_spec[-1][:2]
+    # one row per env, without the player dimension -1
+    shared = {
+      k.split(":")[-1]: _shared(
+        dtype, (self._num_envs, *[s for s in shape if s != -1])
+      )
+      for k, (dtype, shape, *_) in state_spec.items()
+      if not k.startswith("info:")
+    }
+    shared["action"] = _shared(
+      action_dtype, (self._num_envs, *action_shape[1:])
+    )
+    self._buf = {k: _view(v) for k, v in shared.items()}
+    # only read and written by this process
+    self._user_state = np.zeros(
+      (self._num_envs, conf["user_state_size"]), dtype=np.float32
+    )
+    ctx = mp.get_context(conf["start_method"] or None)
+    self._conns: List[Connection] = []
+    self._procs: List[Any] = []
+    for w in range(self._num_workers):
+      parent, child = ctx.Pipe()
+      env_ids = list(range(w, self._num_envs, self._num_workers))
+      proc = ctx.Process(
+        target=_worker,
+        args=(
+          child, conf["env_fn"], conf["env_id"], conf["env_kwargs"], env_ids,
+          conf["seed"], conf["max_episode_steps"], shared
+        ),
+        daemon=True,
+      )
+      proc.start()
+      child.close()
+      self._conns.append(parent)
+      self._procs.append(proc)
+    self._ready: List[int] = []
+    # envs sent a step or reset whose state is not received yet
+    self._num_in_flight = 0
+    # set when a worker failed to create its envs, which never reply
+    self._broken: Optional[str] = None
+
+  def _dispatch(self, env_ids: np.ndarray, op: int, seeds: Any = 0) -> None:
+    self._check_broken()
+    cmds = np.empty((len(env_ids), 3), dtype=np.int32)
+    cmds[:, 0] = env_ids
+    cmds[:, 1] = op
+    cmds[:, 2] = seeds
+    self._num_in_flight += len(env_ids)
+    worker = cmds[:, 0] % self._num_workers
+    for w in np.unique(worker):
+      self._conns[w].send_bytes(cmds[worker == w].tobytes())
+
+  def _send(
+    self,
+    action: List[np.ndarray],
+    user_state: Optional[np.ndarray] = None,
+  ) -> None:
+    env_ids = np.asarray(action[0], dtype=np.int32)
+    if user_state is not None:
+      if user_state.shape != (len(env_ids), self._user_state.shape[1]):
+        raise ValueError(
+          f"Expected user_state of shape "
+          f"{(len(env_ids), self._user_state.shape[1])}, "
+          f"got {user_state.shape}"
+        )
+      self._user_state[env_ids] = user_state
+    self._buf["action"][env_ids] = action[-1]
+    self._dispatch(env_ids, _STEP)
+
+  def _reset(
+    self, env_ids: np.ndarray, seeds: Optional[np.ndarray] = None
+  ) -> None:
+    env_ids = np.asarray(env_ids, dtype=np.int32)
+    if seeds is None:
+      self._dispatch(env_ids, _RESET)
+    else:
+      self._dispatch(env_ids, _RESET_SEED, np.asarray(seeds, np.int32))
+
+  def _check_broken(self) -> None:
+    if self._broken is not None:
+      raise RuntimeError(
+        "A worker process failed to create its envs:\n" + self._broken
+      )
+
+  def _recv(self) -> List[np.ndarray]:
+    self._check_broken()
+    # as the C++ pool, the batch shrinks to the envs in flight
+    batch_size = min(self._batch_size, self._num_in_flight)
+    while len(self._ready) < batch_size:
+      for conn in wait(self._conns):
+        while conn.poll():
+          msg = conn.recv_bytes()
+          env_id = int(np.frombuffer(msg[1:5], np.int32)[0])
+          if msg[:1] == _OK:
+            self._ready.append(env_id)
+            continue
+          if env_id < 0:
+            self._broken = msg[5:].decode()
+            self._check_broken()
+          # the env is no longer in flight, the others are still collected
+          # by the next recv
+          self._num_in_flight -= 1
+          raise RuntimeError(
+            f"Python env {env_id} raised an exception:\n" + msg[5:].decode()
+          )
+    ids = np.array(self._ready[:batch_size], dtype=np.int32)
+    del self._ready[:batch_size]
+    self._num_in_flight -= batch_size
+    if self._batch_size == self._num_envs:
+      ids.sort()
+    buf = self._buf
+    # a new episode starts from a zero payload
+    self._user_state[ids[buf["elapsed_step"][ids] == 0]] = 0
+    return [
+      ids,
+      ids.copy(),
+      buf["elapsed_step"][ids],
+      buf["done"][ids],
+      buf["reward"][ids],
+      buf["discount"][ids],
+      buf["step_type"][ids],
+      buf["trunc"][ids],
+      self._user_state[ids],
+      buf["obs"][ids],
+    ]
+
+  def close(self) -> None:
+    """Stop the worker processes."""
+    for conn in self._conns:
+      try:
+        conn.send_bytes(b"")
+      except (BrokenPipeError, OSError):
+        pass
+    for proc in self._procs:
+      proc.join(timeout=1)
+      if proc.is_alive():
+        proc.terminate()
+    for conn in self._conns:
+      conn.close()
+    self._conns, self._procs = [], []
+
+  def __del__(self) -> None:
+    """Stop the worker processes with the pool."""
+    if getattr(self, "_procs", None):
+      self.close()
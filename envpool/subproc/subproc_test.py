@@ -0,0 +1,174 @@
+# Copyright 2022 Garena Online Private Limited
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Unit tests for pure-Python envs hosted in worker processes."""
+
+import time
+from typing import Any, Dict, Optional, Tuple
+
+import gym
+import numpy as np
+from absl.testing import absltest
+
+import envpool.subproc.registration  # noqa: F401
+from envpool.registration import make_dm, make_gym, make_spec
+
+
+class _WalkEnv(gym.Env):
+  """A random walk which terminates after `length` steps."""
+
+  def __init__(self, length: int = 5, sleep: float = 0.0) -> None:
+    self.length, self.sleep = length, sleep
+    self.observation_space = gym.spaces.Box(-np.inf, np.inf, (2,), np.float32)
+    self.action_space = gym.spaces.Discrete(3)
+    self.rng = np.random.default_rng()
+
+  def reset(
+    self,
+    seed: Optional[int] = None,
+    options: Optional[Dict[str, Any]] = None,
+  ) -> Tuple[np.ndarray, Dict[str, Any]]:
+    if seed is not None:
+      self.rng = np.random.default_rng(seed)
+    self.t = 0
+    self.pos = self.rng.uniform(-1, 1)
+    return self._obs(), {}
+
+  def step(self, action: int) -> Tuple[np.ndarray, float, bool, bool, Dict]:
+    time.sleep(self.sleep)
+    self.t += 1
+    self.pos += action - 1
+    return self._obs(), float(action), self.t >= self.length, False, {}
+
+  def _obs(self) -> np.ndarray:
+    return np.array([self.pos, self.t], dtype=np.float32)
+
+
+class _TupleObsEnv(_WalkEnv):
+
+  def __init__(self) -> None:
+    super().__init__()
+    self.observation_space = gym.spaces.Tuple(
+      [gym.spaces.Discrete(2), gym.spaces.Discrete(2)]
+    )
+
+
+class _BadEnv(_WalkEnv):
+  """A random walk which raises on action 2."""
+
+  def step(self, action: int) -> Tuple[np.ndarray, float, bool, bool, Dict]:
+    if action == 2:
+      raise ValueError("bad step")
+    return super().step(action)
+
+
+class _SubprocEnvPoolTest(absltest.TestCase):
+
+  def test_spec(self) -> None:
+    spec = make_spec("PythonEnv-v0", env_fn=_WalkEnv)
+    self.assertEqual(spec.observation_space.shape, (2,))
+    self.assertEqual(spec.action_space.n, 3)
+    self.assertRaises(
+      ValueError, make_spec, "PythonEnv-v0", env_fn=_TupleObsEnv
+    )
+
+  def test_sync(self) -> None:
+    num_envs = 4
+    env = make_gym(
+      "PythonEnv-v0",
+      env_fn=_WalkEnv,
+      env_kwargs={"length": 5},
+      num_envs=num_envs,
+      num_threads=2,
+    )
+    obs0, _ = env.reset()
+    self.assertEqual(obs0.shape, (num_envs, 2))
+    np.testing.assert_allclose(obs0[:, 1], 0)
+    for t in range(1, 12):
+      action = np.arange(num_envs) % 3
+      obs, rew, term, trunc, info = env.step(action)
+      np.testing.assert_allclose(info["env_id"], np.arange(num_envs))
+      # every 6th step auto-resets the envs which terminated on the 5th
+      np.testing.assert_allclose(obs[:, 1], t % 6)
+      np.testing.assert_allclose(rew, 0 if t % 6 == 0 else action)
+      np.testing.assert_array_equal(term, t % 6 == 5)
+      self.assertFalse(trunc.any())
+    env.close()
+
+  def test_seed(self) -> None:
+    envs = [
+      make_dm("PythonEnv-v0", env_fn=_WalkEnv, num_envs=3, seed=s)
+      for s in [1, 1, 2]
+    ]
+    obs = [e.reset().observation.obs for e in envs]
+    np.testing.assert_allclose(obs[0], obs[1])
+    self.assertFalse(np.allclose(obs[0], obs[2]))
+    for e in envs:
+      e.close()
+
+  def test_async(self) -> None:
+    num_envs, batch_size = 8, 2
+    env = make_gym(
+      "PythonEnv-v0",
+      env_fn=_WalkEnv,
+      env_kwargs={"length": 1000, "sleep": 0.001},
+      num_envs=num_envs,
+      batch_size=batch_size,
+      num_threads=num_envs,
+    )
+    env.async_reset()
+    count = np.zeros(num_envs, dtype=int)
+    for _ in range(200):
+      obs, _, _, _, info = env.recv()
+      env_id = info["env_id"]
+      self.assertEqual(len(env_id), batch_size)
+      self.assertEqual(len(set(env_id)), batch_size)
+      np.testing.assert_allclose(obs[:, 1], count[env_id])
+      count[env_id] += 1
+      env.send(np.ones(batch_size, dtype=np.int32), env_id)
+    self.assertTrue((count > 0).all())
+    env.close()
+
+  def test_error(self) -> None:
+    env = make_gym("PythonEnv-v0", env_fn=_BadEnv, num_envs=2)
+    env.reset()
+    with self.assertRaisesRegex(RuntimeError, "bad step"):
+      env.step(np.full(2, 2, dtype=np.int32))
+    env.close()
+    # the env which raised is no longer in flight and is reset by its next
+    # step, the other env goes on
+    env = make_gym(
+      "PythonEnv-v0", env_fn=_BadEnv, num_envs=2, batch_size=1, num_threads=2
+    )
+    env.async_reset()
+    env.recv()
+    env.recv()
+    env.send(np.array([2, 1], dtype=np.int32), np.array([0, 1], np.int32))
+    num_errors, env_ids = 0, []
+    for _ in range(2):
+      try:
+        env_ids.append(env.recv()[-1]["env_id"][0])
+      except RuntimeError as e:
+        self.assertIn("Python env 0 raised", str(e))
+        num_errors += 1
+    self.assertEqual(num_errors, 1)
+    self.assertEqual(env_ids, [1])
+    env.send(np.array([1], dtype=np.int32), np.array([0], np.int32))
+    obs, _, _, _, info = env.recv()
+    self.assertEqual(info["env_id"][0], 0)
+    self.assertEqual(obs[0, 1], 0)
+    env.close()
+
+
+if __name__ == "__main__":
+  absltest.main()
@@ -131,6 +131,72 @@ std::vector<VzdActT> BuildActionSet(
   return result;
 }
 
+// all engine resolutions, see ScreenResolution in ViZDoomTypes.h
+const std::vector<std::tuple<int, int, ScreenResolution>> kScreenResolutions({
+    {160, 120, RES_160X120},
+    {200, 125, RES_200X125},
+    {200, 150, RES_200X150},
+    {256, 144, RES_256X144},
+    {256, 160, RES_256X160},
+    {256, 192, RES_256X192},
+    {320, 180, RES_320X180},
+    {320, 200, RES_320X200},
+    {320, 240, RES_320X240},
+    {320, 256, RES_320X256},
+    {400, 225, RES_400X225},
+    {400, 250, RES_400X250},
+    {400, 300, RES_400X300},
+    {512, 288, RES_512X288},
+    {512, 320, RES_512X320},
+    {512, 384, RES_512X384},
+    {640, 360, RES_640X360},
+    {640, 400, RES_640X400},
+    {640, 480, RES_640X480},
+    {800, 450, RES_800X450},
+    {800, 500, RES_800X500},
+    {800, 600, RES_800X600},
+    {1024, 576, RES_1024X576},
+    {1024, 640, RES_1024X640},
+    {1024, 768, RES_1024X768},
+    {1280, 720, RES_1280X720},
+    {1280, 800, RES_1280X800},
+    {1280, 960, RES_1280X960},
+    {1280, 1024, RES_1280X1024},
+    {1400, 787, RES_1400X787},
+    {1400, 875, RES_1400X875},
+    {1400, 1050, RES_1400X1050},
+    {1600, 900, RES_1600X900},
+    {1600, 1000, RES_1600X1000},
+    {1600, 1200, RES_1600X1200},
+    {1920, 1080, RES_1920X1080},
+});
+
+/**
+ * The smallest engine resolution of at least width x height, to render as few
+ * pixels as possible before resizing. Resolutions with the aspect ratio of
+ * cfg_width x cfg_height (the one of the .cfg) come first, so that the field
+ * of view does not change.
+ */
+ScreenResolution AutoResolution(int width, int height, int cfg_width,
+                                int cfg_height) {
+  ScreenResolution result = RES_1920X1080;
+  bool result_same_aspect = false;
+  int result_area = 0;
+  for (const auto& [w, h, res] : kScreenResolutions) {
+    if (w < width || h < height) {
+      continue;
+    }
+    bool same_aspect = w * cfg_height == h * cfg_width;
+    if (result_area == 0 || (same_aspect && !result_same_aspect) ||
+        (same_aspect == result_same_aspect && w * h < result_area)) {
+      result = res;
+      result_same_aspect = same_aspect;
+      result_area = w * h;
+    }
+  }
+  return result;
+}
+
 std::vector<std::string> button_string_list({
     "ATTACK",
     "USE",
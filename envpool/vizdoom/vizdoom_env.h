@@ -48,6 +48,7 @@ class VizdoomEnvFns {
         "frame_skip"_.Bind(4), "lmp_save_dir"_.Bind(std::string("")),
         "episodic_life"_.Bind(false), "force_speed"_.Bind(false),
         "use_combined_action"_.Bind(false), "use_inter_area_resize"_.Bind(true),
+        "auto_resolution"_.Bind(false), "gray_scale"_.Bind(false),
         "weapon_duration"_.Bind(5),
         "reward_config"_.Bind(std::map<std::string, std::tuple<float, float>>(
             {{"FRAGCOUNT", {1, -1.5}},         {"KILLCOUNT", {1, 0}},
@@ -83,6 +84,9 @@ class VizdoomEnvFns {
   static decltype(auto) StateSpec(const Config& conf) {
     DoomGame dg;
     dg.loadConfig(conf["cfg_path"_]);
+    if (conf["gray_scale"_]) {
+      dg.setScreenFormat(GRAY8);
+    }
     return MakeDict(
         "obs"_.Bind(Spec<uint8_t>({conf["stack_num"_] * dg.getScreenChannels(),
                                    conf["img_height"_], conf["img_width"_]},
@@ -185,6 +189,14 @@ class VizdoomEnv : public Env<VizdoomEnvSpec> {
     dg_->setDoomGamePath(
         MergePath(spec.config["base_path"_], spec.config["iwad_path"_]));
     dg_->loadConfig(spec.config["cfg_path"_]);
+    if (spec.config["auto_resolution"_]) {
+      dg_->setScreenResolution(AutoResolution(
+          spec.config["img_width"_], spec.config["img_height"_],
+          dg_->getScreenWidth(), dg_->getScreenHeight()));
+    }
+    if (spec.config["gray_scale"_]) {
+      dg_->setScreenFormat(GRAY8);
+    }
     dg_->setWindowVisible(false);
     dg_->addGameArgs(spec.config["game_args"_]);
     dg_->setMode(PLAYER);
@@ -278,6 +290,15 @@ class VizdoomEnv : public Env<VizdoomEnvSpec> {
 
   bool IsDone() override { return done_; }
 
+  /**
+   * The DoomGame seed takes effect from the next new episode, so force
+   * Reset to start one instead of continuing the current episode.
+   */
+  void Seed(int seed) override {
+    dg_->setSeed(seed);
+    elapsed_step_ = max_episode_steps_;
+  }
+
   void Reset() override {
     if (dg_->isEpisodeFinished() || elapsed_step_ >= max_episode_steps_) {
       elapsed_step_ = 0;
@@ -408,8 +429,15 @@ class VizdoomEnv : public Env<VizdoomEnvSpec> {
     std::size_t size = raw_buf_.size;
     for (int c = 0; c < channel_; ++c) {
       // gamestate->screenBuffer is channel-first image
-      std::memcpy(raw_ptr, gamestate->screenBuffer->data() + c * size, size);
       auto slice = tgt[c];
+      if (slice.Shape(0) == raw_buf_.Shape(0) &&
+          slice.Shape(1) == raw_buf_.Shape(1)) {
+        // already at the observation size, e.g., with auto_resolution
+        std::memcpy(slice.Data(), gamestate->screenBuffer->data() + c * size,
+                    size);
+        continue;
+      }
+      std::memcpy(raw_ptr, gamestate->screenBuffer->data() + c * size, size);
       Resize(raw_buf_, &slice, use_inter_area_resize_);
     }
     size = tgt.size;
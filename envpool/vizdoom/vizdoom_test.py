@@ -148,6 +148,25 @@ class _VizdoomEnvPoolBasicTest(absltest.TestCase):
     assert e.step(np.array([0]),
                   np.array([0])).observation.obs.shape[1] == 1 * 4
 
+  def test_auto_resolution_gray_scale(self) -> None:
+    for kwargs, channel in [
+      ({}, 3),
+      ({"gray_scale": True}, 1),
+      ({"auto_resolution": True}, 3),
+      ({"auto_resolution": True, "gray_scale": True}, 1),
+      ({"auto_resolution": True, "img_width": 160, "img_height": 120}, 3),
+    ]:
+      e = make_dm("Deathmatch-v1", use_combined_action=True, **kwargs)
+      height = kwargs.get("img_height", 84)
+      width = kwargs.get("img_width", 84)
+      shape = (channel * 4, height, width)
+      assert e.observation_spec().obs.shape == shape, kwargs
+      obs = e.reset().observation.obs
+      assert obs.shape == (1, *shape), kwargs
+      obs = e.step(np.array([0]), np.array([0])).observation.obs
+      assert obs.shape == (1, *shape), kwargs
+      assert np.ptp(obs) > 0, kwargs
+
 
 if __name__ == "__main__":
   absltest.main()